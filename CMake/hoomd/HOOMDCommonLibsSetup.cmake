@@ -31,6 +31,10 @@ if (ENABLE_TBB)
     list(APPEND HOOMD_COMMON_LIBS ${TBB_LIBRARY})
 endif()
 
+# the GSD writer thread uses std::thread
+find_package(Threads REQUIRED)
+list(APPEND HOOMD_COMMON_LIBS ${CMAKE_THREAD_LIBS_INIT})
+
 if (APPLE)
     list(APPEND HOOMD_COMMON_LIBS "-undefined dynamic_lookup")
 endif()
@@ -77,6 +77,10 @@ struct PYBIND11_EXPORT AABBNode
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - refit : recompute the AABBs of all nodes bottom up from a complete set of AABBs, one for each particle, keeping
+              the tree topology. Runs in O(N) time. Any assignment of particles to leaves is a valid tree, so a refit
+              tree always returns correct query results, but its quality degrades as particles move away from
+              the leaves they were assigned to. Compare getCost() to getBuildCost() to decide when to rebuild.
 
     **Implementation details**
 
@@ -95,7 +99,7 @@ class PYBIND11_EXPORT AABBTree
     public:
         //! Construct an AABBTree
         AABBTree()
-            : m_nodes(0), m_num_nodes(0), m_node_capacity(0), m_root(0)
+            : m_nodes(0), m_num_nodes(0), m_node_capacity(0), m_root(0), m_build_cost(0)
             {
             }
 
@@ -113,6 +117,7 @@ class PYBIND11_EXPORT AABBTree
             m_node_capacity = from.m_node_capacity;
             m_root = from.m_root;
             m_mapping = from.m_mapping;
+            m_build_cost = from.m_build_cost;
 
             m_nodes = NULL;
 
@@ -137,6 +142,7 @@ class PYBIND11_EXPORT AABBTree
             m_node_capacity = from.m_node_capacity;
             m_root = from.m_root;
             m_mapping = from.m_mapping;
+            m_build_cost = from.m_build_cost;
 
             if (m_nodes)
                 free(m_nodes);
@@ -161,6 +167,18 @@ class PYBIND11_EXPORT AABBTree
         //! Build a tree smartly from a list of AABBs
         inline void buildTree(AABB *aabbs, unsigned int N);
 
+        //! Refit the node AABBs to a new list of AABBs without changing the tree topology
+        inline bool refit(const AABB *aabbs, unsigned int N);
+
+        //! Get the total surface area of all nodes
+        inline Scalar getCost() const;
+
+        //! Get the total surface area of all nodes just after the last build
+        Scalar getBuildCost() const
+            {
+            return m_build_cost;
+            }
+
         //! Find all particles that overlap with the query AABB
         inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
@@ -246,6 +264,7 @@ class PYBIND11_EXPORT AABBTree
         unsigned int m_node_capacity;       //!< Capacity of the nodes array
         unsigned int m_root;                //!< Index to the root node of the tree
         std::vector<unsigned int> m_mapping;//!< Reverse mapping to find node given a particle index
+        Scalar m_build_cost;                //!< Total surface area of all nodes just after the last build
 
         //! Initialize the tree to hold N particles
         inline void init(unsigned int N);
@@ -394,6 +413,59 @@ inline void AABBTree::buildTree(AABB *aabbs, unsigned int N)
 
     m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
     updateSkip(m_root);
+
+    m_build_cost = getCost();
+    }
+
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+    \returns false if the tree was built for a different number of particles and cannot be refit
+
+    Sets the AABB of every leaf node to the merged AABBs of its particles and the AABB of every internal node to the
+    merged AABBs of its children. buildNode() allocates every node before its children, so a single reverse pass over
+    the node array visits the children first.
+*/
+inline bool AABBTree::refit(const AABB *aabbs, unsigned int N)
+    {
+    if (m_num_nodes == 0 || N != m_mapping.size())
+        return false;
+
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0; )
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (isNodeLeaf(node_idx))
+            {
+            AABB my_aabb = aabbs[node.particles[0]];
+            node.particle_tags[0] = aabbs[node.particles[0]].tag;
+            for (unsigned int i = 1; i < node.num_particles; i++)
+                {
+                my_aabb = merge(my_aabb, aabbs[node.particles[i]]);
+                node.particle_tags[i] = aabbs[node.particles[i]].tag;
+                }
+            node.aabb = my_aabb;
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+
+    return true;
+    }
+
+/*! \returns The sum of the surface areas of all node AABBs
+
+    This is the surface area heuristic estimate of the cost of a query, up to a constant factor.
+*/
+inline Scalar AABBTree::getCost() const
+    {
+    Scalar cost(0.0);
+    for (unsigned int i = 0; i < m_num_nodes; i++)
+        {
+        vec3<Scalar> d = m_nodes[i].aabb.getUpper() - m_nodes[i].aabb.getLower();
+        cost += Scalar(2.0)*(d.x*d.y + d.y*d.z + d.z*d.x);
+        }
+    return cost;
     }
 
 /*! \param aabbs List of AABBs
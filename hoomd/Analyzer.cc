@@ -45,5 +45,6 @@ void export_Analyzer(py::module& m)
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("analyze", &Analyzer::analyze)
         .def("setProfiler", &Analyzer::setProfiler)
+        .def("flush", &Analyzer::flush)
         ;
     }
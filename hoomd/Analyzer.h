@@ -92,6 +92,12 @@ class PYBIND11_EXPORT Analyzer
         */
         virtual void resetStats(){}
 
+        //! Complete any pending output
+        /*! Analyzers that write output in the background implement flush() to wait until it is complete. System
+            calls flush() on all analyzers at the end of every run().
+        */
+        virtual void flush(){}
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
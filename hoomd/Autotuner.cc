@@ -58,11 +58,16 @@ Autotuner::Autotuner(const std::vector<unsigned int>& parameters,
 
     m_current_param = m_parameters[m_current_element];
 
-    // create CUDA events
+    // create CUDA events, or fall back on the host clock when running on the CPU
+    m_host_timing = !m_exec_conf->isCUDAEnabled();
+    m_start_time = 0;
     #ifdef ENABLE_CUDA
-    cudaEventCreate(&m_start);
-    cudaEventCreate(&m_stop);
-    CHECK_CUDA_ERROR();
+    if (!m_host_timing)
+        {
+        cudaEventCreate(&m_start);
+        cudaEventCreate(&m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
 
     m_sync = false;
@@ -122,11 +127,16 @@ Autotuner::Autotuner(unsigned int start,
 
     m_current_param = m_parameters[m_current_element];
 
-    // create CUDA events
+    // create CUDA events, or fall back on the host clock when running on the CPU
+    m_host_timing = !m_exec_conf->isCUDAEnabled();
+    m_start_time = 0;
     #ifdef ENABLE_CUDA
-    cudaEventCreate(&m_start);
-    cudaEventCreate(&m_stop);
-    CHECK_CUDA_ERROR();
+    if (!m_host_timing)
+        {
+        cudaEventCreate(&m_start);
+        cudaEventCreate(&m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
 
     m_sync = false;
@@ -136,9 +146,12 @@ Autotuner::~Autotuner()
     {
     m_exec_conf->msg->notice(5) << "Destroying Autotuner " << m_name << endl;
     #ifdef ENABLE_CUDA
-    cudaEventDestroy(m_start);
-    cudaEventDestroy(m_stop);
-    CHECK_CUDA_ERROR();
+    if (!m_host_timing)
+        {
+        cudaEventDestroy(m_start);
+        cudaEventDestroy(m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
     }
 
@@ -148,15 +161,22 @@ void Autotuner::begin()
     if (!m_enabled)
         return;
 
-    #ifdef ENABLE_CUDA
-    // if we are scanning, record a cuda event - otherwise do nothing
+    // if we are scanning, record the start time - otherwise do nothing
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        cudaEventRecord(m_start, 0);
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
+        if (m_host_timing)
+            {
+            m_start_time = m_clk.getTime();
+            }
+        #ifdef ENABLE_CUDA
+        else
+            {
+            cudaEventRecord(m_start, 0);
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        #endif
         }
-    #endif
     }
 
 void Autotuner::end()
@@ -165,20 +185,30 @@ void Autotuner::end()
     if (!m_enabled)
         return;
 
-    #ifdef ENABLE_CUDA
     // handle timing updates if scanning
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        cudaEventRecord(m_stop, 0);
-        cudaEventSynchronize(m_stop);
-        cudaEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
+        if (m_host_timing)
+            {
+            // convert from ns to ms to match cudaEventElapsedTime
+            int64_t elapsed = m_clk.getTime() - m_start_time;
+            m_samples[m_current_element][m_current_sample] = float(double(elapsed) / 1e6);
+            }
+        #ifdef ENABLE_CUDA
+        else
+            {
+            cudaEventRecord(m_stop, 0);
+            cudaEventSynchronize(m_stop);
+            cudaEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
+
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        #endif
+
         m_exec_conf->msg->notice(9) << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
                                      << ") = " << m_samples[m_current_element][m_current_sample] << endl;
-
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
         }
-    #endif
 
     // handle state data updates and transitions
     if (m_state == STARTUP)
@@ -353,6 +383,22 @@ unsigned int Autotuner::computeOptimalParameter()
     return opt;
     }
 
+/*! Prints the parameter currently in use at notice level 1. Owners of an Autotuner call this from their own
+    printStats() so that the tuned values are reported at the end of a run.
+*/
+void Autotuner::printStats()
+    {
+    if (!isComplete())
+        {
+        m_exec_conf->msg->notice(1) << "Autotuner " << m_name << ": " << m_current_param << " (initial scan incomplete)"
+                                    << endl;
+        }
+    else
+        {
+        m_exec_conf->msg->notice(1) << "Autotuner " << m_name << ": " << m_current_param << endl;
+        }
+    }
+
 void export_Autotuner(py::module& m)
     {
     py::class_<Autotuner>(m,"Autotuner")
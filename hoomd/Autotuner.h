@@ -11,6 +11,7 @@
 */
 
 #include "ExecutionConfiguration.h"
+#include "ClockSource.h"
 
 #include <vector>
 #include <string>
@@ -44,8 +45,11 @@
 
     Each Autotuner instance has a string name to help identify it's output on the notice stream.
 
-    Autotuner is not useful in non-GPU builds. Timing is performed with CUDA events and requires ENABLE_CUDA=on.
-    Behavior of Autotuner is undefined when ENABLE_CUDA=off.
+    On the GPU, timing is performed with CUDA events. When the execution configuration does not use a GPU (or
+    ENABLE_CUDA=off), begin() and end() measure the wall clock time between them with a ClockSource instead. The host
+    timer resolution is on the order of microseconds, so CPU code paths should only tune loops that take considerably
+    longer than that, such as the threaded loops over all particles. The state machine and the sampling modes are the
+    same for both timing backends.
 
     ** Implementation ** <br>
     Internally, m_nsamples is the number of samples to take (odd for median computation). m_current_sample is the
@@ -167,6 +171,23 @@ class PYBIND11_EXPORT Autotuner
             }
 
 
+        //! Get the name of this autotuner
+        const std::string& getName() const
+            {
+            return m_name;
+            }
+
+        //! Test if the autotuner measures the host wall clock time
+        /*! \returns true if begin() and end() use the host clock, false if they use CUDA events
+        */
+        bool isHostTiming() const
+            {
+            return m_host_timing;
+            }
+
+        //! Print the currently chosen parameter to the notice stream
+        void printStats();
+
         //! build list of thread per particle targets
         static std::vector<unsigned int> getTppListPow2(unsigned int warpSize)
             {
@@ -216,6 +237,10 @@ class PYBIND11_EXPORT Autotuner
         cudaEvent_t m_stop;       //!< CUDA event for recording end times
         #endif
 
+        bool m_host_timing;       //!< True if timing is performed with the host clock
+        ClockSource m_clk;        //!< Host clock for CPU timing
+        int64_t m_start_time;     //!< Host time recorded in begin() (ns)
+
         bool m_sync;              //!< If true, synchronize results via MPI
         mode_Enum m_mode;         //!< The sampling mode
     };
@@ -13,6 +13,8 @@
 #include "ParticleData.h"
 #include "Index1D.h"
 
+#include <algorithm>
+
 #include "hoomd/extern/pybind/include/pybind11/numpy.h"
 
 #ifdef ENABLE_CUDA
@@ -44,7 +46,8 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true),
+      m_cpu_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name<< "s, n=" << group_size << ") "
         << endl;
@@ -94,7 +97,8 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true),
+      m_cpu_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -841,6 +845,44 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
         }
     }
 
+/*! The CPU table lists the local groups (not the ghost groups) with the particle indices of their members, sorted
+    by the index of the first member. Force computes loop over this table instead of looking up every member by tag.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildCPUTable()
+    {
+    if (m_prof) m_prof->push("update " + std::string(name) + " cpu table");
+
+    m_cpu_table.resize(m_n_groups);
+    m_cpu_table_group.resize(m_n_groups);
+
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+
+        // sort the groups by the index of their first member
+        std::vector< std::pair<unsigned int, unsigned int> > order(m_n_groups);
+        for (unsigned int cur_group = 0; cur_group < m_n_groups; cur_group++)
+            order[cur_group] = std::make_pair(h_rtag.data[h_groups.data[cur_group].tag[0]], cur_group);
+        std::sort(order.begin(), order.end());
+
+        for (unsigned int i = 0; i < m_n_groups; i++)
+            {
+            unsigned int cur_group = order[i].second;
+            const members_t& g = h_groups.data[cur_group];
+
+            members_t h;
+            for (unsigned int j = 0; j < group_size; ++j)
+                h.idx[j] = h_rtag.data[g.tag[j]];
+
+            m_cpu_table[i] = h;
+            m_cpu_table_group[i] = cur_group;
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 #ifdef ENABLE_CUDA
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTableGPU()
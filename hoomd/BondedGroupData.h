@@ -547,6 +547,42 @@ class BondedGroupData
             return m_gpu_n_groups;
             }
 
+        /*
+         * CPU group table
+         */
+
+        //! Return the local groups by particle index, for access on the CPU
+        /*! Entry i holds the particle indices of the members of the local group getCPUTableGroups()[i]. The entries
+            are ordered by the index of the first member, so that loops over the table access the particle data
+            in memory order. Members that are not local are stored as NOT_LOCAL.
+
+            The table is rebuilt only after the groups or the particles have been reordered.
+        */
+        const std::vector<members_t>& getCPUTable()
+            {
+            // rebuild lookup table if necessary
+            if (m_cpu_table_dirty)
+                {
+                rebuildCPUTable();
+                m_cpu_table_dirty = false;
+                }
+
+            return m_cpu_table;
+            }
+
+        //! Return the local group index of every entry in the CPU table
+        const std::vector<unsigned int>& getCPUTableGroups()
+            {
+            // rebuild lookup table if necessary
+            if (m_cpu_table_dirty)
+                {
+                rebuildCPUTable();
+                m_cpu_table_dirty = false;
+                }
+
+            return m_cpu_table_group;
+            }
+
         /*
          * add/remove groups globally
          */
@@ -585,17 +621,19 @@ class BondedGroupData
         //! Notify subscribers that groups have been reordered
         void notifyGroupReorder()
             {
-            // set flag to trigger rebuild of GPU table
+            // set flags to trigger rebuild of GPU and CPU tables
             m_groups_dirty = true;
+            m_cpu_table_dirty = true;
 
             // notify subscribers
             m_group_reorder_signal.emit();
             }
 
-        //! Indicate that GPU table needs to be rebuilt
+        //! Indicate that GPU and CPU tables need to be rebuilt
         void setDirty()
             {
             m_groups_dirty = true;
+            m_cpu_table_dirty = true;
             }
 
     protected:
@@ -619,6 +657,8 @@ class BondedGroupData
         GPUVector<unsigned int> m_gpu_pos_table;     //!< Position of particle idx in group table
         Index2D m_gpu_table_indexer;                 //!< Indexer for GPU table
         GPUVector<unsigned int> m_gpu_n_groups;      //!< Number of entries in lookup table per particle
+        std::vector<members_t> m_cpu_table;          //!< Member indices of the local groups, ordered by first member
+        std::vector<unsigned int> m_cpu_table_group; //!< Local group index of every entry in the CPU table
         std::vector<std::string> m_type_mapping;     //!< Mapping of types of bonded groups
 
         unsigned int m_n_groups;                     //!< Number of local groups
@@ -645,6 +685,7 @@ class BondedGroupData
 
     private:
         bool m_groups_dirty;                         //!< Is it necessary to rebuild the lookup-by-index table?
+        bool m_cpu_table_dirty;                      //!< Is it necessary to rebuild the CPU table?
 
         Nano::Signal<void ()> m_group_num_change_signal; //!< Signal that is triggered when groups are added or deleted (globally)
         Nano::Signal<void ()> m_group_reorder_signal;    //!< Signal that is triggered when groups are added or deleted locally
@@ -658,6 +699,9 @@ class BondedGroupData
         //! Helper function to rebuild lookup by index table
         void rebuildGPUTable();
 
+        //! Helper function to rebuild the CPU table
+        void rebuildCPUTable();
+
         //! Resize internal tables
         /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
          */
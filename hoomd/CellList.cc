@@ -13,6 +13,10 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -471,16 +475,17 @@ void CellList::computeCellList()
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
+    // finds the bin of particle n, returns NOT_BINNED and sets the error conditions if it cannot be binned
+    const unsigned int NOT_BINNED = 0xffffffff;
+    auto compute_bin = [&](unsigned int n, uint3& cond) -> unsigned int
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
             {
-            conditions.y = n+1;
-            continue;
+            cond.y = n+1;
+            return NOT_BINNED;
             }
 
-
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(p,ghost_width);
         int ib = (int)(f.x * m_dim.x);
@@ -494,8 +499,8 @@ void CellList::computeCellList()
             {
             // if a ghost particle is out of bounds, silently ignore it
             if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+                cond.z = n+1;
+            return NOT_BINNED;
             }
 
         // need to handle the case where the particle is exactly at the box hi
@@ -509,9 +514,6 @@ void CellList::computeCellList()
         // sanity check
         assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
 
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
         // all particles should be in a valid cell
         if (ib < 0 || ib >= (int)m_dim.x ||
             jb < 0 || jb >= (int)m_dim.y ||
@@ -519,10 +521,16 @@ void CellList::computeCellList()
             {
             // but ghost particles that are out of range should not produce an error
             if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+                cond.z = n+1;
+            return NOT_BINNED;
             }
 
+        return ci(ib, jb, kb);
+        };
+
+    // stores particle n at the given offset in its bin
+    auto store = [&](unsigned int n, unsigned int bin, unsigned int offset)
+        {
         // setup the flag value to store
         Scalar flag;
         if (m_flag_charge)
@@ -532,41 +540,132 @@ void CellList::computeCellList()
         else
             flag = __int_as_scalar(n);
 
-        // store the bin entries
-        unsigned int offset = h_cell_size.data[bin];
+        if (m_compute_xyzf)
+            {
+            h_xyzf.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
+            }
+
+        if (m_compute_tdb)
+            {
+            h_tdb.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].w,
+                                                        h_diameter.data[n],
+                                                        __int_as_scalar(h_body.data[n]),
+                                                        Scalar(0.0));
+            }
 
-        if (offset < m_Nmax)
+        if (m_compute_orientation)
             {
-            if (m_compute_xyzf)
-                {
-                h_xyzf.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
-                }
+            h_cell_orientation.data[cli(offset, bin)] = h_orientation.data[n];
+            }
+
+        if (m_compute_idx)
+            {
+            h_cell_idx.data[cli(offset, bin)] = n;
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    // every chunk holds a histogram over all cells, so limit the chunks to keep the work and memory of the
+    // histograms, n_chunks*n_cells, below the number of particles. Sparse systems with many cells are built serially.
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), n_tot_particles / std::max(n_cells, 1u));
+    if (n_chunks > 1)
+        {
+        // counting sort over one contiguous chunk of particles per thread: the chunks count their members per cell,
+        // a prefix sum over the chunks gives every chunk its first slot in each cell, and the chunks then store
+        // their particles in order. This reproduces the order of the serial build exactly.
+        m_bin.resize(n_tot_particles);
+        m_chunk_offset.assign(n_chunks*n_cells, 0);
+        std::vector<uint3> chunk_conditions(n_chunks, make_uint3(0,0,0));
+
+        auto chunk_begin = [&](unsigned int chunk)
+            {
+            return (unsigned int)((unsigned long long)n_tot_particles*chunk/n_chunks);
+            };
 
-            if (m_compute_tdb)
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
                 {
-                h_tdb.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].w,
-                                                            h_diameter.data[n],
-                                                            __int_as_scalar(h_body.data[n]),
-                                                            Scalar(0.0));
+                unsigned int *count = &m_chunk_offset[chunk*n_cells];
+                for (unsigned int n = chunk_begin(chunk); n < chunk_begin(chunk+1); n++)
+                    {
+                    unsigned int bin = compute_bin(n, chunk_conditions[chunk]);
+                    m_bin[n] = bin;
+                    if (bin != NOT_BINNED)
+                        count[bin]++;
+                    }
                 }
+            });
 
-            if (m_compute_orientation)
+        // exclusive scan over the chunks, per cell
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int bin = r.begin(); bin != r.end(); ++bin)
                 {
-                h_cell_orientation.data[cli(offset, bin)] = h_orientation.data[n];
+                unsigned int sum = 0;
+                for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+                    {
+                    unsigned int count = m_chunk_offset[chunk*n_cells + bin];
+                    m_chunk_offset[chunk*n_cells + bin] = sum;
+                    sum += count;
+                    }
+                h_cell_size.data[bin] = sum;
                 }
+            });
 
-            if (m_compute_idx)
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
                 {
-                h_cell_idx.data[cli(offset, bin)] = n;
+                unsigned int *offset = &m_chunk_offset[chunk*n_cells];
+                uint3& cond = chunk_conditions[chunk];
+                for (unsigned int n = chunk_begin(chunk); n < chunk_begin(chunk+1); n++)
+                    {
+                    unsigned int bin = m_bin[n];
+                    if (bin == NOT_BINNED)
+                        continue;
+
+                    unsigned int cur_offset = offset[bin]++;
+                    if (cur_offset < m_Nmax)
+                        store(n, bin, cur_offset);
+                    else
+                        cond.x = max(cond.x, cur_offset+1);
+                    }
                 }
-            }
-        else
+            });
+
+        // the serial build reports the last offending particle, which is the one with the largest index
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
             {
-            conditions.x = max(conditions.x, offset+1);
+            conditions.x = max(conditions.x, chunk_conditions[chunk].x);
+            conditions.y = max(conditions.y, chunk_conditions[chunk].y);
+            conditions.z = max(conditions.z, chunk_conditions[chunk].z);
             }
+        }
+    else
+    #endif
+        {
+        for (unsigned int n = 0; n < n_tot_particles; n++)
+            {
+            unsigned int bin = compute_bin(n, conditions);
+            if (bin == NOT_BINNED)
+                continue;
+
+            // store the bin entries
+            unsigned int offset = h_cell_size.data[bin];
 
-        // increment the cell occupancy counter
-        h_cell_size.data[bin]++;
+            if (offset < m_Nmax)
+                store(n, bin, offset);
+            else
+                conditions.x = max(conditions.x, offset+1);
+
+            // increment the cell occupancy counter
+            h_cell_size.data[bin]++;
+            }
         }
 
         {
@@ -11,6 +11,7 @@
 #include "Compute.h"
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file CellList.h
@@ -390,6 +391,11 @@ class PYBIND11_EXPORT CellList : public Compute
         bool m_sort_cell_list;               //!< If true, sort cell list
         bool m_compute_adj_list;            //!< If true, compute the cell adjacency lists
 
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int> m_bin;            //!< Bin of every particle (threaded build only)
+        std::vector<unsigned int> m_chunk_offset;   //!< Per-thread cell counts and offsets (threaded build only)
+        #endif
+
         //! Computes what the dimensions should me
         uint3 computeDimensions();
 
@@ -1079,6 +1079,7 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_nettorque_copybuf(m_exec_conf),
             m_netvirial_copybuf(m_exec_conf),
             m_netvirial_recvbuf(m_exec_conf),
+            m_scalar_copybuf(m_exec_conf),
             m_plan(m_exec_conf),
             m_plan_reverse(m_exec_conf),
             m_tag_reverse(m_exec_conf),
@@ -1088,8 +1089,17 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_r_extra_ghost_max(Scalar(0.0)),
             m_ghosts_added(0),
             m_has_ghost_particles(false),
+            m_direct_ghost_exchange(false),
+            m_direct_ghosts_active(false),
+            m_neigh_comm(MPI_COMM_NULL),
+            m_direct_copy_ghosts(m_exec_conf),
+            m_direct_num_copy_ghosts(0),
+            m_direct_num_recv_ghosts(0),
             m_last_flags(0),
             m_comm_pending(false),
+            m_ghost_update_overlap(false),
+            m_pending_wrap_start(0),
+            m_pending_wrap_n(0),
             m_bond_comm(*this, m_sysdef->getBondData()),
             m_angle_comm(*this, m_sysdef->getAngleData()),
             m_dihedral_comm(*this, m_sysdef->getDihedralData()),
@@ -1218,6 +1228,13 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     MPI_Type_create_resized(tmp, 0, sizeof(pdata_element), &m_mpi_pdata_element);
     MPI_Type_commit(&m_mpi_pdata_element);
     MPI_Type_free(&tmp);
+
+    /* create types for the vector fields of ghost particles */
+    MPI_Type_contiguous(sizeof(Scalar4), MPI_BYTE, &m_mpi_scalar4);
+    MPI_Type_commit(&m_mpi_scalar4);
+
+    MPI_Type_contiguous(sizeof(int3), MPI_BYTE, &m_mpi_int3);
+    MPI_Type_commit(&m_mpi_int3);
     }
 
 //! Destructor
@@ -1236,6 +1253,11 @@ Communicator::~Communicator()
     m_sysdef->getPairData()->getGroupNumChangeSignal().disconnect<Communicator, &Communicator::setPairsChanged>(this);
 
     MPI_Type_free(&m_mpi_pdata_element);
+    MPI_Type_free(&m_mpi_scalar4);
+    MPI_Type_free(&m_mpi_int3);
+
+    if (m_neigh_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_neigh_comm);
     }
 
 void Communicator::initializeNeighborArrays()
@@ -1330,9 +1352,100 @@ void Communicator::initializeNeighborArrays()
         }
     }
 
+void Communicator::initializeNeighborhoodComm()
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+
+    std::vector<int> sources;
+    std::vector<int> destinations;
+
+    m_neigh_dirs.clear();
+    for (unsigned int i = 0; i < 27; ++i)
+        m_neigh_slot[i] = -1;
+
+    // every rank lists its neighbors in the same order, so that the k-th message sent to a neighbor
+    // matches the k-th message it receives from us, even if it is a neighbor in several directions
+    for (int iz=-1; iz <= 1; iz++)
+        {
+        // only if communicating along z-direction
+        if (iz && di.getD() == 1) continue;
+
+        for (int iy=-1; iy <= 1; iy++)
+            {
+            // only if communicating along y-direction
+            if (iy && di.getH() == 1) continue;
+
+            for (int ix=-1; ix <= 1; ix++)
+                {
+                // only if communicating along x-direction
+                if (ix && di.getW() == 1) continue;
+
+                // exclude ourselves
+                if (!ix && !iy && !iz) continue;
+
+                unsigned int dir = ((iz+1)*3+(iy+1))*3+(ix + 1);
+                m_neigh_slot[dir] = m_neigh_dirs.size();
+                m_neigh_dirs.push_back(dir);
+
+                // we send in direction dir and receive from the opposite direction
+                destinations.push_back(m_decomposition->getNeighborRank(make_int3(ix,iy,iz)));
+                sources.push_back(m_decomposition->getNeighborRank(make_int3(-ix,-iy,-iz)));
+                }
+            }
+        }
+
+    MPI_Dist_graph_create_adjacent(m_mpi_comm,
+        sources.size(),
+        sources.data(),
+        MPI_UNWEIGHTED,
+        destinations.size(),
+        destinations.data(),
+        MPI_UNWEIGHTED,
+        MPI_INFO_NULL,
+        0,
+        &m_neigh_comm);
+
+    m_direct_send_counts.resize(m_neigh_dirs.size());
+    m_direct_send_displs.resize(m_neigh_dirs.size());
+    m_direct_recv_counts.resize(m_neigh_dirs.size());
+    m_direct_recv_displs.resize(m_neigh_dirs.size());
+    }
+
+void Communicator::setDirectGhostExchange(bool direct)
+    {
+    if (direct && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "comm: The single-stage ghost exchange is not available on the GPU, ignoring" << std::endl;
+        return;
+        }
+
+    if (direct && m_neigh_comm == MPI_COMM_NULL)
+        initializeNeighborhoodComm();
+
+    m_direct_ghost_exchange = direct;
+
+    // rebuild the ghost lists
+    forceMigrate();
+    }
+
+bool Communicator::useDirectGhostExchange()
+    {
+    if (! m_direct_ghost_exchange)
+        return false;
+
+    // the net forces are communicated along the staged ghost lists
+    CommFlags flags = getFlags();
+    return ! flags[comm_flag::net_force] && ! flags[comm_flag::reverse_net_force] && ! flags[comm_flag::net_torque]
+        && ! flags[comm_flag::net_virial];
+    }
+
 //! Interface to the communication methods.
-void Communicator::communicate(unsigned int timestep)
+void Communicator::communicate(unsigned int timestep, bool allow_overlap)
     {
+    // complete a ghost update left in flight by a previous call
+    if (m_comm_pending)
+        finishUpdateGhosts(timestep);
+
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
@@ -1344,6 +1457,10 @@ void Communicator::communicate(unsigned int timestep)
                                         }
                                       , timestep);
 
+    // the ghost lists need to be rebuilt when switching between the staged and the single-stage exchange
+    if (m_has_ghost_particles && m_direct_ghosts_active != useDirectGhostExchange())
+        m_force_migrate = true;
+
     if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
@@ -1376,7 +1493,9 @@ void Communicator::communicate(unsigned int timestep)
         {
         beginUpdateGhosts(timestep);
 
-        finishUpdateGhosts(timestep);
+        // the caller finishes the update after computing the forces on interior particles
+        if (!(allow_overlap && m_ghost_update_overlap) || m_exec_conf->isCUDAEnabled())
+            finishUpdateGhosts(timestep);
         }
 
     // Check if migration of particles is requested
@@ -1708,9 +1827,14 @@ void Communicator::exchangeGhosts()
     // ghost particle flags
     CommFlags flags = getFlags();
 
+    m_direct_ghosts_active = useDirectGhostExchange();
+    if (m_direct_ghosts_active)
+        exchangeGhostsDirect(flags, mask);
+
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
-        if (! isCommunicating(dir) ) continue;
+        // the single-stage exchange has already sent the ghosts to all neighbors
+        if (! isCommunicating(dir) || m_direct_ghosts_active) continue;
 
         m_num_copy_ghosts[dir] = 0;
 
@@ -2328,9 +2452,315 @@ void Communicator::exchangeGhosts()
         m_prof->pop();
     }
 
+/*! \param plan The ghost plan of a particle
+    \param dirs Output array of at most 26 neighbor directions (3x3x3 index)
+    \returns The number of neighbors the particle is sent to
+
+    A particle in the ghost layer of several faces is also sent to the neighbors across the shared edges and corners.
+ */
+inline unsigned int getGhostNeighborDirections(unsigned int plan, unsigned int *dirs)
+    {
+    int dx[3] = {0,0,0}, dy[3] = {0,0,0}, dz[3] = {0,0,0};
+    unsigned int nx = 1, ny = 1, nz = 1;
+
+    if (plan & Communicator::send_east) dx[nx++] = 1;
+    if (plan & Communicator::send_west) dx[nx++] = -1;
+    if (plan & Communicator::send_north) dy[ny++] = 1;
+    if (plan & Communicator::send_south) dy[ny++] = -1;
+    if (plan & Communicator::send_up) dz[nz++] = 1;
+    if (plan & Communicator::send_down) dz[nz++] = -1;
+
+    unsigned int n = 0;
+    for (unsigned int k = 0; k < nz; ++k)
+        for (unsigned int j = 0; j < ny; ++j)
+            for (unsigned int i = 0; i < nx; ++i)
+                {
+                if (!dx[i] && !dy[j] && !dz[k]) continue;
+                dirs[n++] = ((dz[k]+1)*3+(dy[j]+1))*3+(dx[i]+1);
+                }
+    return n;
+    }
+
+void Communicator::exchangeGhostsDirect(const CommFlags& flags, unsigned int mask)
+    {
+    const unsigned int nneigh = m_neigh_dirs.size();
+    const unsigned int n_local = m_pdata->getN();
+
+    // the per-direction lists of the staged exchange are not used
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        m_num_copy_ghosts[dir] = 0;
+        m_num_recv_ghosts[dir] = 0;
+        }
+
+    unsigned int dirs[26];
+
+    // count the ghosts sent to every neighbor
+    std::fill(m_direct_send_counts.begin(), m_direct_send_counts.end(), 0);
+        {
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < n_local; idx++)
+            {
+            unsigned int n = getGhostNeighborDirections(h_plan.data[idx] & mask, dirs);
+            for (unsigned int i = 0; i < n; ++i)
+                m_direct_send_counts[m_neigh_slot[dirs[i]]]++;
+            }
+        }
+
+    m_direct_num_copy_ghosts = 0;
+    for (unsigned int i = 0; i < nneigh; ++i)
+        {
+        m_direct_send_displs[i] = m_direct_num_copy_ghosts;
+        m_direct_num_copy_ghosts += m_direct_send_counts[i];
+        }
+
+    // resize buffers
+    m_direct_copy_ghosts.resize(m_direct_num_copy_ghosts);
+    m_plan_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::position])
+        m_pos_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::charge])
+        m_charge_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::body])
+        m_body_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::image])
+        m_image_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::diameter])
+        m_diameter_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::velocity])
+        m_velocity_copybuf.resize(m_direct_num_copy_ghosts);
+
+    if (flags[comm_flag::orientation])
+        {
+        m_orientation_copybuf.resize(m_direct_num_copy_ghosts);
+        }
+
+        {
+        // we fill all fields, but send only those that are requested by the CommFlags bitset
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+
+        ArrayHandle<unsigned int> h_copy_ghosts(m_direct_copy_ghosts, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image_copybuf(m_image_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+
+        std::vector<int> offset(m_direct_send_displs);
+
+        for (unsigned int idx = 0; idx < n_local; idx++)
+            {
+            unsigned int n = getGhostNeighborDirections(h_plan.data[idx] & mask, dirs);
+
+            for (unsigned int i = 0; i < n; ++i)
+                {
+                unsigned int k = offset[m_neigh_slot[dirs[i]]]++;
+
+                if (flags[comm_flag::position]) h_pos_copybuf.data[k] = h_pos.data[idx];
+                if (flags[comm_flag::charge]) h_charge_copybuf.data[k] = h_charge.data[idx];
+                if (flags[comm_flag::diameter]) h_diameter_copybuf.data[k] = h_diameter.data[idx];
+                if (flags[comm_flag::body]) h_body_copybuf.data[k] = h_body.data[idx];
+                if (flags[comm_flag::image]) h_image_copybuf.data[k] = h_image.data[idx];
+                if (flags[comm_flag::velocity]) h_velocity_copybuf.data[k] = h_vel.data[idx];
+                if (flags[comm_flag::orientation]) h_orientation_copybuf.data[k] = h_orientation.data[idx];
+                h_plan_copybuf.data[k] = h_plan.data[idx];
+
+                h_copy_ghosts.data[k] = h_tag.data[idx];
+                }
+            }
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    MPI_Neighbor_alltoall(m_direct_send_counts.data(),
+        1,
+        MPI_INT,
+        m_direct_recv_counts.data(),
+        1,
+        MPI_INT,
+        m_neigh_comm);
+
+    if (m_prof)
+        m_prof->pop();
+
+    m_direct_num_recv_ghosts = 0;
+    for (unsigned int i = 0; i < nneigh; ++i)
+        {
+        m_direct_recv_displs[i] = m_direct_num_recv_ghosts;
+        m_direct_num_recv_ghosts += m_direct_recv_counts[i];
+        }
+
+    // append ghosts at the end of particle data array
+    unsigned int start_idx = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // accommodate new ghost particles
+    m_pdata->addGhostParticles(m_direct_num_recv_ghosts);
+
+    // resize plan array
+    m_plan.resize(m_pdata->getN() + m_pdata->getNGhosts());
+
+    // exchange particle data with all neighbors, write directly to the particle data arrays
+    if (m_prof)
+        {
+        m_prof->push("MPI send/recv");
+        }
+
+        {
+        ArrayHandle<unsigned int> h_copy_ghosts(m_direct_copy_ghosts, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image_copybuf(m_image_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
+
+        const int *sendcounts = m_direct_send_counts.data();
+        const int *sdispls = m_direct_send_displs.data();
+        const int *recvcounts = m_direct_recv_counts.data();
+        const int *rdispls = m_direct_recv_displs.data();
+
+        // all fields are in flight at the same time
+        m_reqs.clear();
+        m_stats.clear();
+        MPI_Request req;
+
+        MPI_Ineighbor_alltoallv(h_plan_copybuf.data, sendcounts, sdispls, MPI_UNSIGNED,
+            h_plan.data + start_idx, recvcounts, rdispls, MPI_UNSIGNED, m_neigh_comm, &req);
+        m_reqs.push_back(req);
+
+        MPI_Ineighbor_alltoallv(h_copy_ghosts.data, sendcounts, sdispls, MPI_UNSIGNED,
+            h_tag.data + start_idx, recvcounts, rdispls, MPI_UNSIGNED, m_neigh_comm, &req);
+        m_reqs.push_back(req);
+
+        if (flags[comm_flag::position])
+            {
+            MPI_Ineighbor_alltoallv(h_pos_copybuf.data, sendcounts, sdispls, m_mpi_scalar4,
+                h_pos.data + start_idx, recvcounts, rdispls, m_mpi_scalar4, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        if (flags[comm_flag::charge])
+            {
+            MPI_Ineighbor_alltoallv(h_charge_copybuf.data, sendcounts, sdispls, MPI_HOOMD_SCALAR,
+                h_charge.data + start_idx, recvcounts, rdispls, MPI_HOOMD_SCALAR, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        if (flags[comm_flag::diameter])
+            {
+            MPI_Ineighbor_alltoallv(h_diameter_copybuf.data, sendcounts, sdispls, MPI_HOOMD_SCALAR,
+                h_diameter.data + start_idx, recvcounts, rdispls, MPI_HOOMD_SCALAR, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        if (flags[comm_flag::velocity])
+            {
+            MPI_Ineighbor_alltoallv(h_velocity_copybuf.data, sendcounts, sdispls, m_mpi_scalar4,
+                h_vel.data + start_idx, recvcounts, rdispls, m_mpi_scalar4, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        if (flags[comm_flag::orientation])
+            {
+            MPI_Ineighbor_alltoallv(h_orientation_copybuf.data, sendcounts, sdispls, m_mpi_scalar4,
+                h_orientation.data + start_idx, recvcounts, rdispls, m_mpi_scalar4, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        if (flags[comm_flag::body])
+            {
+            MPI_Ineighbor_alltoallv(h_body_copybuf.data, sendcounts, sdispls, MPI_UNSIGNED,
+                h_body.data + start_idx, recvcounts, rdispls, MPI_UNSIGNED, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        if (flags[comm_flag::image])
+            {
+            MPI_Ineighbor_alltoallv(h_image_copybuf.data, sendcounts, sdispls, m_mpi_int3,
+                h_image.data + start_idx, recvcounts, rdispls, m_mpi_int3, m_neigh_comm, &req);
+            m_reqs.push_back(req);
+            }
+
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        m_reqs.clear();
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    // wrap particle positions
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+
+        for (unsigned int idx = start_idx; idx < start_idx + m_direct_num_recv_ghosts; idx++)
+            {
+            Scalar4& pos = h_pos.data[idx];
+
+            // wrap particles received across a global boundary
+            int3& img = h_image.data[idx];
+            shifted_box.wrap(pos,img);
+            }
+        }
+
+        {
+        // set reverse-lookup tag -> idx
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = start_idx; idx < start_idx + m_direct_num_recv_ghosts; idx++)
+            {
+            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+            assert(h_rtag.data[h_tag.data[idx]] == NOT_LOCAL);
+            h_rtag.data[h_tag.data[idx]] = idx;
+            }
+        }
+    }
+
 //! update positions of ghost particles
 void Communicator::beginUpdateGhosts(unsigned int timestep)
     {
+    if (m_direct_ghosts_active)
+        {
+        beginUpdateGhostsDirect();
+        return;
+        }
+
     // we have a current m_copy_ghosts liss which contain the indices of particles
     // to send to neighboring processors
     if (m_prof)
@@ -2342,11 +2772,21 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
+    // ghosts received in one stage may be forwarded in the next, so only the messages of the last stage can be left
+    // in flight until finishUpdateGhosts()
+    unsigned int last_dir = 6;
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (isCommunicating(dir))
+            last_dir = dir;
+        }
+
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (! isCommunicating(dir) ) continue;
 
         CommFlags flags = getFlags();
+        const bool last_stage = (dir == last_dir);
 
         if (flags[comm_flag::position])
             {
@@ -2426,62 +2866,74 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         num_tot_recv_ghosts += m_num_recv_ghosts[dir];
 
         size_t sz = 0;
+        m_reqs.clear();
+
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
         if (flags[comm_flag::position])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            MPI_Request req[2];
+            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &req[0]);
+            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &req[1]);
+            m_reqs.push_back(req[0]);
+            m_reqs.push_back(req[1]);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::velocity])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            MPI_Request req[2];
+            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &req[0]);
+            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &req[1]);
+            m_reqs.push_back(req[0]);
+            m_reqs.push_back(req[1]);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::orientation])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            MPI_Request req[2];
+            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &req[0]);
+            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &req[1]);
+            m_reqs.push_back(req[0]);
+            m_reqs.push_back(req[1]);
 
             sz += sizeof(Scalar4);
             }
 
+        if (last_stage)
+            {
+            // leave the messages of the last stage in flight, finishUpdateGhosts() waits for them
+            m_comm_pending = true;
+            m_pending_wrap_start = start_idx;
+            m_pending_wrap_n = flags[comm_flag::position] ? m_num_recv_ghosts[dir] : 0;
+            }
+        else if (m_reqs.size())
+            {
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+            }
+
         if (m_prof)
             m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
 
 
         // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
+        if (flags[comm_flag::position] && !last_stage)
             {
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
 
@@ -2502,8 +2954,165 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
             m_prof->pop();
     }
 
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (!m_comm_pending)
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    if (m_reqs.size())
+        {
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        }
+
+    if (m_pending_wrap_n)
+        {
+        // wrap particles received across a global boundary
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+        for (unsigned int idx = m_pending_wrap_start; idx < m_pending_wrap_start + m_pending_wrap_n; idx++)
+            {
+            Scalar4& pos = h_pos.data[idx];
+            int3 img = make_int3(0,0,0);
+            shifted_box.wrap(pos, img);
+            }
+        }
+
+    m_comm_pending = false;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void Communicator::beginUpdateGhostsDirect()
+    {
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    m_exec_conf->msg->notice(7) << "Communicator: update ghosts (single stage)" << std::endl;
+
+    CommFlags flags = getFlags();
+
+    // copy the updated fields of the ghosts into the send buffers
+        {
+        ArrayHandle<unsigned int> h_copy_ghosts(m_direct_copy_ghosts, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+        if (flags[comm_flag::position])
+            {
+            m_pos_copybuf.resize(m_direct_num_copy_ghosts);
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
+
+            for (unsigned int ghost_idx = 0; ghost_idx < m_direct_num_copy_ghosts; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN());
+                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                }
+            }
+
+        if (flags[comm_flag::velocity])
+            {
+            m_velocity_copybuf.resize(m_direct_num_copy_ghosts);
+            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
+
+            for (unsigned int ghost_idx = 0; ghost_idx < m_direct_num_copy_ghosts; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN());
+                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
+                }
+            }
+
+        if (flags[comm_flag::orientation])
+            {
+            m_orientation_copybuf.resize(m_direct_num_copy_ghosts);
+            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+
+            for (unsigned int ghost_idx = 0; ghost_idx < m_direct_num_copy_ghosts; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN());
+                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
+                }
+            }
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    const unsigned int start_idx = m_pdata->getN();
+    const int *sendcounts = m_direct_send_counts.data();
+    const int *sdispls = m_direct_send_displs.data();
+    const int *recvcounts = m_direct_recv_counts.data();
+    const int *rdispls = m_direct_recv_displs.data();
+
+    size_t sz = 0;
+    m_reqs.clear();
+    MPI_Request req;
+
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+
+        MPI_Ineighbor_alltoallv(h_pos_copybuf.data, sendcounts, sdispls, m_mpi_scalar4,
+            h_pos.data + start_idx, recvcounts, rdispls, m_mpi_scalar4, m_neigh_comm, &req);
+        m_reqs.push_back(req);
+
+        sz += sizeof(Scalar4);
+        }
+
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+
+        MPI_Ineighbor_alltoallv(h_velocity_copybuf.data, sendcounts, sdispls, m_mpi_scalar4,
+            h_vel.data + start_idx, recvcounts, rdispls, m_mpi_scalar4, m_neigh_comm, &req);
+        m_reqs.push_back(req);
+
+        sz += sizeof(Scalar4);
+        }
+
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+
+        MPI_Ineighbor_alltoallv(h_orientation_copybuf.data, sendcounts, sdispls, m_mpi_scalar4,
+            h_orientation.data + start_idx, recvcounts, rdispls, m_mpi_scalar4, m_neigh_comm, &req);
+        m_reqs.push_back(req);
+
+        sz += sizeof(Scalar4);
+        }
+
+    // the messages are left in flight, finishUpdateGhosts() waits for them and wraps the received positions
+    m_comm_pending = true;
+    m_pending_wrap_start = start_idx;
+    m_pending_wrap_n = flags[comm_flag::position] ? m_direct_num_recv_ghosts : 0;
+
+    if (m_prof)
+        m_prof->pop(0, (m_direct_num_recv_ghosts+m_direct_num_copy_ghosts)*sz);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void Communicator::updateNetForce(unsigned int timestep)
     {
+    // the ghost data must be complete before net forces are exchanged
+    if (m_comm_pending)
+        finishUpdateGhosts(timestep);
+
     CommFlags flags = getFlags();
     if (! flags[comm_flag::net_force] && ! flags[comm_flag::reverse_net_force] && ! flags[comm_flag::net_torque] && ! flags[comm_flag::net_virial])
         return;
@@ -2823,6 +3432,102 @@ void Communicator::updateNetForce(unsigned int timestep)
     }
 
 
+/*! \param values Host array indexed like the particle data
+
+    The values of the received ghosts are overwritten, the values of the local particles are only read.
+ */
+void Communicator::updateGhostScalars(Scalar *values)
+    {
+    // the ghost data must be complete before ghosts are forwarded
+    if (m_comm_pending)
+        finishUpdateGhosts(0);
+
+    if (m_prof)
+        m_prof->push("comm_ghost_scalar");
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    if (m_direct_ghosts_active)
+        {
+        m_scalar_copybuf.resize(m_direct_num_copy_ghosts);
+
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_direct_copy_ghosts, access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_scalar_copybuf(m_scalar_copybuf, access_location::host, access_mode::overwrite);
+
+            for (unsigned int ghost_idx = 0; ghost_idx < m_direct_num_copy_ghosts; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN());
+                h_scalar_copybuf.data[ghost_idx] = values[idx];
+                }
+            }
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        ArrayHandle<Scalar> h_scalar_copybuf(m_scalar_copybuf, access_location::host, access_mode::read);
+        MPI_Neighbor_alltoallv(h_scalar_copybuf.data, m_direct_send_counts.data(), m_direct_send_displs.data(), MPI_HOOMD_SCALAR,
+            values + m_pdata->getN(), m_direct_recv_counts.data(), m_direct_recv_displs.data(), MPI_HOOMD_SCALAR, m_neigh_comm);
+
+        if (m_prof)
+            m_prof->pop(0, (m_direct_num_recv_ghosts+m_direct_num_copy_ghosts)*sizeof(Scalar));
+        }
+    else
+        {
+        unsigned int num_tot_recv_ghosts = 0;
+
+        for (unsigned int dir = 0; dir < 6; dir ++)
+            {
+            if (! isCommunicating(dir) ) continue;
+
+            m_scalar_copybuf.resize(m_num_copy_ghosts[dir]);
+
+                {
+                ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+                ArrayHandle<Scalar> h_scalar_copybuf(m_scalar_copybuf, access_location::host, access_mode::overwrite);
+
+                // ghosts received in an earlier stage may be forwarded
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                    {
+                    unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                    assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                    h_scalar_copybuf.data[ghost_idx] = values[idx];
+                    }
+                }
+
+            unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+            // we receive from the direction opposite to the one we send to
+            unsigned int recv_neighbor;
+            if (dir % 2 == 0)
+                recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+            else
+                recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+            unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+            num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+            if (m_prof)
+                m_prof->push("MPI send/recv");
+
+            m_reqs.resize(2);
+            m_stats.resize(2);
+
+            ArrayHandle<Scalar> h_scalar_copybuf(m_scalar_copybuf, access_location::host, access_mode::read);
+            MPI_Isend(h_scalar_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar), MPI_BYTE, send_neighbor, 4, m_mpi_comm, &m_reqs[0]);
+            MPI_Irecv(values + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar), MPI_BYTE, recv_neighbor, 4, m_mpi_comm, &m_reqs[1]);
+            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+
+            if (m_prof)
+                m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sizeof(Scalar));
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void Communicator::removeGhostParticleTags()
     {
     // wipe out reverse-lookup tag -> idx for old ghost atoms
@@ -2925,6 +3630,10 @@ const BoxDim Communicator::getShiftedBox() const
 void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator> >(m,"Communicator")
-    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >());
+    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    .def("setGhostUpdateOverlap", &Communicator::setGhostUpdateOverlap)
+    .def("getGhostUpdateOverlap", &Communicator::getGhostUpdateOverlap)
+    .def("setDirectGhostExchange", &Communicator::setDirectGhostExchange)
+    .def("getDirectGhostExchange", &Communicator::getDirectGhostExchange);
     }
 #endif // ENABLE_MPI
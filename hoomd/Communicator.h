@@ -147,6 +147,10 @@ struct rank_element
  * In stage two and three, ghost atoms received from a neighboring processor are always included in the local
  * ghost atom lists, and they maybe replicated to more neighboring processors by the communication pattern
  * described above.
+ *
+ * Alternatively, stages two and three can send every ghost directly to all face, edge and corner neighbors
+ * it is adjacent to, in a single round of MPI neighborhood collectives on a distributed graph communicator
+ * (see setDirectGhostExchange()). This exchange is used on the CPU whenever no net forces are communicated.
  * \ingroup communication
  */
 class PYBIND11_EXPORT Communicator
@@ -238,6 +242,16 @@ class PYBIND11_EXPORT Communicator
             return m_compute_callbacks;
             }
 
+        //! Subscribe to list of functions that report the time spent on local computation
+        /*! Subscribers return the accumulated time (in seconds) this rank has spent computing, excluding
+         * communication. The sum over all subscribers is used to balance the load between ranks.
+         * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+         */
+        Nano::Signal<double ()>& getComputeTimeSignal()
+            {
+            return m_compute_time_requests;
+            }
+
         //! Get the ghost communication flags
         CommFlags getFlags() { return m_flags; }
 
@@ -278,8 +292,47 @@ class PYBIND11_EXPORT Communicator
         /*! Interface to the communication methods.
          * This method is supposed to be called every time step and automatically performs all necessary
          * communication steps.
+         *
+         * \param timestep The time step
+         * \param allow_overlap If true and overlapping ghost updates are enabled, a ghost update may still be
+         *        in flight when communicate() returns. The caller must then call finishUpdateGhosts() before any
+         *        ghost particle data is accessed (see isGhostUpdatePending()).
          */
-        void communicate(unsigned int timestep);
+        void communicate(unsigned int timestep, bool allow_overlap=false);
+
+        //! Enable or disable overlapping the ghost update with the force computation
+        /*! \param overlap True to leave the ghost update in flight while forces on interior particles are computed
+         */
+        void setGhostUpdateOverlap(bool overlap)
+            {
+            m_ghost_update_overlap = overlap;
+            }
+
+        //! Returns true if overlapping ghost updates are enabled
+        bool getGhostUpdateOverlap() const
+            {
+            return m_ghost_update_overlap;
+            }
+
+        //! Enable or disable the single-stage ghost exchange
+        /*! \param direct True to send ghosts directly to all (up to 26) neighboring domains in a single round
+         *
+         * This method must be called collectively on all ranks. The ghosts are exchanged again in the next call
+         * to communicate().
+         */
+        void setDirectGhostExchange(bool direct);
+
+        //! Returns true if the single-stage ghost exchange is enabled
+        bool getDirectGhostExchange() const
+            {
+            return m_direct_ghost_exchange;
+            }
+
+        //! Returns true if a ghost update has been started but not finished
+        bool isGhostUpdatePending() const
+            {
+            return m_comm_pending;
+            }
 
         //@}
 
@@ -307,20 +360,27 @@ class PYBIND11_EXPORT Communicator
         virtual void beginUpdateGhosts(unsigned int timestep);
 
         /*! Finish ghost update
+         *
+         * Waits for the messages of the last stage of the ghost update and wraps the received positions.
          *
          * \param timestep The time step
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
 
         /*! Communicate the net particle force
          * \parm timestep The time step
          */
         virtual void updateNetForce(unsigned int timestep);
 
+        /*! Copy a per-particle scalar of the local particles to their ghost copies
+         *
+         * Uses the ghost lists of the last call to exchangeGhosts(), so that the ghosts receive their values in
+         * the same order as their positions.
+         *
+         * \param values Host array indexed like the particle data, with at least N+Nghosts elements
+         */
+        virtual void updateGhostScalars(Scalar *values);
+
         /*! This methods finds all the particles that are no longer inside the domain
          * boundaries and transfers them to neighboring processors.
          *
@@ -456,6 +516,21 @@ class PYBIND11_EXPORT Communicator
         //! Helper function to update the shifted box for ghost particle PBC
         const BoxDim getShiftedBox() const;
 
+        //! Create the distributed graph communicator connecting this domain to all its neighbors
+        void initializeNeighborhoodComm();
+
+        //! Returns true if the ghosts can be exchanged in a single stage with the current flags
+        bool useDirectGhostExchange();
+
+        //! Build the ghost lists and exchange ghost particle data with all neighbors in a single round
+        /*! \param flags The ghost communication flags
+         *  \param mask Mask for allowed sending directions
+         */
+        void exchangeGhostsDirect(const CommFlags& flags, unsigned int mask);
+
+        //! Start the single-stage update of ghost positions, velocities and orientations
+        void beginUpdateGhostsDirect();
+
         std::shared_ptr<SystemDefinition> m_sysdef;                 //!< System definition
         std::shared_ptr<ParticleData> m_pdata;                      //!< Particle data
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf;  //!< Execution configuration
@@ -489,6 +564,7 @@ class PYBIND11_EXPORT Communicator
         GlobalVector<Scalar4> m_nettorque_copybuf;   //!< Buffer for net torque
         GlobalVector<Scalar> m_netvirial_copybuf;   //!< Buffer for net virial
         GlobalVector<Scalar> m_netvirial_recvbuf;   //!< Buffer for net virial (receive)
+        GlobalVector<Scalar> m_scalar_copybuf;      //!< Buffer for per-particle scalars in updateGhostScalars()
 
         GlobalVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
         unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
@@ -523,6 +599,22 @@ class PYBIND11_EXPORT Communicator
         bool m_has_ghost_particles;              //!< True if we have a current copy of ghost particles
 
         MPI_Datatype m_mpi_pdata_element;        //!< A datatype for the (non-packed) pdata_element struct
+        MPI_Datatype m_mpi_scalar4;              //!< A datatype for Scalar4
+        MPI_Datatype m_mpi_int3;                 //!< A datatype for int3
+
+        /* Single-stage ghost exchange */
+        bool m_direct_ghost_exchange;            //!< True if ghosts are sent directly to all neighbors
+        bool m_direct_ghosts_active;             //!< True if the current ghost lists were built in a single stage
+        MPI_Comm m_neigh_comm;                   //!< Distributed graph communicator of all neighboring domains
+        std::vector<unsigned int> m_neigh_dirs;  //!< Neighbor directions (3x3x3 index) in the order of the graph
+        int m_neigh_slot[27];                    //!< Position of a neighbor direction in the graph (-1 if none)
+        GlobalVector<unsigned int> m_direct_copy_ghosts; //!< Tags of particles sent as ghosts, grouped by neighbor
+        std::vector<int> m_direct_send_counts;   //!< Number of ghosts sent to every neighbor
+        std::vector<int> m_direct_send_displs;   //!< Offset of every neighbor in the send buffers
+        std::vector<int> m_direct_recv_counts;   //!< Number of ghosts received from every neighbor
+        std::vector<int> m_direct_recv_displs;   //!< Offset of every neighbor in the received ghosts
+        unsigned int m_direct_num_copy_ghosts;   //!< Total number of ghosts sent
+        unsigned int m_direct_num_recv_ghosts;   //!< Total number of ghosts received
 
         //! Update the ghost width array
         void updateGhostWidth();
@@ -542,6 +634,9 @@ class PYBIND11_EXPORT Communicator
         Nano::Signal<void (unsigned int timestep)>
             m_compute_callbacks;   //!< List of functions that are called after ghost communication
 
+        Nano::Signal<double ()>
+            m_compute_time_requests;  //!< List of functions that report the accumulated local compute time
+
         Nano::Signal<void (const GlobalArray<unsigned int>& )>
             m_comm_callbacks;   //!< List of functions that are called after the compute callbacks
 
@@ -549,6 +644,9 @@ class PYBIND11_EXPORT Communicator
         CommFlags m_last_flags;                       //!< Flags of last ghost exchange
 
         bool m_comm_pending;                     //!< If true, a communication is in process
+        bool m_ghost_update_overlap;             //!< If true, communicate() may leave the ghost update in flight
+        unsigned int m_pending_wrap_start;       //!< First ghost index received in the pending stage
+        unsigned int m_pending_wrap_n;           //!< Number of ghost positions received in the pending stage
         std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
         std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
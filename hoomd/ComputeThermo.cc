@@ -28,10 +28,14 @@ using namespace std;
 ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
                              std::shared_ptr<ParticleGroup> group,
                              const std::string& suffix)
-    : Compute(sysdef), m_group(group), m_ndof(1), m_ndof_rot(0), m_logging_enabled(true)
+    : Compute(sysdef), m_group(group), m_ndof(1), m_ndof_rot(0), m_logging_enabled(true),
+      m_group_external_energy(0.0)
     {
     m_exec_conf->msg->notice(5) << "Constructing ComputeThermo" << endl;
 
+    for (unsigned int i = 0; i < 6; i++)
+        m_group_external_virial[i] = Scalar(0.0);
+
     assert(m_pdata);
     GlobalArray< Scalar > properties(thermo_index::num_quantities, m_exec_conf);
     m_properties.swap(properties);
@@ -326,16 +330,16 @@ void ComputeThermo::computeProperties()
                 }
             }
 
-        pe_total += m_pdata->getExternalEnergy();
+        pe_total += m_pdata->getExternalEnergy() + m_group_external_energy;
         }
 
     double W = 0.0;
-    double virial_xx = m_pdata->getExternalVirial(0);
-    double virial_xy = m_pdata->getExternalVirial(1);
-    double virial_xz = m_pdata->getExternalVirial(2);
-    double virial_yy = m_pdata->getExternalVirial(3);
-    double virial_yz = m_pdata->getExternalVirial(4);
-    double virial_zz = m_pdata->getExternalVirial(5);
+    double virial_xx = m_pdata->getExternalVirial(0) + m_group_external_virial[0];
+    double virial_xy = m_pdata->getExternalVirial(1) + m_group_external_virial[1];
+    double virial_xz = m_pdata->getExternalVirial(2) + m_group_external_virial[2];
+    double virial_yy = m_pdata->getExternalVirial(3) + m_group_external_virial[3];
+    double virial_yz = m_pdata->getExternalVirial(4) + m_group_external_virial[4];
+    double virial_zz = m_pdata->getExternalVirial(5) + m_group_external_virial[5];
 
     if (flags[pdata_flag::pressure_tensor])
         {
@@ -364,7 +368,8 @@ void ComputeThermo::computeProperties()
         }
      else if (flags[pdata_flag::isotropic_virial])
         {
-        // only sum up isotropic part of virial tensor
+        // only sum up isotropic part of virial tensor, starting from the external contribution
+        W = Scalar(1./3.) * (virial_xx + virial_yy + virial_zz);
         unsigned int virial_pitch = net_virial.getPitch();
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
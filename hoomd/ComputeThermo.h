@@ -291,6 +291,28 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Get the group over which the properties are computed
+        std::shared_ptr<ParticleGroup> getGroup()
+            {
+            return m_group;
+            }
+
+        //! Set the potential energy of the group from forces that are not part of the net force
+        void setGroupExternalEnergy(Scalar energy)
+            {
+            m_group_external_energy = energy;
+            }
+
+        //! Set a component of the virial of the group from forces that are not part of the net force
+        /*! \param i Index of the virial component (xx, xy, xz, yy, yz, zz)
+            \param v Value of the virial component
+        */
+        void setGroupExternalVirial(unsigned int i, Scalar v)
+            {
+            assert(i < 6);
+            m_group_external_virial[i] = v;
+            }
+
         //! Control the enable_logging flag
         /*! Set this flag to false to prevent this compute from providing logged quantities.
             This is useful for internal computes that should not appear in the logs.
@@ -309,6 +331,8 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         unsigned int m_ndof_rot;        //!< Stores the number of rotational degrees of freedom in the system
         std::vector<std::string> m_logname_list;  //!< Cache all generated logged quantities names
         bool m_logging_enabled;         //!< Set to false to disable communication with the logger
+        Scalar m_group_external_energy;     //!< Potential energy of the group not in the net force
+        Scalar m_group_external_virial[6];  //!< Virial of the group not in the net force
 
         //! Does the actual computation
         virtual void computeProperties();
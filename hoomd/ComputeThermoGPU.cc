@@ -144,13 +144,13 @@ void ComputeThermoGPU::computeProperties()
     args.d_scratch_pressure_tensor = d_scratch_pressure_tensor.data;
     args.d_scratch_rot = d_scratch_rot.data;
     args.block_size = m_block_size;
-    args.external_virial_xx = m_pdata->getExternalVirial(0);
-    args.external_virial_xy = m_pdata->getExternalVirial(1);
-    args.external_virial_xz = m_pdata->getExternalVirial(2);
-    args.external_virial_yy = m_pdata->getExternalVirial(3);
-    args.external_virial_yz = m_pdata->getExternalVirial(4);
-    args.external_virial_zz = m_pdata->getExternalVirial(5);
-    args.external_energy = m_pdata->getExternalEnergy();
+    args.external_virial_xx = m_pdata->getExternalVirial(0) + m_group_external_virial[0];
+    args.external_virial_xy = m_pdata->getExternalVirial(1) + m_group_external_virial[1];
+    args.external_virial_xz = m_pdata->getExternalVirial(2) + m_group_external_virial[2];
+    args.external_virial_yy = m_pdata->getExternalVirial(3) + m_group_external_virial[3];
+    args.external_virial_yz = m_pdata->getExternalVirial(4) + m_group_external_virial[4];
+    args.external_virial_zz = m_pdata->getExternalVirial(5) + m_group_external_virial[5];
+    args.external_energy = m_pdata->getExternalEnergy() + m_group_external_energy;
 
     // perform the computation on the GPU(s)
     gpu_compute_thermo_partial( d_properties.data,
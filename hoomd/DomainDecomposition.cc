@@ -407,10 +407,17 @@ unsigned int DomainDecomposition::getNeighborRank(unsigned int dir) const
 
     int adj[6][3] = {{1,0,0},{-1,0,0},{0,1,0},{0,-1,0},{0,0,1},{0,0,-1}};
 
+    return getNeighborRank(make_int3(adj[dir][0], adj[dir][1], adj[dir][2]));
+    }
+
+/*! \param offset Offset of the neighbor in the processor grid, every component is -1, 0 or 1
+ */
+unsigned int DomainDecomposition::getNeighborRank(int3 offset) const
+    {
     // determine neighbor position
-    int ineigh = (int) m_grid_pos.x + adj[dir][0];
-    int jneigh = (int) m_grid_pos.y + adj[dir][1];
-    int kneigh = (int) m_grid_pos.z + adj[dir][2];
+    int ineigh = (int) m_grid_pos.x + offset.x;
+    int jneigh = (int) m_grid_pos.y + offset.y;
+    int kneigh = (int) m_grid_pos.z + offset.z;
 
     // wrap across boundaries
     if (ineigh < 0)
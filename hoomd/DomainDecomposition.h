@@ -75,6 +75,9 @@ class PYBIND11_EXPORT DomainDecomposition
         //! Calculate MPI ranks of neighboring domain.
         unsigned int getNeighborRank(unsigned int dir) const;
 
+        //! Calculate MPI rank of a face, edge or corner neighbor
+        unsigned int getNeighborRank(int3 offset) const;
+
         //! Get domain indexer
         const Index3D& getDomainIndexer() const
             {
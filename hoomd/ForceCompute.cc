@@ -283,6 +283,21 @@ void ForceCompute::compute(unsigned int timestep)
     m_particles_sorted = false;
     }
 
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    Integrator calls computeInterior() before the ghost update started by Communicator::communicate() has finished,
+    followed by compute() for the same \a timestep. Nothing is done if compute() is not going to recompute the forces.
+*/
+void ForceCompute::computeInterior(unsigned int timestep)
+    {
+    if (m_particles_sorted || !peekCompute(timestep))
+        return;
+
+    computeInteriorForces(timestep);
+    }
+#endif
+
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
@@ -69,6 +69,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
          * and can be used to overlap computation with communication
          */
         virtual void preCompute(unsigned int timestep){}
+
+        //! Compute the forces that do not depend on ghost particles
+        void computeInterior(unsigned int timestep);
         #endif
 
         //! Computes the forces
@@ -154,6 +157,16 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     protected:
         bool m_particles_sorted;    //!< Flag set to true when particles are resorted in memory
 
+        #ifdef ENABLE_MPI
+        //! Compute the forces on particles that do not interact with ghost particles
+        /*! Called by computeInterior() while the ghost update is still in flight, so implementations must not access
+            any ghost particle data. The following call to computeForces() at the same time step must complete the
+            force computation for all remaining particles. The base class implementation does nothing, and
+            computeForces() then computes all forces as usual.
+        */
+        virtual void computeInteriorForces(unsigned int timestep) {}
+        #endif
+
         //! Helper function called when particles are sorted
         /*! setParticlesSorted() is passed as a slot to the particle sort signal.
             It is used to flag \c m_particles_sorted so that a second call to compute
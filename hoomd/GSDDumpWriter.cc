@@ -20,8 +20,12 @@
 #include "hoomd/extern/pybind/include/pybind11/numpy.h"
 
 #include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
 #include <stdexcept>
 #include <list>
+#include <algorithm>
 using namespace std;
 namespace py = pybind11;
 
@@ -44,9 +48,20 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
-                        m_group(group)
+                        m_nframes(0),
+                        m_write_slots(false),
+                        m_n_writers(0),
+                        m_group(group),
+                        m_queue_depth(0),
+                        m_cur_frame(NULL),
+                        m_writer_stop(false),
+                        m_writer_retval(GSD_SUCCESS),
+                        m_writer_errno(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
+    #ifdef ENABLE_MPI
+    m_mpi_file_open = false;
+    #endif
     }
 
 void GSDDumpWriter::checkError(int retval)
@@ -144,6 +159,7 @@ void GSDDumpWriter::initFileIO()
         throw runtime_error("Error opening GSD file");
         }
 
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
     }
 
@@ -156,6 +172,15 @@ GSDDumpWriter::~GSDDumpWriter()
     root = m_exec_conf->isRoot();
     #endif
 
+    // write out any queued frames before closing the file
+    stopWriterThread();
+
+    #ifdef ENABLE_MPI
+    // collective, all ranks opened the file in the same frame
+    if (m_mpi_file_open)
+        MPI_File_close(&m_mpi_file);
+    #endif
+
     if (root && m_is_initialized)
         {
         m_exec_conf->msg->notice(5) << "dump.gsd: close gsd file " << m_fname << endl;
@@ -176,32 +201,59 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
+    bool distributed = false;
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
+
+    // write per-particle data directly from the ranks that own the particles
+    distributed = m_n_writers > 0 && m_pdata->getDomainDecomposition();
 #endif
 
+    // take particle data snapshot
+    SnapshotParticleData<float> snapshot;
+    std::map<unsigned int, unsigned int> map;
+    if (!distributed)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+        map = m_pdata->takeSnapshot<float>(snapshot);
+        }
+
     // open the file if it is not yet opened
     if (! m_is_initialized && root)
         initFileIO();
 
+    // buffer the frame for the writer thread, unless slots or other ranks need to write directly to the file
+    bool buffered = m_queue_depth > 0 && !m_write_slots && !distributed;
+    if (root)
+        {
+        if (buffered)
+            beginBufferedFrame();
+        else
+            flush();
+        }
+
     // truncate the file if requested
     if (m_truncate && root)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        checkError(retval);
+        if (buffered)
+            {
+            m_cur_frame->truncate = true;
+            }
+        else
+            {
+            retval = gsd_truncate(&m_handle);
+            checkError(retval);
+            }
+        m_nframes = 0;
         }
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "dump.gsd: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -215,14 +267,22 @@ void GSDDumpWriter::analyze(unsigned int timestep)
         writeFrameHeader(timestep);
 
         // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+        if (!distributed)
+            {
+            if (m_write_attribute || nframes == 0)
+                writeAttributes(snapshot, map);
+            if (m_write_property || nframes == 0)
+                writeProperties(snapshot, map);
+            if (m_write_momentum || nframes == 0)
+                writeMomenta(snapshot, map);
+            }
         }
 
+    #ifdef ENABLE_MPI
+    if (distributed)
+        writeParticlesDistributed(nframes);
+    #endif
+
     // topology is only meaningful if this is the all group
     if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0))
         {
@@ -256,14 +316,239 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (root)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        checkError(retval);
+        if (buffered)
+            {
+            queueBufferedFrame();
+
+            // restart files must be complete on disk when analyze() returns
+            if (m_truncate)
+                flush();
+            }
+        else
+            {
+            retval = gsd_end_frame(&m_handle);
+            checkError(retval);
+            }
+        m_nframes++;
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param depth Number of frames that may be queued for the writer thread
+
+    When \a depth is 0, analyze() writes frames synchronously. Otherwise, analyze() copies the frame into one of \a depth
+    buffers and a background thread writes it to the file. Any queued frames are written out before changing the depth.
+*/
+void GSDDumpWriter::setQueueDepth(unsigned int depth)
+    {
+    m_exec_conf->msg->notice(5) << "dump.gsd: setting queue depth to " << depth << endl;
+    stopWriterThread();
+    checkWriterError();
+    m_queue_depth = depth;
+    }
+
+/*! Wait for the writer thread to write all queued frames and raise any error that occurred while writing them.
+*/
+void GSDDumpWriter::flush()
+    {
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue_cv.wait(lock, [this]{ return m_queued_frames.empty(); });
+
+        // release the buffer of a frame that was not completed due to an exception
+        if (m_cur_frame)
+            {
+            m_free_frames.push_back(m_cur_frame);
+            m_cur_frame = NULL;
+            }
+        }
+
+    checkWriterError();
+    }
+
+/*! \param name Name of the chunk
+    \param type Data type of the chunk
+    \param N Number of rows in the chunk
+    \param M Number of columns in the chunk
+    \param data Chunk data
+
+    \returns The gsd error code
+
+    Writes the chunk directly to the file, or copies it into the current frame buffer when one is active.
+*/
+int GSDDumpWriter::writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data)
+    {
+    if (!m_cur_frame)
+        return gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+
+    BufferedFrame& frame = *m_cur_frame;
+    if (frame.n_chunks == frame.chunks.size())
+        frame.chunks.resize(frame.n_chunks + 1);
+
+    BufferedChunk& chunk = frame.chunks[frame.n_chunks];
+    frame.n_chunks++;
+
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+
+    size_t size = N * M * gsd_sizeof_type(type);
+    chunk.data.resize(size);
+    if (size > 0)
+        memcpy(&chunk.data[0], data, size);
+
+    return GSD_SUCCESS;
+    }
+
+/*! Blocks until a frame buffer is free when the queue is full. The buffers and the writer thread are created on first
+    use.
+*/
+void GSDDumpWriter::beginBufferedFrame()
+    {
+    checkWriterError();
+
+    if (!m_writer_thread.joinable())
+        {
+        m_exec_conf->msg->notice(5) << "dump.gsd: starting writer thread with " << m_queue_depth << " buffers" << endl;
+        for (unsigned int i = 0; i < m_queue_depth; i++)
+            {
+            m_frames.push_back(std::unique_ptr<BufferedFrame>(new BufferedFrame()));
+            m_free_frames.push_back(m_frames.back().get());
+            }
+        m_writer_stop = false;
+        m_writer_thread = std::thread(&GSDDumpWriter::writerThread, this);
+        }
+
+    // reuse the buffer of a frame that was not completed due to an exception
+    if (!m_cur_frame)
+        {
+        if (m_prof)
+            m_prof->push("Wait");
+
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue_cv.wait(lock, [this]{ return !m_free_frames.empty(); });
+        m_cur_frame = m_free_frames.front();
+        m_free_frames.pop_front();
+
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    m_cur_frame->truncate = false;
+    m_cur_frame->n_chunks = 0;
+    }
+
+void GSDDumpWriter::queueBufferedFrame()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_queued_frames.push_back(m_cur_frame);
+    m_cur_frame = NULL;
+    m_queue_cv.notify_all();
+    }
+
+/*! Runs on the writer thread until stopWriterThread() is called and the queue is empty. A frame is only removed from
+    the queue after it is written, so flush() can wait for an empty queue. After an error, the remaining queued frames
+    are discarded until checkWriterError() reports it.
+*/
+void GSDDumpWriter::writerThread()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    while (true)
+        {
+        m_queue_cv.wait(lock, [this]{ return m_writer_stop || !m_queued_frames.empty(); });
+        if (m_queued_frames.empty())
+            break;
+
+        BufferedFrame *frame = m_queued_frames.front();
+        bool skip = m_writer_retval != GSD_SUCCESS;
+        lock.unlock();
+
+        int retval = GSD_SUCCESS;
+        int error_number = 0;
+        if (!skip)
+            {
+            retval = writeBufferedFrame(*frame);
+            error_number = errno;
+            }
+
+        lock.lock();
+        if (retval != GSD_SUCCESS)
+            {
+            m_writer_retval = retval;
+            m_writer_errno = error_number;
+            }
+        m_queued_frames.pop_front();
+        m_free_frames.push_back(frame);
+        m_queue_cv.notify_all();
+        }
+    }
+
+/*! \param frame Frame to write
+    \returns The gsd error code
+*/
+int GSDDumpWriter::writeBufferedFrame(const BufferedFrame& frame)
+    {
+    int retval;
+    if (frame.truncate)
+        {
+        retval = gsd_truncate(&m_handle);
+        if (retval != GSD_SUCCESS)
+            return retval;
+        }
+
+    for (unsigned int i = 0; i < frame.n_chunks; i++)
+        {
+        const BufferedChunk& chunk = frame.chunks[i];
+        retval = gsd_write_chunk(&m_handle, chunk.name.c_str(), chunk.type, chunk.N, chunk.M, 0,
+                                 chunk.data.size() > 0 ? &chunk.data[0] : NULL);
+        if (retval != GSD_SUCCESS)
+            return retval;
+        }
+
+    return gsd_end_frame(&m_handle);
+    }
+
+/*! Writes out all queued frames before stopping the thread. Errors are left for checkWriterError(), so this method
+    can be called from the destructor.
+*/
+void GSDDumpWriter::stopWriterThread()
+    {
+    if (m_writer_thread.joinable())
+        {
+            {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_writer_stop = true;
+            m_queue_cv.notify_all();
+            }
+        m_writer_thread.join();
+        }
+
+    m_cur_frame = NULL;
+    m_free_frames.clear();
+    m_queued_frames.clear();
+    m_frames.clear();
+    }
+
+void GSDDumpWriter::checkWriterError()
+    {
+    int retval;
+    int error_number;
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        retval = m_writer_retval;
+        error_number = m_writer_errno;
+        m_writer_retval = GSD_SUCCESS;
+        }
+
+    if (retval != GSD_SUCCESS)
+        {
+        errno = error_number;
+        checkError(retval);
+        }
+    }
 
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
     {
@@ -279,7 +564,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
+        int retval = writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, (void *)&types[0]);
         checkError(retval);
         }
 
@@ -298,14 +583,14 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     int retval;
     m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
+    retval = writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void *)&step);
     checkError(retval);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/dimensions" << endl;
         uint8_t dimensions = m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
+        retval = writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, (void *)&dimensions);
         checkError(retval);
         }
 
@@ -318,12 +603,12 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     box_a[3] = box.getTiltFactorXY();
     box_a[4] = box.getTiltFactorXZ();
     box_a[5] = box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
+    retval = writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, (void *)box_a);
     checkError(retval);
 
     m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+    retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
     checkError(retval);
     }
 
@@ -335,7 +620,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -361,7 +646,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
+            retval = writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&type[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
@@ -390,7 +675,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
@@ -414,7 +699,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
@@ -439,7 +724,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
@@ -468,7 +753,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
+            retval = writeChunk("particles/body", GSD_TYPE_INT32, N, 1, (void *)&body[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
@@ -503,7 +788,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
@@ -519,7 +804,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -539,7 +824,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+        retval = writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
         checkError(retval);
         }
 
@@ -573,7 +858,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
@@ -589,7 +874,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -619,7 +904,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
@@ -656,7 +941,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
@@ -691,7 +976,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/image", GSD_TYPE_INT32, N, 3, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
@@ -699,6 +984,422 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
     }
 
+#ifdef ENABLE_MPI
+//! Per-particle data sent to the writer rank that owns the particle's row
+struct GSDParticleRecord
+    {
+    uint32_t row;               //!< Row of the particle in the output chunks
+    uint32_t type;              //!< Type id
+    float pos[3];               //!< Position
+    float orientation[4];       //!< Orientation
+    float vel[3];               //!< Velocity
+    float angmom[4];            //!< Angular momentum
+    int32_t image[3];           //!< Image
+    float mass;                 //!< Mass
+    float charge;               //!< Charge
+    float diameter;             //!< Diameter
+    int32_t body;               //!< Body id
+    float inertia[3];           //!< Moment of inertia
+    };
+
+/*! \param nframes Number of frames in the file before this one
+
+    Writes the chunks of writeAttributes(), writeProperties(), and writeMomenta() without gathering a snapshot. The rows
+    of every chunk (the group members in ascending tag order) are divided evenly among m_n_writers writer ranks. Each
+    rank sends its group members to the writers that own their rows with one MPI_Alltoallv. For every chunk, the root
+    rank reserves space in the file and the writers fill their rows with a collective MPI-IO write. Chunks that are
+    all default values are skipped with the same rules as the serial code path, and nothing is written for an empty
+    group.
+
+    The file is opened for MPI-IO once, with data sieving disabled so that no rank rewrites bytes it did not write.
+    The root rank writes to the same file through gsd, so its writes are synced before the collective writes, and the
+    collective writes are synced before the root rank writes the frame index.
+*/
+void GSDDumpWriter::writeParticlesDistributed(uint64_t nframes)
+    {
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    const unsigned int rank = m_exec_conf->getRank();
+    const bool root = m_exec_conf->isRoot();
+
+    // the non-default flags are read from the file on the root rank
+    bcast(m_nondefault, 0, mpi_comm);
+
+    // writer k owns the rows [row_begin[k], row_begin[k+1]) and runs on rank writer_rank[k]
+    const uint64_t N = m_group->getNumMembersGlobal();
+    const unsigned int n_writers = std::min(m_n_writers, n_ranks);
+    std::vector<uint64_t> row_begin(n_writers+1);
+    std::vector<unsigned int> writer_rank(n_writers);
+    int my_writer = -1;
+    for (unsigned int k = 0; k <= n_writers; k++)
+        row_begin[k] = N * k / n_writers;
+    for (unsigned int k = 0; k < n_writers; k++)
+        {
+        writer_rank[k] = k * n_ranks / n_writers;
+        if (writer_rank[k] == rank)
+            my_writer = k;
+        }
+
+    // pack the local group members
+    std::vector<GSDParticleRecord> local;
+    std::vector<unsigned int> dest;
+    std::vector<int> send_counts(n_ranks, 0);
+        {
+        // access the group first, it may need the tag array to rebuild
+        const unsigned int n_members = m_group->getNumMembers();
+        const GlobalArray<unsigned int>& member_idx = m_group->getIndexArray();
+        const GlobalArray<unsigned int>& member_tags = m_group->getMemberTagArray();
+        ArrayHandle<unsigned int> h_member_idx(member_idx, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_member_tags(member_tags, access_location::host, access_mode::read);
+
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        const Scalar3 origin = m_pdata->getOrigin();
+        const int3 o_image = m_pdata->getOriginImage();
+
+        local.resize(n_members);
+        dest.resize(n_members);
+        for (unsigned int j = 0; j < n_members; j++)
+            {
+            unsigned int idx = h_member_idx.data[j];
+            GSDParticleRecord& r = local[j];
+
+            r.row = std::lower_bound(h_member_tags.data, h_member_tags.data + N, h_tag.data[idx]) - h_member_tags.data;
+            assert(r.row < N && h_member_tags.data[r.row] == h_tag.data[idx]);
+
+            // store the same coordinates as takeSnapshot()
+            Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+            int3 image = h_image.data[idx];
+            image.x -= o_image.x;
+            image.y -= o_image.y;
+            image.z -= o_image.z;
+            global_box.wrap(pos, image);
+
+            r.type = __scalar_as_int(h_pos.data[idx].w);
+            r.pos[0] = float(pos.x);
+            r.pos[1] = float(pos.y);
+            r.pos[2] = float(pos.z);
+            r.orientation[0] = float(h_orientation.data[idx].x);
+            r.orientation[1] = float(h_orientation.data[idx].y);
+            r.orientation[2] = float(h_orientation.data[idx].z);
+            r.orientation[3] = float(h_orientation.data[idx].w);
+            r.vel[0] = float(h_vel.data[idx].x);
+            r.vel[1] = float(h_vel.data[idx].y);
+            r.vel[2] = float(h_vel.data[idx].z);
+            r.angmom[0] = float(h_angmom.data[idx].x);
+            r.angmom[1] = float(h_angmom.data[idx].y);
+            r.angmom[2] = float(h_angmom.data[idx].z);
+            r.angmom[3] = float(h_angmom.data[idx].w);
+            r.image[0] = image.x;
+            r.image[1] = image.y;
+            r.image[2] = image.z;
+            r.mass = float(h_vel.data[idx].w);
+            r.charge = float(h_charge.data[idx]);
+            r.diameter = float(h_diameter.data[idx]);
+            r.body = int32_t(h_body.data[idx]);
+            r.inertia[0] = float(h_inertia.data[idx].x);
+            r.inertia[1] = float(h_inertia.data[idx].y);
+            r.inertia[2] = float(h_inertia.data[idx].z);
+
+            unsigned int k = std::upper_bound(row_begin.begin(), row_begin.end(), uint64_t(r.row)) - row_begin.begin() - 1;
+            dest[j] = writer_rank[k];
+            send_counts[dest[j]]++;
+            }
+        }
+
+    // send the records to the writers
+    std::vector<int> send_displs(n_ranks, 0);
+    for (unsigned int i = 1; i < n_ranks; i++)
+        send_displs[i] = send_displs[i-1] + send_counts[i-1];
+
+    std::vector<GSDParticleRecord> send_buf(local.size());
+        {
+        std::vector<int> offset(send_displs);
+        for (unsigned int j = 0; j < local.size(); j++)
+            send_buf[offset[dest[j]]++] = local[j];
+        }
+    std::vector<GSDParticleRecord>().swap(local);
+
+    std::vector<int> recv_counts(n_ranks);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    std::vector<int> recv_displs(n_ranks, 0);
+    for (unsigned int i = 1; i < n_ranks; i++)
+        recv_displs[i] = recv_displs[i-1] + recv_counts[i-1];
+
+    std::vector<GSDParticleRecord> recv_buf(recv_displs[n_ranks-1] + recv_counts[n_ranks-1]);
+
+    MPI_Datatype record_type;
+    MPI_Type_contiguous(sizeof(GSDParticleRecord), MPI_BYTE, &record_type);
+    MPI_Type_commit(&record_type);
+    MPI_Alltoallv(send_buf.data(), send_counts.data(), send_displs.data(), record_type,
+                  recv_buf.data(), recv_counts.data(), recv_displs.data(), record_type, mpi_comm);
+    MPI_Type_free(&record_type);
+    std::vector<GSDParticleRecord>().swap(send_buf);
+
+    // place the received records in row order
+    uint64_t first_row = 0;
+    uint64_t n_rows = 0;
+    if (my_writer >= 0)
+        {
+        first_row = row_begin[my_writer];
+        n_rows = row_begin[my_writer+1] - first_row;
+        }
+
+    std::vector<GSDParticleRecord> rows(n_rows);
+    for (unsigned int i = 0; i < recv_buf.size(); i++)
+        {
+        assert(recv_buf[i].row >= first_row && recv_buf[i].row < first_row + n_rows);
+        rows[recv_buf[i].row - first_row] = recv_buf[i];
+        }
+    std::vector<GSDParticleRecord>().swap(recv_buf);
+
+    if (!m_mpi_file_open)
+        {
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, const_cast<char *>("romio_ds_write"), const_cast<char *>("disable"));
+        int err = MPI_File_open(mpi_comm, const_cast<char *>(m_fname.c_str()), MPI_MODE_WRONLY, info, &m_mpi_file);
+        MPI_Info_free(&info);
+        if (err != MPI_SUCCESS)
+            {
+            m_exec_conf->msg->error() << "dump.gsd: Unable to open " << m_fname << " with MPI-IO" << endl;
+            throw runtime_error("Error writing GSD file");
+            }
+        m_mpi_file_open = true;
+        }
+
+    // the previous frames and any chunks gsd wrote directly must be on disk before other ranks write to the file
+    if (root && fsync(m_handle.fd) != 0)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+    MPI_Barrier(mpi_comm);
+    MPI_File_sync(m_mpi_file);
+
+    // write one chunk from the rows held by the writers, skipping chunks that are all default values
+    auto write_chunk = [&](const char *name, gsd_type type, uint32_t M, const void *data, bool all_default, bool optional)
+        {
+        // an empty group has no rows to write
+        if (N == 0)
+            return;
+
+        int all_default_global = all_default;
+        MPI_Allreduce(MPI_IN_PLACE, &all_default_global, 1, MPI_INT, MPI_LAND, mpi_comm);
+        if (optional && all_default_global && !(nframes > 0 && m_nondefault[name]))
+            return;
+
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << endl;
+        uint64_t location = 0;
+        if (root)
+            location = reserveChunk(name, type, N, M);
+        bcast(location, 0, mpi_comm);
+
+        const size_t row_size = M * gsd_sizeof_type(type);
+        MPI_Datatype row_type;
+        MPI_Type_contiguous(row_size, MPI_BYTE, &row_type);
+        MPI_Type_commit(&row_type);
+
+        MPI_Status status;
+        int err = MPI_File_write_at_all(m_mpi_file, location + first_row * row_size, const_cast<void *>(data), n_rows,
+                                        row_type, &status);
+        MPI_Type_free(&row_type);
+        if (err != MPI_SUCCESS)
+            {
+            m_exec_conf->msg->error() << "dump.gsd: MPI-IO error writing " << name << " - " << m_fname << endl;
+            throw runtime_error("Error writing GSD file");
+            }
+
+        if (optional && nframes == 0)
+            m_nondefault[name] = true;
+        };
+
+    if (m_write_attribute || nframes == 0)
+        {
+        if (root)
+            {
+            std::vector<std::string> type_mapping(m_pdata->getNTypes());
+            for (unsigned int i = 0; i < type_mapping.size(); i++)
+                type_mapping[i] = m_pdata->getNameByType(i);
+            writeTypeMapping("particles/types", type_mapping);
+            }
+
+            {
+            std::vector<uint32_t> data(n_rows);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                {
+                data[i] = rows[i].type;
+                all_default = all_default && data[i] == 0;
+                }
+            write_chunk("particles/typeid", GSD_TYPE_UINT32, 1, data.data(), all_default, true);
+            }
+
+            {
+            std::vector<float> mass(n_rows), charge(n_rows), diameter(n_rows);
+            bool mass_default = true, charge_default = true, diameter_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                {
+                mass[i] = rows[i].mass;
+                charge[i] = rows[i].charge;
+                diameter[i] = rows[i].diameter;
+                mass_default = mass_default && mass[i] == float(1.0);
+                charge_default = charge_default && charge[i] == float(0.0);
+                diameter_default = diameter_default && diameter[i] == float(1.0);
+                }
+            write_chunk("particles/mass", GSD_TYPE_FLOAT, 1, mass.data(), mass_default, true);
+            write_chunk("particles/charge", GSD_TYPE_FLOAT, 1, charge.data(), charge_default, true);
+            write_chunk("particles/diameter", GSD_TYPE_FLOAT, 1, diameter.data(), diameter_default, true);
+            }
+
+            {
+            std::vector<int32_t> data(n_rows);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                {
+                data[i] = rows[i].body;
+                all_default = all_default && data[i] == int32_t(NO_BODY);
+                }
+            write_chunk("particles/body", GSD_TYPE_INT32, 1, data.data(), all_default, true);
+            }
+
+            {
+            std::vector<float> data(n_rows*3);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                for (unsigned int c = 0; c < 3; c++)
+                    {
+                    data[i*3+c] = rows[i].inertia[c];
+                    all_default = all_default && data[i*3+c] == float(0.0);
+                    }
+            write_chunk("particles/moment_inertia", GSD_TYPE_FLOAT, 3, data.data(), all_default, true);
+            }
+        }
+
+    if (m_write_property || nframes == 0)
+        {
+            {
+            std::vector<float> data(n_rows*3);
+            for (unsigned int i = 0; i < n_rows; i++)
+                for (unsigned int c = 0; c < 3; c++)
+                    data[i*3+c] = rows[i].pos[c];
+            write_chunk("particles/position", GSD_TYPE_FLOAT, 3, data.data(), false, false);
+            }
+
+            {
+            std::vector<float> data(n_rows*4);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                for (unsigned int c = 0; c < 4; c++)
+                    {
+                    data[i*4+c] = rows[i].orientation[c];
+                    all_default = all_default && data[i*4+c] == (c == 0 ? float(1.0) : float(0.0));
+                    }
+            write_chunk("particles/orientation", GSD_TYPE_FLOAT, 4, data.data(), all_default, true);
+            }
+        }
+
+    if (m_write_momentum || nframes == 0)
+        {
+            {
+            std::vector<float> data(n_rows*3);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                for (unsigned int c = 0; c < 3; c++)
+                    {
+                    data[i*3+c] = rows[i].vel[c];
+                    all_default = all_default && data[i*3+c] == float(0.0);
+                    }
+            write_chunk("particles/velocity", GSD_TYPE_FLOAT, 3, data.data(), all_default, true);
+            }
+
+            {
+            std::vector<float> data(n_rows*4);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                for (unsigned int c = 0; c < 4; c++)
+                    {
+                    data[i*4+c] = rows[i].angmom[c];
+                    all_default = all_default && data[i*4+c] == float(0.0);
+                    }
+            write_chunk("particles/angmom", GSD_TYPE_FLOAT, 4, data.data(), all_default, true);
+            }
+
+            {
+            std::vector<int32_t> data(n_rows*3);
+            bool all_default = true;
+            for (unsigned int i = 0; i < n_rows; i++)
+                for (unsigned int c = 0; c < 3; c++)
+                    {
+                    data[i*3+c] = rows[i].image[c];
+                    all_default = all_default && data[i*3+c] == 0;
+                    }
+            write_chunk("particles/image", GSD_TYPE_INT32, 3, data.data(), all_default, true);
+            }
+        }
+
+    // complete the collective writes before the root rank ends the frame
+    MPI_File_sync(m_mpi_file);
+    MPI_Barrier(mpi_comm);
+    }
+
+/*! \param name Name of the chunk
+    \param type Data type of the chunk
+    \param N Number of rows in the chunk, larger than 0
+    \param M Number of columns in the chunk
+
+    
+eturns The offset in the file at which the chunk data must be written before the frame ends
+
+    gsd can only add a chunk to a frame together with its data. The chunk is added without data, which registers its
+    name in the file, and its buffered index entry is then moved to the frame index and pointed at \a N rows at the
+    end of the file. Chunks that gsd buffers until the end of the frame are written after the reserved space. Only
+    called on the root rank.
+*/
+uint64_t GSDDumpWriter::reserveChunk(const char *name, gsd_type type, uint64_t N, uint32_t M)
+    {
+    assert(N > 0);
+    checkError(gsd_write_chunk(&m_handle, name, type, 0, M, 0, NULL));
+
+    // an empty chunk is always buffered, and adds no bytes to the write buffer
+    assert(m_handle.buffer_index.size > 0);
+    gsd_index_entry entry = m_handle.buffer_index.data[m_handle.buffer_index.size-1];
+    m_handle.buffer_index.size--;
+
+    // grow the frame index the same way gsd does
+    gsd_index_buffer& frame_index = m_handle.frame_index;
+    if (frame_index.size == frame_index.reserved)
+        {
+        size_t new_reserved = std::max(frame_index.reserved * 2, size_t(1));
+        gsd_index_entry *data = (gsd_index_entry *)realloc(frame_index.data, sizeof(gsd_index_entry) * new_reserved);
+        if (data == NULL)
+            checkError(GSD_ERROR_MEMORY_ALLOCATION_FAILED);
+        memset(data + frame_index.reserved, 0, sizeof(gsd_index_entry) * (new_reserved - frame_index.reserved));
+        frame_index.data = data;
+        frame_index.reserved = new_reserved;
+        }
+
+    entry.N = N;
+    entry.location = m_handle.file_size;
+    frame_index.data[frame_index.size] = entry;
+    frame_index.size++;
+
+    m_handle.file_size += N * M * gsd_sizeof_type(type);
+    return entry.location;
+    }
+#endif
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -719,68 +1420,68 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, (void *)&bond.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
+        retval = writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, (void *)&bond.groups[0]);
         checkError(retval);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&angle.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
+        retval = writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, (void *)&angle.groups[0]);
         checkError(retval);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, (void *)&dihedral.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, (void *)&dihedral.groups[0]);
         checkError(retval);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, (void *)&improper.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
+        retval = writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, (void *)&improper.groups[0]);
         checkError(retval);
         }
 
@@ -788,7 +1489,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
@@ -798,12 +1499,12 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
+        retval = writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, (void *)&constraint.groups[0]);
         checkError(retval);
         }
 
@@ -811,17 +1512,17 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, (void *)&pair.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
+        retval = writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, (void *)&pair.groups[0]);
         checkError(retval);
         }
     }
@@ -899,7 +1600,7 @@ void GSDDumpWriter::writeUser(unsigned int timestep, bool root)
                 throw runtime_error("Invalid numpy dimension in gsd user-defined log data [" + item.first + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle, name.c_str(), type, arr.shape(0), M, 0, (void *)arr.data());
+            int retval = writeChunk(name.c_str(), type, arr.shape(0), M, (void *)arr.data());
             checkError(retval);
             }
         }
@@ -989,6 +1690,8 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setQueueDepth", &GSDDumpWriter::setQueueDepth)
+        .def("setNumWriters", &GSDDumpWriter::setNumWriters)
         .def_readwrite("user_log", &GSDDumpWriter::m_user_log)
     ;
     }
@@ -11,6 +11,11 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -31,6 +36,21 @@
     On the first call to analyze() \a fname is created with a dcd header. If it already
     exists, append to the file (unless the user specifies overwrite=True).
 
+    When the queue depth is set to a non-zero value with setQueueDepth(), the root rank copies each frame into one
+    of \a depth reusable buffers and a background thread writes it to the file while the simulation continues.
+    analyze() only blocks when all buffers are waiting to be written, so the queue depth caps the memory used.
+    flush() waits until all queued frames are in the file. System calls it at the end of every run(), and analyze()
+    calls it after writing each frame in truncate mode so that restart files are complete when it returns. Frames are
+    written synchronously when other classes have connected to the write signal, as the slots write directly to the
+    file handle.
+
+    In MPI simulations, setNumWriters() selects a distributed mode for the per-particle chunks. Instead of gathering a
+    snapshot on the root rank, each rank sends its particles to one of the writer ranks, which own contiguous row
+    ranges of every chunk, and the writers write their rows with MPI-IO to space that the root rank reserves in the
+    file with reserveChunk(). Topology, user log quantities, and slots are still written by the root rank. The root
+    rank syncs its writes before the collective writes, and the collective writes are synced before the root rank
+    ends the frame. Frames are not queued for the background writer in this mode.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -73,7 +93,26 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
-        hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
+        //! Set the number of frames that may be queued for the background writer thread
+        void setQueueDepth(unsigned int depth);
+
+        //! Wait until all queued frames are written to the file
+        virtual void flush();
+
+        //! Set the number of ranks that write per-particle data in MPI simulations (0 gathers to the root rank)
+        void setNumWriters(unsigned int n_writers)
+            {
+            m_n_writers = n_writers;
+            }
+
+        //! Get the signal emitted when writing a frame
+        /*! Slots write directly to the file handle, so frames are written synchronously once the signal is requested.
+        */
+        hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal()
+            {
+            m_write_slots = true;
+            return m_write_signal;
+            }
 
     private:
         std::string m_fname;                //!< The file name we are writing to
@@ -85,6 +124,13 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
         gsd_handle m_handle;                //!< Handle to the file
+        uint64_t m_nframes;                 //!< Number of frames in the file, including queued frames
+        bool m_write_slots;                 //!< True if slots may be connected to m_write_signal
+        unsigned int m_n_writers;           //!< Number of ranks writing per-particle data (0 gathers to root)
+        #ifdef ENABLE_MPI
+        MPI_File m_mpi_file;                //!< MPI-IO handle of the file, opened on the first distributed frame
+        bool m_mpi_file_open;               //!< True if m_mpi_file is open
+        #endif
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
@@ -92,6 +138,57 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        //! A data chunk buffered for the writer thread
+        struct BufferedChunk
+            {
+            std::string name;           //!< Name of the chunk
+            gsd_type type;              //!< Data type
+            uint64_t N;                 //!< Number of rows
+            uint32_t M;                 //!< Number of columns
+            std::vector<char> data;     //!< Chunk data
+            };
+
+        //! A frame buffered for the writer thread
+        struct BufferedFrame
+            {
+            bool truncate;                      //!< True if the file is truncated before writing the frame
+            unsigned int n_chunks;              //!< Number of chunks in the frame
+            std::vector<BufferedChunk> chunks;  //!< Chunk buffers (entries past n_chunks are kept for reuse)
+            };
+
+        unsigned int m_queue_depth;                             //!< Number of frame buffers (0 writes synchronously)
+        std::vector< std::unique_ptr<BufferedFrame> > m_frames; //!< Frame buffers
+        std::deque<BufferedFrame *> m_free_frames;              //!< Frame buffers available to analyze()
+        std::deque<BufferedFrame *> m_queued_frames;            //!< Frames waiting for the writer thread
+        BufferedFrame *m_cur_frame;                             //!< Frame being filled by analyze()
+        std::thread m_writer_thread;                            //!< Background writer thread
+        std::mutex m_queue_mutex;                               //!< Protects the queues and writer error state
+        std::condition_variable m_queue_cv;                     //!< Signals changes to the queues
+        bool m_writer_stop;                                     //!< Set to stop the writer thread
+        int m_writer_retval;                                    //!< First error returned to the writer thread
+        int m_writer_errno;                                     //!< errno at the time of m_writer_retval
+
+        //! Write a data chunk to the file, or buffer it when writing in the background
+        int writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data);
+
+        //! Acquire a buffer for the next frame, starting the writer thread if needed
+        void beginBufferedFrame();
+
+        //! Queue the current frame for the writer thread
+        void queueBufferedFrame();
+
+        //! Write queued frames in the background
+        void writerThread();
+
+        //! Write one buffered frame to the file
+        int writeBufferedFrame(const BufferedFrame& frame);
+
+        //! Stop the writer thread and free the frame buffers
+        void stopWriterThread();
+
+        //! Raise errors that occurred on the writer thread
+        void checkWriterError();
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -110,6 +207,14 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write particle momenta
         void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
 
+        #ifdef ENABLE_MPI
+        //! Write the per-particle chunks from the writer ranks without gathering a snapshot
+        void writeParticlesDistributed(uint64_t nframes);
+
+        //! Add a chunk to the current frame and reserve space for its data at the end of the file
+        uint64_t reserveChunk(const char *name, gsd_type type, uint64_t N, uint32_t M);
+        #endif
+
         //! Write bond topology
         void writeTopology(BondData::Snapshot& bond,
                            AngleData::Snapshot& angle,
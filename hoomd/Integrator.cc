@@ -38,7 +38,10 @@ Integrator::~Integrator()
     if (m_request_flags_connected && m_comm)
         m_comm->getCommFlagsRequestSignal().disconnect<Integrator, &Integrator::determineFlags>(this);
     if (m_signals_connected && m_comm)
+        {
         m_comm->getComputeCallbackSignal().disconnect<Integrator, &Integrator::computeCallback>(this);
+        m_comm->getComputeTimeSignal().disconnect<Integrator, &Integrator::getComputeTime>(this);
+        }
     #endif
     }
 
@@ -310,9 +313,29 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
 void Integrator::computeNetForce(unsigned int timestep)
     {
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
+
+    #ifdef ENABLE_MPI
+    if (m_comm && m_comm->isGhostUpdatePending())
+        {
+        int64_t start_time = m_compute_clk.getTime();
+
+        // compute the forces that do not depend on ghost particles while the ghost update is in flight
+        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+            (*force_compute)->computeInterior(timestep);
+
+        m_compute_time += double(m_compute_clk.getTime() - start_time)/1e9;
+
+        m_comm->finishUpdateGhosts(timestep);
+        }
+    #endif
+
+    int64_t start_time = m_compute_clk.getTime();
+
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         (*force_compute)->compute(timestep);
 
+    m_compute_time += double(m_compute_clk.getTime() - start_time)/1e9;
+
     if (m_prof)
         {
         m_prof->push("Integrate");
@@ -503,9 +526,13 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
 
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
 
+    int64_t start_time = m_compute_clk.getTime();
+
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         (*force_compute)->compute(timestep);
 
+    m_compute_time += double(m_compute_clk.getTime() - start_time)/1e9;
+
     if (m_prof)
         {
         m_prof->push(m_exec_conf, "Integrate");
@@ -904,7 +931,10 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
     m_request_flags_connected = true;
 
     if (! m_signals_connected && m_comm)
+        {
         comm->getComputeCallbackSignal().connect<Integrator, &Integrator::computeCallback>(this);
+        comm->getComputeTimeSignal().connect<Integrator, &Integrator::getComputeTime>(this);
+        }
 
     m_signals_connected = true;
     }
@@ -20,6 +20,7 @@
 #include "ForceConstraint.h"
 #include "HalfStepHook.h"
 #include "ParticleGroup.h"
+#include "ClockSource.h"
 #include <string>
 #include <vector>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -129,6 +130,14 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Get the time this rank has spent computing forces (or trial moves)
+        /*! \returns The accumulated wall-clock time in seconds
+        */
+        double getComputeTime()
+            {
+            return m_compute_time;
+            }
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -147,6 +156,9 @@ class PYBIND11_EXPORT Integrator : public Updater
 
         std::shared_ptr<HalfStepHook> m_half_step_hook;    //!< The HalfStepHook, if active
 
+        ClockSource m_compute_clk;                                  //!< Clock for measuring the compute time
+        double m_compute_time = 0.0;                                //!< Accumulated compute time in seconds
+
 
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
@@ -161,7 +173,7 @@ class PYBIND11_EXPORT Integrator : public Updater
 
 #ifdef ENABLE_MPI
         //! helper function to determine the ghost communication flags
-        CommFlags determineFlags(unsigned int timestep);
+        virtual CommFlags determineFlags(unsigned int timestep);
 #endif
 
         //! Helper function to determine (an-)isotropic integration mode
@@ -33,7 +33,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
         : Updater(sysdef), m_decomposition(decomposition), m_mpi_comm(m_exec_conf->getMPICommunicator()),
           m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
           m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-          m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
+          m_weight_by_time(false), m_smoothing(Scalar(0.5)), m_cost(Scalar(0.0)), m_weight(Scalar(1.0)),
+          m_total_load(Scalar(m_pdata->getNGlobal())), m_has_compute_time(false), m_last_compute_time(0.0),
+          m_last_timestep(0), m_N_own(m_pdata->getN()), m_load_own(Scalar(m_pdata->getN())), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
           m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
@@ -63,6 +65,9 @@ void LoadBalancer::update(unsigned int timestep)
 
     if (m_prof) m_prof->push(m_exec_conf, "balance");
 
+    // measure the cost of the particles since the last call
+    updateWeight(timestep);
+
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
 
@@ -112,7 +117,7 @@ void LoadBalancer::update(unsigned int timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> N_i;
             bool adjusted = false;
 
             // reduce the number of particles in the slice along dim
@@ -154,13 +159,64 @@ void LoadBalancer::update(unsigned int timestep)
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * \param timestep Current time step of the simulation
+ *
+ * When weighting by time, the compute time reported through Communicator::getComputeTimeSignal() since the last call
+ * is divided by the number of steps and particles, and the resulting cost per particle is smoothed with an exponential
+ * moving average so that the domain boundaries do not oscillate due to noise in the timings. Ranks without a
+ * measurement (e.g. on the first call, or without particles) use the average cost of all other ranks. If no rank has a
+ * measurement yet, all particles have unit weight and the balancing is by number of particles.
+ *
+ * \note All ranks must participate in this call since it involves collective operations.
+ */
+void LoadBalancer::updateWeight(unsigned int timestep)
+    {
+    if (!m_weight_by_time)
+        {
+        m_weight = Scalar(1.0);
+        m_total_load = Scalar(m_pdata->getNGlobal());
+        return;
+        }
+
+    // sum up the compute time of all subscribers
+    double compute_time = 0.0;
+    m_comm->getComputeTimeSignal().emit_accumulate([&](double t) { compute_time += t; });
+
+    const unsigned int N = m_pdata->getN();
+    if (m_has_compute_time && timestep > m_last_timestep && N > 0)
+        {
+        Scalar cost = Scalar((compute_time - m_last_compute_time) / double(timestep - m_last_timestep)) / Scalar(N);
+        if (cost > Scalar(0.0))
+            m_cost = (m_cost > Scalar(0.0)) ? m_smoothing*m_cost + (Scalar(1.0) - m_smoothing)*cost : cost;
+        }
+    m_last_compute_time = compute_time;
+    m_last_timestep = timestep;
+    m_has_compute_time = true;
+
+    // average cost over the ranks that have a measurement
+    Scalar cost_sum[2] = {m_cost, (m_cost > Scalar(0.0)) ? Scalar(1.0) : Scalar(0.0)};
+    MPI_Allreduce(MPI_IN_PLACE, cost_sum, 2, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+
+    if (cost_sum[1] == Scalar(0.0))
+        m_weight = Scalar(1.0);
+    else if (m_cost > Scalar(0.0))
+        m_weight = m_cost;
+    else
+        m_weight = cost_sum[0] / cost_sum[1];
+
+    Scalar load = m_weight * Scalar(N);
+    MPI_Allreduce(&load, &m_total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+    }
+
+/*!
+ * Computes the imbalance factor I = L / <L> of the load L (number of particles, or weighted by time) for each rank,
+ * and computes the maximum among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_imb = getLoadOwn() / (m_total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -175,12 +231,12 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param N_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
  * \returns true if the current rank holds the active \a N_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a N_i holds the load (number of particles, or weighted by time) in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for efficiency the data will
  *       be active only on Cartesian rank \a reduce_root, as indicated by the return value. As a result, only \a reduce_root
@@ -191,18 +247,18 @@ Scalar LoadBalancer::getMaxImbalance()
  * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
  * optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
     if (N_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> N_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the particles the current rank owns (the quantity to be reduced)
+    Scalar N_own = getLoadOwn();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&N_own, 1, MPI_HOOMD_SCALAR, &N_per_rank[0], 1, MPI_HOOMD_SCALAR, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -210,7 +266,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
     // rearrange the data from ranks to cartesian order in case it is jumbled around
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> N_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
         {
         N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
@@ -222,7 +278,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getW());
         for (unsigned int i=0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            N_i[i] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int j=0; j < di.getH(); ++j)
@@ -237,7 +293,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getH());
         for (unsigned int j=0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            N_i[j] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
@@ -252,7 +308,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getD());
         for (unsigned int k=0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            N_i[k] = Scalar(0.0);
             for (unsigned int j=0; j < di.getH(); ++j)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
@@ -273,7 +329,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param N_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -291,15 +347,15 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& N_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const Scalar target = m_total_load / Scalar(N_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -313,8 +369,8 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     vector<Scalar> new_widths(N_i.size());
     for (unsigned int i=0; i < N_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
-        Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
+        const Scalar imb_factor = N_i[i] / target;
+        Scalar scale_factor = (N_i[i] > Scalar(0.0)) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated systems
@@ -496,7 +552,8 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
 /*!
  * Each rank calls countParticlesOffRank() to count the number of particles to send to other ranks. Neighboring ranks
  * then perform send/receive calls, and count the new number of particles they own as the number they owned locally
- * plus the number received minus the number sent.
+ * plus the number received minus the number sent. When weighting by time, the neighbors also exchange their particle
+ * weights, and received particles contribute to the load with the weight of the rank that sent them.
  *
  * \note All ranks must participate in this call since it involves send/receive operations between neighboring domains.
  */
@@ -516,12 +573,13 @@ void LoadBalancer::computeOwnedParticles()
         }
     countParticlesOffRank(cnts);
 
-    MPI_Request req[2*m_comm->getNUniqueNeighbors()];
-    MPI_Status stat[2*m_comm->getNUniqueNeighbors()];
+    MPI_Request req[4*m_comm->getNUniqueNeighbors()];
+    MPI_Status stat[4*m_comm->getNUniqueNeighbors()];
     unsigned int nreq = 0;
 
     unsigned int n_send_ptls[m_comm->getNUniqueNeighbors()];
     unsigned int n_recv_ptls[m_comm->getNUniqueNeighbors()];
+    Scalar recv_weight[m_comm->getNUniqueNeighbors()];
     for (unsigned int cur_neigh=0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
@@ -529,19 +587,31 @@ void LoadBalancer::computeOwnedParticles()
 
         MPI_Isend(&n_send_ptls[cur_neigh], 1, MPI_UNSIGNED, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
         MPI_Irecv(&n_recv_ptls[cur_neigh], 1, MPI_UNSIGNED, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
+
+        recv_weight[cur_neigh] = Scalar(1.0);
+        if (m_weight_by_time)
+            {
+            MPI_Isend(&m_weight, 1, MPI_HOOMD_SCALAR, neigh_rank, 1, m_mpi_comm, & req[nreq++]);
+            MPI_Irecv(&recv_weight[cur_neigh], 1, MPI_HOOMD_SCALAR, neigh_rank, 1, m_mpi_comm, & req[nreq++]);
+            }
         }
     MPI_Waitall(nreq, req, stat);
 
     // reduce the particles sent to me
     int N_own = m_pdata->getN();
+    Scalar load_own = m_weight * Scalar(m_pdata->getN());
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         N_own += n_recv_ptls[cur_neigh];
         N_own -= n_send_ptls[cur_neigh];
+
+        load_own += recv_weight[cur_neigh] * Scalar(n_recv_ptls[cur_neigh]);
+        load_own -= m_weight * Scalar(n_send_ptls[cur_neigh]);
         }
 
     // set the count
     resetNOwn(N_own);
+    m_load_own = load_own;
     }
 
 /*!
@@ -578,6 +648,10 @@ void export_LoadBalancer(py::module& m)
     .def("setTolerance", &LoadBalancer::setTolerance)
     .def("getMaxIterations", &LoadBalancer::getMaxIterations)
     .def("setMaxIterations", &LoadBalancer::setMaxIterations)
+    .def("getWeightByTime", &LoadBalancer::getWeightByTime)
+    .def("setWeightByTime", &LoadBalancer::setWeightByTime)
+    .def("getSmoothing", &LoadBalancer::getSmoothing)
+    .def("setSmoothing", &LoadBalancer::setSmoothing)
     ;
     }
 #endif // ENABLE_MPI
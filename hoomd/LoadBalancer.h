@@ -41,6 +41,11 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * Optionally, the load of a rank is measured by the time it spends computing rather than by its number of particles.
+ * Every particle is weighted by the compute time per particle and step of the rank that owns it, which is measured
+ * between balancing steps and smoothed with an exponential moving average. The compute time is reported by the
+ * subscribers to Communicator::getComputeTimeSignal().
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Updater
@@ -83,6 +88,43 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
             m_maxiter = maxiter;
             }
 
+        //! Get whether particles are weighted by the measured compute time
+        bool getWeightByTime() const
+            {
+            return m_weight_by_time;
+            }
+
+        //! Set whether particles are weighted by the measured compute time
+        /*!
+         * \param enable If true, balance the compute time instead of the number of particles
+         */
+        void setWeightByTime(bool enable)
+            {
+            m_weight_by_time = enable;
+            m_cost = Scalar(0.0);
+            m_has_compute_time = false;
+            }
+
+        //! Get the smoothing factor of the measured compute time
+        Scalar getSmoothing() const
+            {
+            return m_smoothing;
+            }
+
+        //! Set the smoothing factor of the measured compute time
+        /*!
+         * \param smoothing Weight of the previous measurements in the moving average (0 <= smoothing < 1)
+         */
+        void setSmoothing(Scalar smoothing)
+            {
+            if (smoothing < Scalar(0.0) || smoothing >= Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "comm.balance: smoothing must be in [0,1)" << std::endl;
+                throw std::runtime_error("comm.balance: smoothing must be in [0,1)");
+                }
+            m_smoothing = smoothing;
+            }
+
         //! Enable / disable load balancing along a dimension
         /*!
          * \param dim Dimension along which to balance
@@ -119,8 +161,8 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+        //! Reduce the load per rank down to one dimension
+        bool reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root);
 
         //! Set flags within the class that a resize has been performed
         void signalResize()
@@ -132,7 +174,7 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& N_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
@@ -150,6 +192,13 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
             return m_N_own;
             }
 
+        //! Gets the load of the owned particles, updating if necessary
+        Scalar getLoadOwn()
+            {
+            computeOwnedParticles();
+            return m_load_own;
+            }
+
         //! Force a reset of the number of owned particles without counting
         /*!
          * \param N number of particles owned by the rank
@@ -157,9 +206,13 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         void resetNOwn(unsigned int N)
             {
             m_N_own = N;
+            m_load_own = m_weight * Scalar(N);
             m_recompute_max_imbalance = true;
             m_needs_recount = false;
             }
+
+        //! Measure the compute time and update the particle weight of this rank
+        void updateWeight(unsigned int timestep);
         bool m_needs_recount;   //!< Flag if a particle change needs to be computed
 
         Scalar m_tolerance;     //!< Load imbalance to tolerate
@@ -170,8 +223,18 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         const Scalar m_max_scale;   //!< Maximum fraction to rescale either direction (5%)
 
+        bool m_weight_by_time;      //!< Flag to weight particles by the measured compute time
+        Scalar m_smoothing;         //!< Weight of the previous measurements in the moving average
+        Scalar m_cost;              //!< Smoothed compute time per particle and step (0 if not measured)
+        Scalar m_weight;            //!< Weight of the particles owned by this rank
+        Scalar m_total_load;        //!< Sum of the load over all ranks
+        bool m_has_compute_time;    //!< True if a previous compute time has been recorded
+        double m_last_compute_time; //!< Compute time at the last balancing step
+        unsigned int m_last_timestep;   //!< Time step of the last balancing step
+
     private:
         unsigned int m_N_own;               //!< Number of particles owned by this rank
+        Scalar m_load_own;                  //!< Load of the particles owned by this rank
 
         Scalar m_max_max_imbalance;     //!< The maximum imbalance of any check
         double m_total_max_imbalance;   //!< The average imbalance over checks
@@ -0,0 +1,378 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBinary.cc
+    \brief Defines the LogBinary class
+*/
+
+#include "LogBinary.h"
+#include "Filesystem.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+#include <stdexcept>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace py = pybind11;
+using namespace std;
+
+//! Version of the file format
+const uint64_t log_binary_version = 1;
+//! Chunks are padded to a multiple of this size
+const uint64_t log_binary_alignment = 4096;
+//! Size of the chunk header: tag, chunk size, count
+const uint64_t log_binary_header_bytes = 24;
+//! Byte order mark written to the first chunk
+const uint64_t log_binary_byte_order = 0x0102030405060708ULL;
+
+/*! \param sysdef System definition
+    \param fname File name to write the log to
+    \param overwrite Will overwrite an existing file if true (default is to append)
+    \param block_records Number of records written to the file at once
+*/
+LogBinary::LogBinary(std::shared_ptr<SystemDefinition> sysdef,
+                     const std::string& fname,
+                     bool overwrite,
+                     unsigned int block_records)
+    : Logger(sysdef), m_filename(fname), m_appending(!overwrite), m_block_records(1), m_is_initialized(false),
+      m_columns_written(false), m_num_pending(0), m_num_records(0), m_file_size(0), m_index_bytes(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LogBinary: " << fname << " " << overwrite << " " << block_records << endl;
+    setBlockRecords(block_records);
+    }
+
+LogBinary::~LogBinary()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LogBinary" << endl;
+
+    if (m_is_initialized)
+        {
+        // never throw from the destructor, the file is readable without the index
+        try
+            {
+            writeBlock();
+            writeIndex();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->warning() << "analyze.log_binary: " << e.what() << endl;
+            }
+        m_file.close();
+        }
+    }
+
+/*! \param block_records Number of records written to the file at once
+*/
+void LogBinary::setBlockRecords(unsigned int block_records)
+    {
+    if (block_records == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: The number of records per block must be positive" << endl;
+        throw runtime_error("Error setting LogBinary parameters");
+        }
+    m_block_records = block_records;
+    }
+
+/*! \returns True if this rank writes the file
+*/
+bool LogBinary::isWriter() const
+    {
+#ifdef ENABLE_MPI
+    // only output to file on root processor
+    if (m_pdata->getDomainDecomposition())
+        return m_exec_conf->isRoot();
+#endif
+    return true;
+    }
+
+/*! \returns Size of the valid part of the existing file
+
+    Reads the chunk headers from the start of the file. The scan stops at the index, at the first incomplete or
+    unknown chunk, or at the end of the file. The column and data chunks found on the way are added to the index.
+    A non-empty file that does not start with a valid HOOMDLOG chunk is an error, so it is never truncated.
+*/
+uint64_t LogBinary::scanExistingFile()
+    {
+    ifstream in(m_filename.c_str(), ios_base::in | ios_base::binary);
+    in.seekg(0, ios_base::end);
+    const uint64_t file_size = in.tellg();
+    in.seekg(0, ios_base::beg);
+
+    // an empty file is started from scratch
+    if (file_size == 0)
+        return 0;
+
+    // any other file must start with a complete HOOMDLOG chunk, otherwise it is left untouched
+    char tag[8] = {0};
+    uint64_t chunk_bytes = 0, count = 0, byte_order = 0;
+    in.read(tag, 8);
+    in.read((char *)&chunk_bytes, sizeof(uint64_t));
+    in.read((char *)&count, sizeof(uint64_t));
+    in.read((char *)&byte_order, sizeof(uint64_t));
+    if (!in.good() || file_size < log_binary_alignment || strncmp(tag, "HOOMDLOG", 8) != 0
+        || chunk_bytes != log_binary_alignment || count != log_binary_version || byte_order != log_binary_byte_order)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: " << m_filename
+                                  << " is not a binary log that can be appended to" << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    uint64_t offset = log_binary_alignment;
+    uint64_t record_bytes = sizeof(uint64_t);
+    while (offset + log_binary_header_bytes <= file_size)
+        {
+        in.seekg(offset);
+        in.read(tag, 8);
+        in.read((char *)&chunk_bytes, sizeof(uint64_t));
+        in.read((char *)&count, sizeof(uint64_t));
+        if (!in.good() || chunk_bytes < log_binary_header_bytes || chunk_bytes % log_binary_alignment != 0
+            || offset + chunk_bytes > file_size)
+            break;
+
+        if (strncmp(tag, "HLOGCOLS", 8) == 0)
+            {
+            record_bytes = sizeof(uint64_t) + count*sizeof(double);
+            m_chunk_offsets.push_back(offset);
+            }
+        else if (strncmp(tag, "HLOGDATA", 8) == 0)
+            {
+            if (log_binary_header_bytes + count*record_bytes > chunk_bytes)
+                break;
+            m_num_records += count;
+            m_chunk_offsets.push_back(offset);
+            }
+        else
+            {
+            // the index, or an unknown chunk
+            break;
+            }
+
+        offset += chunk_bytes;
+        }
+
+    return offset;
+    }
+
+void LogBinary::openOutputFile()
+    {
+    if (filesystem::exists(m_filename) && m_appending)
+        {
+        m_exec_conf->msg->notice(3) << "analyze.log_binary: Appending log to existing file \"" << m_filename << "\"" << endl;
+
+        // drop the index and an incomplete chunk left by a crash, they are written again
+        m_file_size = scanExistingFile();
+        if (truncate(m_filename.c_str(), m_file_size) != 0)
+            {
+            m_exec_conf->msg->error() << "analyze.log_binary: Error truncating log file " << m_filename << endl;
+            throw runtime_error("Error initializing LogBinary");
+            }
+        m_file.open(m_filename.c_str(), ios_base::in | ios_base::out | ios_base::binary);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "analyze.log_binary: Creating new log in file \"" << m_filename << "\"" << endl;
+        m_file.open(m_filename.c_str(), ios_base::out | ios_base::trunc | ios_base::binary);
+        m_appending = false;
+        m_file_size = 0;
+        }
+    m_index_bytes = 0;
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: Error opening log file " << m_filename << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    if (m_file_size == 0)
+        {
+        writeChunk("HOOMDLOG", log_binary_version, (const char *)&log_binary_byte_order, sizeof(uint64_t));
+        }
+    }
+
+/*! Compares the size of the file on disk to the size written by this logger. Throws if another logger has
+    truncated, replaced or appended to the file since the last write.
+*/
+void LogBinary::checkFileSize()
+    {
+    struct stat buffer;
+    if (stat(m_filename.c_str(), &buffer) != 0 || uint64_t(buffer.st_size) != m_file_size + m_index_bytes)
+        {
+        throw runtime_error("Log file " + m_filename + " was modified by another writer, not writing to it");
+        }
+    }
+
+/*! \param tag Tag of the chunk (8 characters)
+    \param count Count stored in the header
+    \param payload Payload of the chunk
+    \param payload_bytes Size of the payload in bytes
+    \returns The size of the chunk in bytes
+
+    The header, the payload and the padding are written with a single call. An index at the end of the file is
+    removed first, so the new chunk follows the last column or data chunk.
+*/
+uint64_t LogBinary::writeChunk(const char *tag, uint64_t count, const char *payload, uint64_t payload_bytes)
+    {
+    checkFileSize();
+
+    if (m_index_bytes > 0)
+        {
+        if (truncate(m_filename.c_str(), m_file_size) != 0)
+            {
+            m_exec_conf->msg->error() << "analyze.log_binary: Error truncating log file " << m_filename << endl;
+            throw runtime_error("Error writing log file");
+            }
+        m_index_bytes = 0;
+        }
+
+    uint64_t chunk_bytes = log_binary_header_bytes + payload_bytes;
+    chunk_bytes = ((chunk_bytes + log_binary_alignment - 1) / log_binary_alignment) * log_binary_alignment;
+
+    std::vector<char> chunk(chunk_bytes, 0);
+    memcpy(&chunk[0], tag, 8);
+    memcpy(&chunk[8], &chunk_bytes, sizeof(uint64_t));
+    memcpy(&chunk[16], &count, sizeof(uint64_t));
+    if (payload_bytes > 0)
+        memcpy(&chunk[log_binary_header_bytes], payload, payload_bytes);
+
+    m_file.seekp(m_file_size);
+    m_file.write(&chunk[0], chunk_bytes);
+    m_file.flush();
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: I/O error while writing log file" << endl;
+        throw runtime_error("Error writing log file");
+        }
+
+    m_file_size += chunk_bytes;
+    return chunk_bytes;
+    }
+
+void LogBinary::writeBlock()
+    {
+    if (m_num_pending == 0)
+        return;
+
+    m_chunk_offsets.push_back(m_file_size);
+    writeChunk("HLOGDATA", m_num_pending, &m_block[0], m_block.size());
+    m_num_records += m_num_pending;
+
+    m_block.clear();
+    m_num_pending = 0;
+    }
+
+/*! The index is only written if it is not already at the end of the file. It does not count towards
+    m_file_size, so the next chunk replaces it.
+*/
+void LogBinary::writeIndex()
+    {
+    if (m_index_bytes > 0)
+        return;
+
+    std::vector<uint64_t> index;
+    index.reserve(m_chunk_offsets.size() + 1);
+    index.push_back(m_num_records);
+    index.insert(index.end(), m_chunk_offsets.begin(), m_chunk_offsets.end());
+
+    const uint64_t index_bytes = writeChunk("HLOGINDX", m_chunk_offsets.size(), (const char *)&index[0],
+                                            index.size()*sizeof(uint64_t));
+    m_file_size -= index_bytes;
+    m_index_bytes = index_bytes;
+    }
+
+/*! \param quantities A list of quantities to log
+
+    Pending records of the previous quantities are written first. The new column names are written before the
+    next record.
+*/
+void LogBinary::setLoggedQuantities(const std::vector< std::string >& quantities)
+    {
+    if (m_is_initialized)
+        writeBlock();
+
+    Logger::setLoggedQuantities(quantities);
+    m_columns_written = false;
+
+    if (quantities.size() == 0)
+        {
+        m_exec_conf->msg->warning() << "analyze.log_binary: No quantities specified for logging" << endl;
+        }
+    }
+
+/*! \param timestep Time step to write out data for
+
+    Appends a record with the cached values to the pending block, and writes the block when it is full.
+*/
+void LogBinary::analyze(unsigned int timestep)
+    {
+    //Call the base class to cache all values.
+    Logger::analyze(timestep);
+
+    if (!isWriter())
+        return;
+
+    if (m_prof) m_prof->push("LogBinary");
+
+    if (!m_is_initialized)
+        {
+        openOutputFile();
+        m_is_initialized = true;
+        }
+
+    if (!m_columns_written)
+        {
+        std::string names;
+        for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+            {
+            names += m_logged_quantities[i];
+            names.push_back('\0');
+            }
+        m_chunk_offsets.push_back(m_file_size);
+        writeChunk("HLOGCOLS", m_logged_quantities.size(), names.data(), names.size());
+        m_columns_written = true;
+        }
+
+    // append the record
+    const uint64_t step = timestep;
+    const unsigned int record_bytes = sizeof(uint64_t) + m_logged_quantities.size()*sizeof(double);
+    if (m_block.capacity() < m_block_records*record_bytes)
+        m_block.reserve(m_block_records*record_bytes);
+
+    const size_t start = m_block.size();
+    m_block.resize(start + record_bytes);
+    memcpy(&m_block[start], &step, sizeof(uint64_t));
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        const double value = m_cached_quantities[i];
+        memcpy(&m_block[start + sizeof(uint64_t) + i*sizeof(double)], &value, sizeof(double));
+        }
+    m_num_pending++;
+
+    if (m_num_pending >= m_block_records)
+        writeBlock();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! Called by System at the end of every run, so that the file is complete and indexed while the script continues.
+*/
+void LogBinary::flush()
+    {
+    if (m_is_initialized)
+        {
+        writeBlock();
+        writeIndex();
+        }
+    }
+
+void export_LogBinary(py::module& m)
+    {
+    py::class_<LogBinary, std::shared_ptr<LogBinary> >(m,"LogBinary", py::base<Logger>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string&, bool, unsigned int >())
+    .def("setBlockRecords", &LogBinary::setBlockRecords)
+    ;
+    }
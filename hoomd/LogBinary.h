@@ -0,0 +1,114 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBinary.h
+    \brief Declares the LogBinary class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Logger.h"
+
+#include <stdint.h>
+
+#ifndef __LOGBINARY_H__
+#define __LOGBINARY_H__
+
+//! Logs registered quantities to a binary file in large blocks
+/*! LogBinary writes the values cached by Logger as fixed width records: the timestep as a 64-bit unsigned integer,
+    followed by one double per logged quantity. Records are collected in memory and written in one block every
+    \a block_records records, when a run ends (flush()), and when the logger is destroyed.
+
+    The file is a sequence of chunks. Every chunk starts with a 24 byte header: an 8 character tag, the size of
+    the chunk in bytes (including the header and padding), and a count. Chunks are padded with zeros to a multiple
+    of 4096 bytes, so that every write to the file is large and aligned. All numbers are stored in the byte order
+    of the writing machine, which is recorded in the first chunk.
+
+     - \c HOOMDLOG starts the file. The count is the format version, the payload is the 64-bit byte order mark
+       0x0102030405060708.
+     - \c HLOGCOLS lists the names of the columns. The count is the number of columns, the payload are the names,
+       each terminated by a null character. The following records have these columns, until the next
+       \c HLOGCOLS chunk.
+     - \c HLOGDATA holds the records. The count is the number of records.
+     - \c HLOGINDX is written at the end of every run and when the logger is closed. The count is the number of
+       indexed chunks, the payload is the total number of records followed by the offsets of all \c HLOGCOLS and
+       \c HLOGDATA chunks. The index is removed again before the next chunk is written.
+
+    Before every write, the size of the file is compared to the size this logger has written. If they differ,
+    another logger has written to the same file in the meantime, and nothing is written, so that a stale logger
+    cannot overwrite the chunks or the index of the new one.
+
+    A file that does not end with \c HLOGINDX was not closed cleanly. All chunks before an incomplete chunk are
+    still valid. When appending to an existing file, the incomplete chunk and the index are removed first.
+
+    As in LogPlainTXT, only the root rank writes the file in MPI simulations.
+
+    \ingroup analyzers
+*/
+class LogBinary : public Logger
+    {
+    public:
+        //! Constructs a logger
+        LogBinary(std::shared_ptr<SystemDefinition> sysdef,
+                  const std::string& fname,
+                  bool overwrite=false,
+                  unsigned int block_records=1000);
+
+        //! Destructor
+        ~LogBinary();
+
+        //! Selects which quantities to log
+        virtual void setLoggedQuantities(const std::vector< std::string >& quantities);
+
+        //! Set the number of records written in one block
+        void setBlockRecords(unsigned int block_records);
+
+        //! Add a record for the current timestep
+        void analyze(unsigned int timestep);
+
+        //! Write all pending records to the file
+        virtual void flush();
+
+    private:
+        std::string m_filename;             //!< The output file name
+        bool m_appending;                   //!< True if an existing file is appended to
+        unsigned int m_block_records;       //!< Number of records per block
+        std::ofstream m_file;               //!< The file we write out to
+        bool m_is_initialized;              //!< True if the output file is open
+        bool m_columns_written;             //!< True if the current columns have been written to the file
+
+        std::vector<char> m_block;          //!< Pending records
+        unsigned int m_num_pending;         //!< Number of pending records
+        uint64_t m_num_records;             //!< Number of records written to the file
+        uint64_t m_file_size;               //!< Current size of the file in bytes, without the index
+        uint64_t m_index_bytes;             //!< Size of the index at the end of the file (0 if there is none)
+        std::vector<uint64_t> m_chunk_offsets;  //!< Offsets of all column and data chunks in the file
+
+        //! Open the output file
+        void openOutputFile();
+
+        //! Find the end of the last complete chunk in an existing file
+        uint64_t scanExistingFile();
+
+        //! Write a single chunk
+        uint64_t writeChunk(const char *tag, uint64_t count, const char *payload, uint64_t payload_bytes);
+
+        //! Check that no other writer has changed the file
+        void checkFileSize();
+
+        //! Write the pending records
+        void writeBlock();
+
+        //! Write the index of all chunks
+        void writeIndex();
+
+        //! Check if this rank writes the file
+        bool isWriter() const;
+    };
+
+//! Exports the LogBinary class to python
+void export_LogBinary(pybind11::module& m);
+
+#endif
@@ -50,7 +50,7 @@ void LogHDF5::analyze(unsigned int timestep)
     //Prepare non-matrix data in a single array.
     for(unsigned int i=0; i < m_logged_quantities.size(); i++)
         {
-        numpy_array_data[i] = this->getQuantity(m_logged_quantities[i],timestep,true);
+        numpy_array_data[i] = m_cached_quantities[i];
         }
 
     //Call the python function, which manages the prepared data and writes it to disk.
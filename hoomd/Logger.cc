@@ -17,6 +17,7 @@
 
 namespace py = pybind11;
 
+#include <algorithm>
 #include <stdexcept>
 #include <iomanip>
 using namespace std;
@@ -24,7 +25,7 @@ using namespace std;
 /*! \param sysdef Specified for Analyzer, but not used directly by Logger
 */
 Logger::Logger(std::shared_ptr<SystemDefinition> sysdef)
-    : Analyzer(sysdef)
+    : Analyzer(sysdef), m_cached_timestep(-1), m_sources_stale(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing Logger: " << endl;
     }
@@ -62,6 +63,7 @@ void Logger::registerCompute(std::shared_ptr<Compute> compute)
         m_compute_quantities[provided_quantities[i]] = compute;
         m_exec_conf->msg->notice(6) << "analyze.log: Registering log quantity " << provided_quantities[i] << endl;
         }
+    m_sources_stale = true;
     }
 
 /*! \param updater The Updater to register
@@ -86,6 +88,7 @@ void Logger::registerUpdater(std::shared_ptr<Updater> updater)
         m_updater_quantities[provided_quantities[i]] = updater;
         m_exec_conf->msg->notice(6) << "analyze.log: Registering log quantity " << provided_quantities[i] << endl;
         }
+    m_sources_stale = true;
     }
 
 /*! \param name Name of the quantity
@@ -106,6 +109,7 @@ void Logger::registerCallback(std::string name, pybind11::handle callback)
 
     pybind11::handle(callback).inc_ref(); // increase the reference count on this handle while we hold it
     m_callback_quantities[name] = callback.ptr();
+    m_sources_stale = true;
     }
 
 /*! After calling removeAll(), no quantities are registered for logging
@@ -117,6 +121,7 @@ void Logger::removeAll()
     //The callbacks are intentionally not cleared, because before each
     //run all compute and updaters should be cleared, but the python
     //callbacks should not be cleared for this.
+    m_sources_stale = true;
     }
 
 /*! \param quantities A list of quantities to log
@@ -131,6 +136,82 @@ void Logger::setLoggedQuantities(const std::vector< std::string >& quantities)
     // prepare or adjust storage for caching the logger properties.
     m_cached_timestep = -1;
     m_cached_quantities.resize(quantities.size());
+
+    m_quantity_index.clear();
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        // the first occurrence of a quantity is returned by getQuantity()
+        m_quantity_index.insert(std::make_pair(m_logged_quantities[i], i));
+        }
+    m_sources_stale = true;
+    }
+
+/*! Looks up the source of every logged quantity, and lists every compute that provides one of them once.
+    Unregistered quantities are reported here, and are logged as 0.
+*/
+void Logger::resolveQuantities()
+    {
+    m_quantity_sources.resize(m_logged_quantities.size());
+    m_logged_computes.clear();
+
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        const std::string& quantity = m_logged_quantities[i];
+        QuantitySource& source = m_quantity_sources[i];
+        source.comp = NULL;
+        source.updater = NULL;
+        source.callback = NULL;
+
+        // same precedence as the registration maps
+        auto compute_it = m_compute_quantities.find(quantity);
+        auto updater_it = m_updater_quantities.find(quantity);
+        auto callback_it = m_callback_quantities.find(quantity);
+        if (quantity == "time")
+            {
+            source.type = QuantitySource::clock_time;
+            }
+        else if (compute_it != m_compute_quantities.end())
+            {
+            source.type = QuantitySource::from_compute;
+            source.comp = compute_it->second.get();
+            if (std::find(m_logged_computes.begin(), m_logged_computes.end(), source.comp) == m_logged_computes.end())
+                m_logged_computes.push_back(source.comp);
+            }
+        else if (updater_it != m_updater_quantities.end())
+            {
+            source.type = QuantitySource::from_updater;
+            source.updater = updater_it->second.get();
+            }
+        else if (callback_it != m_callback_quantities.end())
+            {
+            source.type = QuantitySource::from_callback;
+            source.callback = callback_it->second;
+            }
+        else
+            {
+            source.type = QuantitySource::unregistered;
+            m_exec_conf->msg->warning() << "analyze.log: Log quantity " << quantity << " is not registered, logging a value of 0" << endl;
+            }
+        }
+
+    m_sources_stale = false;
+    }
+
+/*! \param timestep Time step to compute the values for
+*/
+void Logger::updateCachedQuantities(unsigned int timestep)
+    {
+    if (m_sources_stale)
+        resolveQuantities();
+
+    // update every compute once, even if it provides several quantities
+    for (unsigned int i = 0; i < m_logged_computes.size(); i++)
+        m_logged_computes[i]->compute(timestep);
+
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        m_cached_quantities[i] = getValue(i, timestep);
+
+    m_cached_timestep = timestep;
     }
 
 /*! \param timestep Time step to write out data for
@@ -143,10 +224,7 @@ void Logger::analyze(unsigned int timestep)
     if (m_prof) m_prof->push("Log");
 
     // update info in cache for later use and for immediate output.
-    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
-        m_cached_quantities[i] = getValue(m_logged_quantities[i], timestep);
-
-    m_cached_timestep = timestep;
+    updateCachedQuantities(timestep);
 
     if (m_prof) m_prof->pop();
     }
@@ -158,9 +236,7 @@ Scalar Logger::getQuantity(const std::string &quantity, unsigned int timestep, b
     // update info in cache for later use
     if (!use_cache && timestep != m_cached_timestep)
         {
-        for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
-            m_cached_quantities[i] = getValue(m_logged_quantities[i], timestep);
-        m_cached_timestep = timestep;
+        updateCachedQuantities(timestep);
         }
 
     // first see if it is the timestep number
@@ -169,58 +245,48 @@ Scalar Logger::getQuantity(const std::string &quantity, unsigned int timestep, b
         return Scalar(m_cached_timestep);
         }
 
-    // check to see if the quantity exists in the compute list
-    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
-        if (m_logged_quantities[i] == quantity)
-            return m_cached_quantities[i];
+    // check to see if the quantity is logged
+    auto index_it = m_quantity_index.find(quantity);
+    if (index_it != m_quantity_index.end())
+        return m_cached_quantities[index_it->second];
 
     m_exec_conf->msg->warning() << "analyze.log: Log quantity " << quantity << " is not registered, returning a value of 0" << endl;
     return Scalar(0.0);
     }
 
-/*! \param quantity Quantity to get
-    \param timestep Time step to compute value for (needed for Compute classes)
+/*! \param i Index of the quantity in m_logged_quantities
+    \param timestep Time step to compute value for
+
+    The computes in m_logged_computes must already be updated at \a timestep.
 */
-Scalar Logger::getValue(const std::string &quantity, int timestep)
+Scalar Logger::getValue(unsigned int i, unsigned int timestep)
     {
-    // first see if it is the built-in time quantity
-    if (quantity == "time")
-        {
-        return Scalar(double(m_clk.getTime())/1e9);
-        }
-    // check to see if the quantity exists in the compute list
-    else if (m_compute_quantities.count(quantity))
-        {
-        // update the compute
-        m_compute_quantities[quantity]->compute(timestep);
-        // get the log value
-        return m_compute_quantities[quantity]->getLogValue(quantity, timestep);
-        }
-    // check to see if the quantity exists in the updaters list
-    else if (m_updater_quantities.count(quantity))
+    const QuantitySource& source = m_quantity_sources[i];
+    switch (source.type)
         {
-        // get the log value
-        return m_updater_quantities[quantity]->getLogValue(quantity, timestep);
-        }
-    else if (m_callback_quantities.count(quantity))
-        {
-        // get a quantity from a callback
-        try
-            {
-            py::object rv = pybind11::reinterpret_borrow<py::object>(m_callback_quantities[quantity])(timestep);
-            Scalar extracted_rv = rv.cast<Scalar>();
-            return extracted_rv;
-            }
-        catch (const py::cast_error&)
+        case QuantitySource::clock_time:
+            return Scalar(double(m_clk.getTime())/1e9);
+        case QuantitySource::from_compute:
+            return source.comp->getLogValue(m_logged_quantities[i], timestep);
+        case QuantitySource::from_updater:
+            return source.updater->getLogValue(m_logged_quantities[i], timestep);
+        case QuantitySource::from_callback:
             {
-                m_exec_conf->msg->warning() << "analyze.log: Log callback " << quantity << " returned invalid value, logging 0." << endl;
-                return Scalar(0.0);
+            // get a quantity from a callback
+            try
+                {
+                py::object rv = pybind11::reinterpret_borrow<py::object>(source.callback)(timestep);
+                Scalar extracted_rv = rv.cast<Scalar>();
+                return extracted_rv;
+                }
+            catch (const py::cast_error&)
+                {
+                    m_exec_conf->msg->warning() << "analyze.log: Log callback " << m_logged_quantities[i] << " returned invalid value, logging 0." << endl;
+                    return Scalar(0.0);
+                }
             }
-        }
-    else
-        {
-        m_exec_conf->msg->warning() << "analyze.log: Log quantity " << quantity << " is not registered, logging a value of 0" << endl;
-        return Scalar(0.0);
+        default:
+            return Scalar(0.0);
         }
     }
 
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <fstream>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #include <memory>
@@ -40,6 +41,11 @@
     log. Every call to analyze() will result in the computes for the
     logged quantities being called.
 
+    The logged quantities are resolved to their sources once, on the first call to analyze() or getQuantity()
+    after the logged quantities or the registered sources changed. Every compute is then evaluated only once per
+    timestep, even if it provides several of the logged quantities, and the values are stored in
+    m_cached_quantities in the order of m_logged_quantities. Subclasses read the values from there by index.
+
     The removeAll method can be used to clear all registered computes and updaters. hoomd will
     removeAll() and re-register all active computes and updaters before every run()
 
@@ -72,6 +78,9 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
         //! Returns the currently logged quantities
         std::vector<std::string> getLoggedQuantities(void)const{return m_logged_quantities;}
 
+        //! Returns the values of the logged quantities at the last update, in the order of getLoggedQuantities()
+        const std::vector<Scalar>& getCachedQuantities(void)const{return m_cached_quantities;}
+
         //! Query the current value for a given quantity
         virtual Scalar getQuantity(const std::string& quantity, unsigned int timestep, bool use_cache);
 
@@ -92,6 +101,25 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
             }
 
     protected:
+        //! Source of a logged quantity, resolved from its name
+        struct QuantitySource
+            {
+            //! Kinds of sources
+            enum source_type
+                {
+                clock_time,     //!< Built-in wall clock time
+                from_compute,   //!< Registered compute
+                from_updater,   //!< Registered updater
+                from_callback,  //!< Python callback
+                unregistered    //!< Quantity that no source provides
+                };
+
+            source_type type;       //!< Kind of the source
+            Compute *comp;          //!< Compute providing the quantity (if type is from_compute)
+            Updater *updater;       //!< Updater providing the quantity (if type is from_updater)
+            PyObject *callback;     //!< Callback providing the quantity (if type is from_callback)
+            };
+
         //! A map of computes indexed by logged quantity that they provide
         std::map< std::string, std::shared_ptr<Compute> > m_compute_quantities;
         //! A map of updaters indexed by logged quantity that they provide
@@ -106,10 +134,24 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
         unsigned int m_cached_timestep;
         //! The values of the logged quantities at the last logger update.
         std::vector< Scalar > m_cached_quantities;
+        //! Sources of the logged quantities, in the order of m_logged_quantities
+        std::vector< QuantitySource > m_quantity_sources;
+        //! Computes providing the logged quantities, each listed once
+        std::vector< Compute * > m_logged_computes;
+        //! Index of every logged quantity in m_logged_quantities
+        std::unordered_map< std::string, unsigned int > m_quantity_index;
+        //! True if the sources need to be resolved again
+        bool m_sources_stale;
+
+        //! Update the cached values of all logged quantities
+        void updateCachedQuantities(unsigned int timestep);
 
     private:
-        //! Helper function to get a value for a given quantity
-        Scalar getValue(const std::string &quantity, int timestep);
+        //! Resolve the logged quantities to their sources
+        void resolveQuantities();
+
+        //! Helper function to get a value for a resolved quantity
+        Scalar getValue(unsigned int i, unsigned int timestep);
     };
 
 //! exports the Logger class to python
@@ -273,6 +273,17 @@ class PYBIND11_EXPORT ParticleGroup
             return h_member_tags.data[i];
             }
 
+        //! Direct access to the sorted list of member tags
+        /*! \returns A GPUArray of getNumMembersGlobal() tags in ascending order
+            \note The caller \b must \b not write to or change the array.
+        */
+        const GlobalArray<unsigned int>& getMemberTagArray() const
+            {
+            checkRebuild();
+
+            return m_member_tags;
+            }
+
         //! Get a member index from the group
         /*! \param j Value from 0 to getNumMembers()-1 of the group member to get
             \returns Index of the member at position \a j
@@ -27,9 +27,11 @@ struct RNGIdentifier
     static const uint32_t HPMCMonoShuffle = 0xfa870af6;
     static const uint32_t HPMCMonoTrialMove = 0x754dea60;
     static const uint32_t HPMCMonoShift = 0xf4a3210e;
+    static const uint32_t HPMCMonoCheckerboard = 0x3c2d5e91;
     static const uint32_t UpdaterBoxMC= 0xf6a510ab;
     static const uint32_t UpdaterClusters =  0x09365bf5;
     static const uint32_t UpdaterClustersPairwise = 0x50060112;
+    static const uint32_t UpdaterClustersCluster = 0x6b0e3a9d;
     static const uint32_t UpdaterExternalFieldWall = 0xba015a6f;
     static const uint32_t UpdaterMuVT = 0x186df7ba;
     static const uint32_t UpdaterMuVTBox1 = 0x05d4a502;
@@ -613,6 +613,11 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             }
         }
 
+    // complete any output that analyzers are still writing
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer =  m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        analyzer->m_analyzer->flush();
+
     // generate a final status line
     generateStatusLine();
     m_last_status_tstep = m_cur_tstep;
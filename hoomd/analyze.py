@@ -573,6 +573,162 @@ class log(_analyzer):
 
         hoomd.context.current.loggers.append(self)
 
+class log_binary(log):
+    R""" Log a number of calculated quantities to a binary file.
+
+    Args:
+        filename (str): File to write the log to.
+        quantities (list): List of quantities to log.
+        period (int): Quantities are logged every *period* time steps.
+        overwrite (bool): When False (the default) an existing log will be appended to. When True, an existing log file will be overwritten instead.
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        block_records (int): Number of records collected in memory before they are written to the file.
+
+    :py:class:`hoomd.analyze.log_binary` logs the same quantities as :py:class:`hoomd.analyze.log`, but writes
+    them as binary records: the time step followed by one double precision value per quantity. The records are
+    collected in memory and written to the file in large blocks every *block_records* records and at the end of
+    every :py:func:`hoomd.run()`. Use this logger to log many quantities at a short period without issuing many
+    small writes to the file system.
+
+    Read the file with :py:func:`read_log_binary`. The file stores the names of the logged quantities. When a run
+    is interrupted, all blocks written before the interruption can still be read, and a logger that appends to
+    the file removes an incomplete block first.
+
+    Examples::
+
+        logger = analyze.log_binary(filename='log.bin', quantities=['potential_energy', 'temperature'],
+                                    period=10, block_records=10000)
+
+        data = analyze.read_log_binary('log.bin')
+        U = data['potential_energy']
+
+    Warning:
+        Records that have not been written yet are lost if the simulation crashes.
+    """
+
+    def __init__(self, filename, quantities, period, overwrite=False, phase=0, block_records=1000):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        _analyzer.__init__(self);
+
+        # create the c++ mirror class
+        self.cpp_analyzer = _hoomd.LogBinary(hoomd.context.current.system_definition, filename, overwrite, int(block_records));
+        self.setupAnalyzer(period, phase);
+
+        # set the logged quantities
+        quantity_list = _hoomd.std_vector_string();
+        for item in quantities:
+            quantity_list.append(str(item));
+        self.cpp_analyzer.setLoggedQuantities(quantity_list);
+
+        # add the logger to the list of loggers
+        hoomd.context.current.loggers.append(self);
+
+        # store metadata
+        self.metadata_fields = ['filename','period','block_records']
+        self.filename = filename
+        self.period = period
+        self.block_records = block_records
+
+    def set_params(self, quantities=None, block_records=None):
+        R""" Change the parameters of the log.
+
+        Args:
+            quantities (list): New list of quantities to log (if specified)
+            block_records (int): New number of records written to the file at once (if specified)
+
+        Examples::
+
+            logger.set_params(quantities=['bond_harmonic_energy'])
+            logger.set_params(block_records=100)
+        """
+
+        hoomd.util.print_status_line();
+
+        if quantities is not None:
+            # set the logged quantities
+            quantity_list = _hoomd.std_vector_string();
+            for item in quantities:
+                quantity_list.append(str(item));
+            self.cpp_analyzer.setLoggedQuantities(quantity_list);
+
+        if block_records is not None:
+            self.cpp_analyzer.setBlockRecords(int(block_records));
+            self.block_records = block_records
+
+def read_log_binary(filename):
+    R""" Read a log written by :py:class:`log_binary`.
+
+    Args:
+        filename (str): File to read.
+
+    Returns:
+        A dict that maps ``'timestep'`` and the name of every logged quantity to a numpy array with one entry per
+        record. When the logged quantities changed between records, quantities that were not logged in a record
+        are NaN.
+
+    :py:func:`read_log_binary` does not need a simulation context. All complete blocks are read, also from a file
+    that was not closed cleanly.
+
+    Examples::
+
+        data = analyze.read_log_binary('log.bin')
+        plot(data['timestep'], data['potential_energy'])
+    """
+    raw = numpy.fromfile(filename, dtype=numpy.uint8)
+    if len(raw) < 32 or raw[0:8].tobytes() != b'HOOMDLOG':
+        raise RuntimeError(filename + ' is not a binary log')
+
+    # the first chunk holds the byte order mark of the writer
+    order = '<'
+    if numpy.frombuffer(raw[24:32].tobytes(), dtype='<u8')[0] != 0x0102030405060708:
+        order = '>'
+    u8 = numpy.dtype(order + 'u8')
+    f8 = numpy.dtype(order + 'f8')
+
+    # walk through the chunks, each one starts with its tag, size, and count
+    columns = []
+    segments = []
+    offset = 0
+    while offset + 24 <= len(raw):
+        tag = raw[offset:offset+8].tobytes()
+        size, count = [int(v) for v in numpy.frombuffer(raw[offset+8:offset+24].tobytes(), dtype=u8)]
+        if size < 24 or offset + size > len(raw):
+            # incomplete chunk at the end of the file
+            break
+
+        payload = raw[offset+24:offset+size]
+        if tag == b'HLOGCOLS':
+            columns = [name.decode() for name in payload.tobytes().split(b'\0')[:count]]
+        elif tag == b'HLOGDATA':
+            record = numpy.dtype([('timestep', u8), ('values', f8, (len(columns),))])
+            if count * record.itemsize <= len(payload):
+                segments.append((columns, numpy.frombuffer(payload[:count * record.itemsize].tobytes(), dtype=record)))
+        offset += size
+
+    # combine the segments
+    names = []
+    for seg_columns, records in segments:
+        for name in seg_columns:
+            if name not in names:
+                names.append(name)
+
+    num_records = sum(len(records) for seg_columns, records in segments)
+    data = dict(timestep=numpy.zeros(num_records, dtype=numpy.uint64))
+    for name in names:
+        data[name] = numpy.full(num_records, numpy.nan)
+
+    start = 0
+    for seg_columns, records in segments:
+        end = start + len(records)
+        data['timestep'][start:end] = records['timestep']
+        for i, name in enumerate(seg_columns):
+            data[name][start:end] = records['values'][:, i]
+        start = end
+
+    return data
+
 class callback(_analyzer):
     R""" Callback analyzer.
 
@@ -82,6 +82,71 @@ def barrier():
     if _hoomd.is_MPI_available():
         hoomd.context.mpi_conf.barrier()
 
+def set_ghost_update_overlap(enable=True):
+    """ Overlap the ghost particle update with the force computation.
+
+    Args:
+        enable (bool): Set to True to overlap the ghost update with the computation of interior forces
+
+    When enabled, the ghost particle positions sent to neighboring ranks are received while the pair forces on
+    particles without ghost neighbors are computed. The forces on the remaining particles are computed once the ghost
+    update completes. This hides part of the communication latency when running on the CPU. It has no effect on the
+    GPU or in non-MPI builds.
+
+    Note:
+        Must be called after initialization.
+
+    Example::
+
+        hoomd.comm.set_ghost_update_overlap(True)
+    """
+    hoomd.context._verify_init();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot set the ghost update overlap before initialization\n");
+        raise RuntimeError('Error setting ghost update overlap');
+
+    if not _hoomd.is_MPI_available():
+        return;
+
+    cpp_communicator = hoomd.context.current.system.getCommunicator();
+    if cpp_communicator is not None:
+        cpp_communicator.setGhostUpdateOverlap(enable);
+
+def set_direct_ghost_exchange(enable=True):
+    """ Exchange ghost particles with all neighboring domains in a single round.
+
+    Args:
+        enable (bool): Set to True to send ghosts directly to the face, edge and corner neighbors
+
+    By default, ghost particles are exchanged in six consecutive stages, one per face of the local domain, and ghosts
+    at edges and corners are forwarded through the intermediate domains. When enabled, every ghost is sent directly to
+    all (up to 26) neighboring domains it is adjacent to with MPI neighborhood collectives, which requires a single
+    round of messages. Which is faster depends on the interconnect and the MPI library.
+
+    The staged exchange is still used in steps where net forces of ghost particles are communicated, such as with
+    rigid bodies. The setting has no effect on the GPU or in non-MPI builds.
+
+    Note:
+        Must be called after initialization.
+
+    Example::
+
+        hoomd.comm.set_direct_ghost_exchange(True)
+    """
+    hoomd.context._verify_init();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot set the ghost exchange before initialization\n");
+        raise RuntimeError('Error setting ghost exchange');
+
+    if not _hoomd.is_MPI_available():
+        return;
+
+    cpp_communicator = hoomd.context.current.system.getCommunicator();
+    if cpp_communicator is not None:
+        cpp_communicator.setDirectGhostExchange(enable);
+
 class decomposition(object):
     """ Set the domain decomposition.
 
@@ -504,6 +504,10 @@ class gsd(hoomd.analyze._analyzer):
         time_step (int): Time step to write to the file (only used when period is None)
         dynamic (list): A list of quantity categories to save every frame. (added in version 2.2)
         static (list): A list of quantity categories save only in frame 0 (may not be set in conjunction with *dynamic*, deprecated in version 2.2).
+        queue_depth (int): When greater than 0, write frames on a background thread and buffer up to *queue_depth*
+                           frames in memory. (added in version 2.9)
+        mpi_writers (int): When greater than 0, write per-particle data from this many MPI ranks in parallel instead
+                           of gathering it on rank 0. (added in version 2.9)
 
     Write a simulation snapshot to the specified GSD file at regular intervals. GSD is capable of storing all particle
     and bond data fields in hoomd, in every frame of the trajectory. This allows GSD to store simulations where the
@@ -560,6 +564,24 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    .. rubric:: Background writes
+
+    By default, :py:class:`gsd` writes each frame before the simulation continues. Set *queue_depth* to copy the
+    frame into a memory buffer and write it to the file on a background thread while the simulation runs. The
+    simulation only waits for the writer when *queue_depth* frames are already waiting to be written, so
+    *queue_depth* limits the extra memory used to that many copies of the output data. All queued frames are written
+    by the end of every :py:func:`hoomd.run()`. Restart files written with ``truncate=True`` are complete on disk
+    before the simulation continues. Frames are written synchronously when :py:meth:`dump_state` or
+    :py:meth:`dump_shape` are used.
+
+    .. rubric:: Parallel output
+
+    In MPI simulations, :py:class:`gsd` gathers all particle data on rank 0 before writing the frame. Set
+    *mpi_writers* to instead send the particles to *mpi_writers* ranks that each write a contiguous slice of every
+    per-particle data chunk with MPI-IO. The file layout is the same and can be read by any GSD reader. The
+    file must be on a file system that all ranks can write to. Topology and user-defined log quantities are still
+    written by rank 0, and *queue_depth* is ignored when *mpi_writers* is set.
+
     .. rubric:: State data
 
     :py:class:`gsd` can save internal state data for the following hoomd objects:
@@ -584,6 +606,7 @@ class gsd(hoomd.analyze._analyzer):
         dump.gsd(filename="configuration.gsd", overwrite=True, period=None, group=group.all(), time_step=0)
         dump.gsd(filename="momentum_too.gsd", period=1000, group=group.all(), phase=0, dynamic=['momentum'])
         dump.gsd(filename="saveall.gsd", overwrite=True, period=1000, group=group.all(), dynamic=['attribute', 'momentum', 'topology'])
+        dump.gsd(filename="trajectory.gsd", period=100, group=group.all(), queue_depth=2)
 
     """
     def __init__(self,
@@ -595,7 +618,9 @@ class gsd(hoomd.analyze._analyzer):
                  phase=0,
                  time_step=None,
                  static=None,
-                 dynamic=None):
+                 dynamic=None,
+                 queue_depth=0,
+                 mpi_writers=0):
         hoomd.util.print_status_line();
 
         if static is not None and dynamic is not None:
@@ -635,6 +660,8 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' in dynamic_quantities);
         self.cpp_analyzer.setWriteMomentum('momentum' in dynamic_quantities);
         self.cpp_analyzer.setWriteTopology('topology' in dynamic_quantities);
+        self.cpp_analyzer.setQueueDepth(int(queue_depth));
+        self.cpp_analyzer.setNumWriters(int(mpi_writers));
 
         if period is not None:
             self.setupAnalyzer(period, phase);
@@ -642,6 +669,7 @@ class gsd(hoomd.analyze._analyzer):
             if time_step is None:
                 time_step = hoomd.context.current.system.getCurrentTimeStep()
             self.cpp_analyzer.analyze(time_step);
+            self.cpp_analyzer.flush();
 
         # store metadata
         self.filename = filename
@@ -660,6 +688,7 @@ class gsd(hoomd.analyze._analyzer):
 
         time_step = hoomd.context.current.system.getCurrentTimeStep()
         self.cpp_analyzer.analyze(time_step);
+        self.cpp_analyzer.flush();
 
     def dump_state(self, obj):
         """Write state information for a hoomd object.
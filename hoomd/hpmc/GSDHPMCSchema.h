@@ -328,6 +328,7 @@ struct gsd_shape_schema< hpmc::detail::poly3d_verts > : public gsd_schema_hpmc_b
             result.diameter = 2.0*(sqrt(dsq)+result.sweep_radius);
             result.N = N[i];
             result.sweep_radius = sweep_radius[i];
+            result.updateOBB();
             shape[i] = result; // Can we avoid a full copy of the data (move semantics?)
             shape[i].ignore = 0;
             }
@@ -32,6 +32,7 @@ struct hpmc_counters_t
     unsigned long long int rotate_reject_count;         //!< Count of rejected rotation moves
     unsigned long long int overlap_checks;              //!< Count of the number of overlap checks
     unsigned int overlap_err_count;                     //!< Count of the number of times overlap checks encounter errors
+    unsigned long long int candidate_reject_count;      //!< Count of overlap checks rejected by the bounding volumes
 
     //! Construct a zero set of counters
     hpmc_counters_t()
@@ -42,6 +43,7 @@ struct hpmc_counters_t
         rotate_reject_count = 0;
         overlap_checks = 0;
         overlap_err_count = 0;
+        candidate_reject_count = 0;
         }
 
     //! Get the translate acceptance
@@ -66,6 +68,18 @@ struct hpmc_counters_t
             return double(rotate_accept_count) / double(rotate_reject_count + rotate_accept_count);
         }
 
+    //! Get the candidate rejection ratio
+    /*! \returns The ratio of overlap checks that are decided by the bounding volumes alone, or 0 if there are no
+                 overlap checks
+    */
+    DEVICE double getCandidateRejection()
+        {
+        if (overlap_checks == 0)
+            return 0.0;
+        else
+            return double(candidate_reject_count) / double(overlap_checks);
+        }
+
     //! Get the number of moves
     /*! \return The total number of moves
     */
@@ -85,6 +99,21 @@ DEVICE inline hpmc_counters_t operator-(const hpmc_counters_t& a, const hpmc_cou
     result.rotate_reject_count = a.rotate_reject_count - b.rotate_reject_count;
     result.overlap_checks = a.overlap_checks - b.overlap_checks;
     result.overlap_err_count = a.overlap_err_count - b.overlap_err_count;
+    result.candidate_reject_count = a.candidate_reject_count - b.candidate_reject_count;
+    return result;
+    }
+
+//! Take the sum of two sets of counters
+DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_counters_t& b)
+    {
+    hpmc_counters_t result;
+    result.translate_accept_count = a.translate_accept_count + b.translate_accept_count;
+    result.rotate_accept_count = a.rotate_accept_count + b.rotate_accept_count;
+    result.translate_reject_count = a.translate_reject_count + b.translate_reject_count;
+    result.rotate_reject_count = a.rotate_reject_count + b.rotate_reject_count;
+    result.overlap_checks = a.overlap_checks + b.overlap_checks;
+    result.overlap_err_count = a.overlap_err_count + b.overlap_err_count;
+    result.candidate_reject_count = a.candidate_reject_count + b.candidate_reject_count;
     return result;
     }
 
@@ -305,6 +305,7 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
         MPI_Allreduce(MPI_IN_PLACE, &result.rotate_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE, &result.overlap_checks, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE, &result.overlap_err_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.candidate_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         }
 #endif
     return result;
@@ -330,6 +331,9 @@ void export_IntegratorHPMC(py::module& m)
     .def("communicate", &IntegratorHPMC::communicate)
     .def("slotNumTypesChange", &IntegratorHPMC::slotNumTypesChange)
     .def("setDeterministic", &IntegratorHPMC::setDeterministic)
+    .def("setCheckerboard", &IntegratorHPMC::setCheckerboard)
+    .def("setAABBTreeRefitThreshold", &IntegratorHPMC::setAABBTreeRefitThreshold)
+    .def("setSeparatingAxisCache", &IntegratorHPMC::setSeparatingAxisCache)
     .def("disablePatchEnergyLogOnly", &IntegratorHPMC::disablePatchEnergyLogOnly)
     ;
 
@@ -339,8 +343,10 @@ void export_IntegratorHPMC(py::module& m)
     .def_readwrite("rotate_accept_count", &hpmc_counters_t::rotate_accept_count)
     .def_readwrite("rotate_reject_count", &hpmc_counters_t::rotate_reject_count)
     .def_readwrite("overlap_checks", &hpmc_counters_t::overlap_checks)
+    .def_readwrite("candidate_reject_count", &hpmc_counters_t::candidate_reject_count)
     .def("getTranslateAcceptance", &hpmc_counters_t::getTranslateAcceptance)
     .def("getRotateAcceptance", &hpmc_counters_t::getRotateAcceptance)
+    .def("getCandidateRejection", &hpmc_counters_t::getCandidateRejection)
     .def("getNMoves", &hpmc_counters_t::getNMoves)
     ;
     }
@@ -208,6 +208,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             m_exec_conf->msg->notice(2) << "Trial moves per second:        " << double(total_moves) / cur_time << std::endl;
             m_exec_conf->msg->notice(2) << "Overlap checks per second:     " << double(counters.overlap_checks) / cur_time << std::endl;
             m_exec_conf->msg->notice(2) << "Overlap checks per trial move: " << double(counters.overlap_checks) / double(total_moves) << std::endl;
+            m_exec_conf->msg->notice(2) << "Candidate rejection ratio:     " << counters.getCandidateRejection() << std::endl;
             m_exec_conf->msg->notice(2) << "Number of overlap errors:      " << double(counters.overlap_err_count) << std::endl;
             }
 
@@ -322,6 +323,15 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         //! Enable deterministic simulations
         virtual void setDeterministic(bool deterministic) {};
 
+        //! Enable checkerboard sweeps on the CPU
+        virtual void setCheckerboard(bool checkerboard) {};
+
+        //! Set the AABB tree refit threshold
+        virtual void setAABBTreeRefitThreshold(Scalar threshold) {};
+
+        //! Set the size of the separating axis cache
+        virtual void setSeparatingAxisCache(unsigned int slots) {};
+
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep)
             {
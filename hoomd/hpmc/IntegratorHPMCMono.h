@@ -12,6 +12,7 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <climits>
 
 #include "hoomd/Integrator.h"
 #include "HPMCPrecisionSetup.h"
@@ -29,6 +30,10 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 #ifndef NVCC
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
@@ -105,6 +110,121 @@ class UpdateOrder
         std::vector<unsigned int> m_update_order; //!< Update order
     };
 
+//! Cache of the separating axes last found between particles and their neighbors
+/*! A trial move displaces a particle only slightly, so the axis that separated it from a neighbor in the previous
+    overlap test usually still separates them. Every particle has a fixed number of slots, each holding the tag of a
+    neighbor and the separating axis in the space frame. Slots are replaced round robin.
+
+    Rows are indexed by the local particle index and remember the tag of the particle they belong to, so a row left
+    behind by another particle is never used. Cached axes are only hints: they are checked again before every use.
+
+    \ingroup hpmc_data_structs
+*/
+class SeparatingAxisCache
+    {
+    public:
+        //! Constructor
+        SeparatingAxisCache()
+            : m_slots(0)
+            {
+            }
+
+        //! Set the number of slots per particle
+        /*! \param slots Number of neighbors remembered per particle, 0 disables the cache
+        */
+        void setSlots(unsigned int slots)
+            {
+            m_slots = slots;
+            clear();
+            }
+
+        //! Get the number of slots per particle
+        unsigned int getSlots() const
+            {
+            return m_slots;
+            }
+
+        //! Forget all cached axes
+        void clear()
+            {
+            m_tag.clear();
+            m_neighbor.clear();
+            m_axis.clear();
+            m_next.clear();
+            }
+
+        //! Make room for N particles
+        /*! \param N Number of local particles
+            \post Existing rows are kept, new rows are empty
+        */
+        void resize(unsigned int N)
+            {
+            m_tag.resize(N, UINT_MAX);
+            m_neighbor.resize(N*m_slots, UINT_MAX);
+            m_axis.resize(N*m_slots, vec3<OverlapReal>(0,0,0));
+            m_next.resize(N, 0);
+            }
+
+        //! Get the cached axis between two particles
+        /*! \param i Local index of the first particle
+            \param tag_i Tag of the first particle
+            \param tag_j Tag of the second particle
+            \returns The cached axis, or zero if there is none
+        */
+        vec3<OverlapReal> find(unsigned int i, unsigned int tag_i, unsigned int tag_j) const
+            {
+            if (m_tag[i] == tag_i)
+                {
+                for (unsigned int k = i*m_slots; k < (i+1)*m_slots; ++k)
+                    if (m_neighbor[k] == tag_j)
+                        return m_axis[k];
+                }
+            return vec3<OverlapReal>(0,0,0);
+            }
+
+        //! Store the axis between two particles
+        /*! \param i Local index of the first particle
+            \param tag_i Tag of the first particle
+            \param tag_j Tag of the second particle
+            \param axis Separating axis in the space frame, zero if none was found
+        */
+        void store(unsigned int i, unsigned int tag_i, unsigned int tag_j, const vec3<OverlapReal>& axis)
+            {
+            if (m_tag[i] != tag_i)
+                {
+                // the row belonged to another particle
+                m_tag[i] = tag_i;
+                for (unsigned int k = i*m_slots; k < (i+1)*m_slots; ++k)
+                    m_neighbor[k] = UINT_MAX;
+                m_next[i] = 0;
+                }
+
+            for (unsigned int k = i*m_slots; k < (i+1)*m_slots; ++k)
+                {
+                if (m_neighbor[k] == tag_j)
+                    {
+                    m_axis[k] = axis;
+                    return;
+                    }
+                }
+
+            if (dot(axis, axis) == OverlapReal(0.0))
+                return;
+
+            unsigned int k = i*m_slots + m_next[i];
+            m_neighbor[k] = tag_j;
+            m_axis[k] = axis;
+            m_next[i] = (m_next[i] + 1) % m_slots;
+            }
+
+    private:
+        unsigned int m_slots;                       //!< Number of slots per particle
+        std::vector<unsigned int> m_tag;            //!< Tag of the particle each row belongs to
+        std::vector<unsigned int> m_neighbor;       //!< Tag of the neighbor in each slot
+        std::vector< vec3<OverlapReal> > m_axis;    //!< Separating axis in each slot
+        std::vector<unsigned int> m_next;           //!< Next slot to replace in each row
+    };
+
 }; // end namespace detail
 
 //! HPMC on systems of mono-disperse shapes
@@ -161,6 +281,33 @@ class IntegratorHPMCMono : public IntegratorHPMC
             this->m_external_base = (ExternalField*)external.get();
             }
 
+        //! Enable checkerboard sweeps on the CPU
+        /*! \param checkerboard true to sweep a checkerboard of independent cells, false for a serial sweep
+        */
+        virtual void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            m_checkerboard_warning_issued = false;
+            }
+
+        //! Set the AABB tree refit threshold
+        /*! \param threshold Rebuild the tree when its cost grows beyond this factor of the cost after the last build,
+                              0 to rebuild it every time it is invalidated
+        */
+        virtual void setAABBTreeRefitThreshold(Scalar threshold)
+            {
+            m_aabb_refit_threshold = threshold;
+            }
+
+        //! Set the size of the separating axis cache
+        /*! \param slots Number of neighbors per particle for which the last separating axis is remembered,
+                         0 to disable the cache
+        */
+        virtual void setSeparatingAxisCache(unsigned int slots)
+            {
+            m_axis_cache.setSlots(slots);
+            }
+
         //! Get a list of logged quantities
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -368,11 +515,21 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        Scalar m_aabb_refit_threshold;              //!< Cost ratio at which a refit tree is rebuilt (0 disables refits)
+        unsigned long long m_aabb_tree_builds;      //!< Number of times the AABB tree has been built
+        unsigned long long m_aabb_tree_refits;      //!< Number of times the AABB tree has been refit
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
+        bool m_checkerboard;                        //!< True if checkerboard sweeps are enabled
+        bool m_checkerboard_warning_issued;         //!< True if the checkerboard fallback warning has been issued
+        std::shared_ptr<CellList> m_checkerboard_cl;    //!< Cell list for checkerboard sweeps
+        detail::UpdateOrder m_checkerboard_set_order;   //!< Update order for the cell sets of the checkerboard
+
+        detail::SeparatingAxisCache m_axis_cache;   //!< Separating axes of recent overlap tests, as warm start
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -382,6 +539,12 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        //! Check if the checkerboard sweep supports the current system
+        bool checkCheckerboard();
+
+        //! Perform the trial moves of one step on a checkerboard of independent cells
+        void updateCheckerboard(unsigned int timestep, hpmc_counters_t& counters);
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
@@ -392,10 +555,58 @@ class IntegratorHPMCMono : public IntegratorHPMC
             m_aabb_tree_invalid = true;
             }
 
+        //! Test the trial configuration of particle i for overlap with particle j
+        /*! \param i Local index of the particle being moved
+            \param tag_i Tag of particle i
+            \param tag_j Tag of particle j
+            \param r_ij Vector from particle i to particle j
+            \param shape_i Shape of particle i
+            \param shape_j Shape of particle j
+            \param err Incremented if there is an error condition
+            \returns true if the particles overlap
+
+            Starts from the separating axis of the last test of the same pair when the cache is enabled. Only the
+            row of particle i is written, so particles moved in parallel may call this concurrently.
+        */
+        inline bool testOverlapCached(unsigned int i, unsigned int tag_i, unsigned int tag_j,
+            const vec3<Scalar>& r_ij, const Shape& shape_i, const Shape& shape_j, unsigned int& err)
+            {
+            if (!m_axis_cache.getSlots())
+                return test_overlap(r_ij, shape_i, shape_j, err);
+
+            vec3<OverlapReal> axis = m_axis_cache.find(i, tag_i, tag_j);
+            bool overlap = test_overlap(r_ij, shape_i, shape_j, err, axis);
+            if (!overlap)
+                m_axis_cache.store(i, tag_i, tag_j, axis);
+            return overlap;
+            }
+
+        //! Test the bounding volumes of a pair of particles
+        /*! \param r_ij Vector from particle i to particle j
+            \param shape_i Shape of particle i
+            \param shape_j Shape of particle j
+            \param counters Counters to record candidate rejections in
+            \returns false if the bounding volumes show that the particles do not overlap
+
+            The circumspheres are tested first, then the OBBs of shapes that provide one.
+        */
+        inline bool checkBoundingVolumes(const vec3<Scalar>& r_ij, const Shape& shape_i, const Shape& shape_j,
+            hpmc_counters_t& counters)
+            {
+            if (check_circumsphere_overlap(r_ij, shape_i, shape_j) && check_obb_overlap(r_ij, shape_i, shape_j))
+                return true;
+
+            counters.candidate_reject_count++;
+            return false;
+            }
+
         //! callback so that the particle sort signal can invalidate the AABB tree
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+
+            // the rows of the separating axis cache are indexed by particle
+            m_axis_cache.clear();
             }
     };
 
@@ -407,7 +618,13 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
               m_hasOrientation(true),
-              m_extra_image_width(0.0)
+              m_aabb_refit_threshold(0.0),
+              m_aabb_tree_builds(0),
+              m_aabb_tree_refits(0),
+              m_extra_image_width(0.0),
+              m_checkerboard(false),
+              m_checkerboard_warning_issued(false),
+              m_checkerboard_set_order(seed+m_exec_conf->getRank())
     {
     // allocate the parameter storage
     m_params = std::vector<param_type, managed_allocator<param_type> >(m_pdata->getNTypes(), param_type(), managed_allocator<param_type>(m_exec_conf->isCUDAEnabled()));
@@ -502,12 +719,18 @@ void IntegratorHPMCMono<Shape>::printStats()
 
     m_exec_conf->msg->notice(2) << "Avg AABB tree height: " << total_height / Scalar(m_pdata->getN()) << std::endl;
     m_exec_conf->msg->notice(2) << "Max AABB tree height: " << max_height << std::endl;*/
+
+    m_exec_conf->msg->notice(2) << "AABB tree builds:              " << m_aabb_tree_builds << std::endl;
+    m_exec_conf->msg->notice(2) << "AABB tree refits:              " << m_aabb_tree_refits << std::endl;
     }
 
 template <class Shape>
 void IntegratorHPMCMono<Shape>::resetStats()
     {
     IntegratorHPMC::resetStats();
+
+    m_aabb_tree_builds = 0;
+    m_aabb_tree_refits = 0;
     }
 
 template <class Shape>
@@ -561,6 +784,8 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_exec_conf->msg->notice(10) << "HPMCMono update: " << timestep << std::endl;
     IntegratorHPMC::update(timestep);
 
+    int64_t start_time = this->m_compute_clk.getTime();
+
     // get needed vars
     ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::readwrite);
     hpmc_counters_t& counters = h_counters.data[0];
@@ -573,16 +798,28 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     Scalar3 ghost_fraction = m_nominal_width / npd;
     #endif
 
-    // Shuffle the order of particles for this step
-    m_update_order.resize(m_pdata->getN());
-    m_update_order.shuffle(timestep);
+    // new particles start without cached separating axes
+    if (m_axis_cache.getSlots())
+        m_axis_cache.resize(m_pdata->getN());
+
+    // the checkerboard sweep finds neighbors in its own cell list and does not need the AABB tree
+    const bool checkerboard = m_checkerboard && checkCheckerboard();
+
+    // Shuffle the order of particles for the serial sweeps of this step
+    if (!checkerboard)
+        {
+        m_update_order.resize(m_pdata->getN());
+        m_update_order.shuffle(timestep);
+        }
 
     // update the AABB Tree
-    buildAABBTree();
+    if (!checkerboard)
+        buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
     limitMoveDistances();
     // update the image list
-    updateImageList();
+    if (!checkerboard)
+        updateImageList();
 
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC update");
 
@@ -591,17 +828,23 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         m_external->compute(timestep);
         }
 
+    // the checkerboard sweep performs all nselect sweeps itself
+    if (checkerboard)
+        updateCheckerboard(timestep, counters);
+    const unsigned int n_serial_sweeps = checkerboard ? 0 : m_nselect;
+
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
     // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    for (unsigned int i_nselect = 0; i_nselect < n_serial_sweeps; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
         ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
         //access move sizes
         ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
@@ -678,10 +921,15 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                 r_cut_patch = m_patch->getRCut() + 0.5*m_patch->getAdditiveCutoff(typ_i);
                 }
 
-            // subtract minimum AABB extent from search radius
-            OverlapReal R_query = std::max(shape_i.getCircumsphereDiameter()/OverlapReal(2.0),
-                r_cut_patch-getMinCoreDiameter()/(OverlapReal)2.0);
-            detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
+            // the tree holds the tight AABBs of the shapes, unless there is a patch interaction
+            detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+            if (m_patch)
+                {
+                // subtract minimum AABB extent from search radius
+                OverlapReal R_query = std::max(shape_i.getCircumsphereDiameter()/OverlapReal(2.0),
+                    r_cut_patch-getMinCoreDiameter()/(OverlapReal)2.0);
+                aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
+                }
 
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
@@ -744,8 +992,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
                                 counters.overlap_checks++;
                                 if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                    && checkBoundingVolumes(r_ij, shape_i, shape_j, counters)
+                                    && testOverlapCached(i, h_tag.data[i], h_tag.data[j], r_ij, shape_i, shape_j,
+                                        counters.overlap_err_count))
                                     {
                                     overlap = true;
                                     break;
@@ -912,9 +1161,14 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             }
         }
 
-    // perform the grid shift
+    // perform the grid shift, checkerboard sweeps depend on it for detailed balance just like domain decomposition
+    bool grid_shift = checkerboard;
     #ifdef ENABLE_MPI
     if (m_comm)
+        grid_shift = true;
+    #endif
+
+    if (grid_shift)
         {
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
@@ -940,10 +1194,11 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             }
         this->m_pdata->translateOrigin(shift);
         }
-    #endif
 
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
+    this->m_compute_time += double(this->m_compute_clk.getTime() - start_time)/1e9;
+
     // migrate and exchange particles
     communicate(true);
 
@@ -1486,6 +1741,9 @@ void IntegratorHPMCMono<Shape>::updateCellWidth()
         m_nominal_width = std::max(m_nominal_width, max_extent+m_patch->getRCut());
         }
 
+    if (m_checkerboard_cl)
+        m_checkerboard_cl->setNominalWidth(m_nominal_width);
+
     // changing the cell width means that the particle shapes have changed, assume this invalidates the
     // image list and aabb tree
     m_image_list_valid = false;
@@ -1557,7 +1815,21 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the existing tree in place while its quality is acceptable
+                bool refit = false;
+                if (m_aabb_refit_threshold > Scalar(0.0) && m_aabb_tree.refit(m_aabbs, n_aabb))
+                    refit = m_aabb_tree.getCost() <= m_aabb_refit_threshold*m_aabb_tree.getBuildCost();
+
+                if (refit)
+                    {
+                    m_aabb_tree_refits++;
+                    }
+                else
+                    {
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    m_aabb_tree_builds++;
+                    }
                 }
             }
 
@@ -1603,6 +1875,332 @@ void IntegratorHPMCMono<Shape>::limitMoveDistances()
         }
     }
 
+/*! The checkerboard sweep requires that particles in different active cells never interact, which holds only for
+    hard shapes in boxes that are at least two cells wide. Patch energies and external fields are evaluated by code
+    that is not safe to call from several threads at once and are not supported.
+
+    \returns true if updateCheckerboard() can be used for the current system
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::checkCheckerboard()
+    {
+    std::string reason;
+    if (m_patch && !m_patch_log)
+        {
+        reason = "patch energies";
+        }
+    else if (m_external)
+        {
+        reason = "external fields";
+        }
+    else
+        {
+        const BoxDim& box = m_pdata->getBox();
+        Scalar3 npd = box.getNearestPlaneDistance();
+        if ((box.getPeriodic().x && npd.x <= m_nominal_width*2) ||
+            (box.getPeriodic().y && npd.y <= m_nominal_width*2) ||
+            (m_sysdef->getNDimensions() == 3 && box.getPeriodic().z && npd.z <= m_nominal_width*2))
+            {
+            reason = "boxes smaller than two particle diameters";
+            }
+        }
+
+    if (reason.empty())
+        return true;
+
+    if (!m_checkerboard_warning_issued)
+        {
+        m_exec_conf->msg->warning() << "hpmc: checkerboard sweeps do not support " << reason
+                                    << ", falling back to serial sweeps" << std::endl;
+        m_checkerboard_warning_issued = true;
+        }
+    return false;
+    }
+
+/*! \param timestep Current time step
+    \param counters Acceptance counters to add to
+
+    Bins the local and ghost particles into cells that are at least as wide as the largest particle, with an even
+    number of cells along each direction. Splitting the cells into 2^d sets along the lines of a checkerboard leaves
+    one inactive cell between any two cells of the same set. As long as every particle stays within its own cell, the
+    trial moves in different cells of one set are independent, and the cells of a set are swept in parallel. Moves that
+    leave the cell are rejected, and the random grid shift at the end of update() restores detailed balance.
+
+    The cells are swept in a random order of the sets, and the particles in each cell in forward or reverse order
+    drawn from a random stream seeded by the cell index. Together with the per particle trial move streams, this makes
+    the result independent of the number of threads.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCheckerboard(unsigned int timestep, hpmc_counters_t& counters)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = m_nominal_width / npd;
+    #endif
+
+    if (!m_checkerboard_cl)
+        {
+        m_checkerboard_cl = std::shared_ptr<CellList>(new CellList(m_sysdef));
+        m_checkerboard_cl->setRadius(1);
+        m_checkerboard_cl->setComputeXYZF(false);
+        m_checkerboard_cl->setComputeTDB(false);
+        m_checkerboard_cl->setComputeIdx(true);
+
+        // require that cell lists have an even number of cells along each direction
+        m_checkerboard_cl->setMultiple(2);
+        m_checkerboard_cl->setNominalWidth(m_nominal_width);
+
+        #ifdef ENABLE_MPI
+        if (m_comm)
+            m_checkerboard_cl->setCommunicator(m_comm);
+        #endif
+        }
+
+    // particles have moved since the last step, always rebuild
+    m_checkerboard_cl->forceCompute(timestep);
+
+    const uint3 dim = m_checkerboard_cl->getDim();
+    const Index3D& ci = m_checkerboard_cl->getCellIndexer();
+    const Index2D& cli = m_checkerboard_cl->getCellListIndexer();
+    const Index2D& cadji = m_checkerboard_cl->getCellAdjIndexer();
+    const Scalar3 ghost_width = m_checkerboard_cl->getGhostWidth();
+
+    ArrayHandle<unsigned int> h_cell_size(m_checkerboard_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_idx(m_checkerboard_cl->getIndexArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_checkerboard_cl->getCellAdjArray(), access_location::host, access_mode::read);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // access move sizes and interaction matrix
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    const unsigned int N = m_pdata->getN();
+
+    // the cells of one set are every other cell along each direction
+    const unsigned int n_sets = (ndim == 3) ? 8 : 4;
+    Index3D set_indexer(dim.x/2, dim.y/2, (ndim == 3) ? dim.z/2 : 1);
+    m_checkerboard_set_order.resize(n_sets);
+
+    // returns true if pos lies in the given cell
+    auto in_cell = [&](const vec3<Scalar>& pos, unsigned int cell) -> bool
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(pos), ghost_width);
+        if (f.x < Scalar(0.0) || f.x >= Scalar(1.0) ||
+            f.y < Scalar(0.0) || f.y >= Scalar(1.0) ||
+            f.z < Scalar(0.0) || f.z >= Scalar(1.0))
+            return false;
+
+        unsigned int ib = (unsigned int)(f.x * dim.x);
+        unsigned int jb = (unsigned int)(f.y * dim.y);
+        unsigned int kb = (unsigned int)(f.z * dim.z);
+        return ib < dim.x && jb < dim.y && kb < dim.z && ci(ib, jb, kb) == cell;
+        };
+
+    // performs one trial move of every local particle in the cell
+    auto sweep_cell = [&](unsigned int cell, unsigned int i_nselect, hpmc_counters_t& cell_counters)
+        {
+        const unsigned int size = h_cell_size.data[cell];
+
+        // visit the particles in forward or reverse order
+        hoomd::RandomGenerator rng_cell(hoomd::RNGIdentifier::HPMCMonoCheckerboard, m_seed, cell, m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+        const bool reverse = hoomd::UniformIntDistribution(1)(rng_cell);
+
+        for (unsigned int cur_particle = 0; cur_particle < size; cur_particle++)
+            {
+            unsigned int i = h_cell_idx.data[cli(reverse ? size - 1 - cur_particle : cur_particle, cell)];
+
+            // ghost particles are never moved
+            if (i >= N)
+                continue;
+
+            // read in the current position and orientation
+            Scalar4 postype_i = h_postype.data[i];
+            Scalar4 orientation_i = h_orientation.data[i];
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+            #ifdef ENABLE_MPI
+            if (m_comm)
+                {
+                // only move particle if active
+                if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                    continue;
+                }
+            #endif
+
+            // make a trial move for i
+            hoomd::RandomGenerator rng_i(hoomd::RNGIdentifier::HPMCMonoTrialMove, m_seed, i, m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+            int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+            bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_move_ratio);
+
+            bool overlap = false;
+
+            if (move_type_translate)
+                {
+                // skip if no overlap check is required
+                if (h_d.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        cell_counters.translate_accept_count++;
+                    continue;
+                    }
+
+                move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                #ifdef ENABLE_MPI
+                if (m_comm)
+                    {
+                    // check if particle has moved into the ghost layer, and skip if it is
+                    if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                        continue;
+                    }
+                #endif
+
+                // particles that leave their cell could interact with the other active cells
+                if (!in_cell(pos_i, cell))
+                    overlap = true;
+                }
+            else
+                {
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        cell_counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                move_rotate(shape_i.orientation, rng_i, h_a.data[typ_i], ndim);
+                }
+
+            // check for overlaps with the particles in the neighboring cells
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW() && !overlap; cur_adj++)
+                {
+                unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, cell)];
+                unsigned int neigh_size = h_cell_size.data[neigh_cell];
+
+                for (unsigned int cur_p = 0; cur_p < neigh_size; cur_p++)
+                    {
+                    unsigned int j = h_cell_idx.data[cli(cur_p, neigh_cell)];
+                    if (j == i)
+                        continue;
+
+                    // load the position and orientation of the j particle
+                    Scalar4 postype_j = h_postype.data[j];
+                    Scalar4 orientation_j = h_orientation.data[j];
+
+                    // put particles in coordinate system of particle i
+                    vec3<Scalar> r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_i)));
+
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                    cell_counters.overlap_checks++;
+                    if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                        && checkBoundingVolumes(r_ij, shape_i, shape_j, cell_counters)
+                        && testOverlapCached(i, h_tag.data[i], h_tag.data[j], r_ij, shape_i, shape_j,
+                            cell_counters.overlap_err_count))
+                        {
+                        overlap = true;
+                        break;
+                        }
+                    }
+                }
+
+            if (!overlap)
+                {
+                // increment accept counter and assign new position
+                if (!shape_i.ignoreStatistics())
+                    {
+                    if (move_type_translate)
+                        cell_counters.translate_accept_count++;
+                    else
+                        cell_counters.rotate_accept_count++;
+                    }
+
+                // update position of particle
+                h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+                if (shape_i.hasOrientation())
+                    {
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    }
+                }
+            else
+                {
+                if (!shape_i.ignoreStatistics())
+                    {
+                    // increment reject counter
+                    if (move_type_translate)
+                        cell_counters.translate_reject_count++;
+                    else
+                        cell_counters.rotate_reject_count++;
+                    }
+                }
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    // per thread acceptance counters, merged after the sweep
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    #endif
+
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        m_checkerboard_set_order.shuffle(timestep, i_nselect);
+
+        for (unsigned int cur_set_idx = 0; cur_set_idx < n_sets; cur_set_idx++)
+            {
+            const unsigned int cur_set = m_checkerboard_set_order[cur_set_idx];
+
+            // sweeps the cells of the current set with indices in [first, last)
+            auto sweep_set = [&](unsigned int first, unsigned int last, hpmc_counters_t& set_counters)
+                {
+                for (unsigned int set_cell = first; set_cell < last; set_cell++)
+                    {
+                    uint3 t = set_indexer.getTriple(set_cell);
+                    unsigned int cell = ci(2*t.x + (cur_set & 1), 2*t.y + ((cur_set >> 1) & 1), 2*t.z + ((cur_set >> 2) & 1));
+                    sweep_cell(cell, i_nselect, set_counters);
+                    }
+                };
+
+            #ifdef ENABLE_TBB
+            if (m_exec_conf->getNumThreads() > 1)
+                {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, set_indexer.getNumElements()),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                    sweep_set(r.begin(), r.end(), thread_counters.local());
+                    });
+                }
+            else
+            #endif
+                {
+                sweep_set(0, set_indexer.getNumElements(), counters);
+                }
+            }
+        }
+
+    #ifdef ENABLE_TBB
+    thread_counters.combine_each([&](const hpmc_counters_t& c)
+        {
+        counters = counters + c;
+        });
+    #endif
+
+    // particles have moved, the aabb tree is now invalid
+    m_aabb_tree_invalid = true;
+    }
+
 /*! Function for finding all overlaps in a system by particle tag. returns an unraveled form of an NxN matrix
  * with true/false indicating the overlap status of the ith and jth particle
  */
@@ -6,6 +6,7 @@
 #include "hoomd/VectorMath.h"
 #include "ShapeSphere.h"    //< For the base template of test_overlap
 #include "XenoCollide3D.h"
+#include "OBB.h"
 #include "hoomd/ManagedArray.h"
 
 #ifndef __SHAPE_CONVEX_POLYHEDRON_H__
@@ -90,6 +91,11 @@ struct poly3d_verts : param_base
         }
     #endif
 
+    #ifndef NVCC
+    //! Compute the bounding box of the vertices in the body frame, must be called after the vertices change
+    void updateOBB();
+    #endif
+
     ManagedArray<OverlapReal> x;        //!< X coordinate of vertices
     ManagedArray<OverlapReal> y;        //!< Y coordinate of vertices
     ManagedArray<OverlapReal> z;        //!< Z coordinate of vertices
@@ -98,6 +104,8 @@ struct poly3d_verts : param_base
     OverlapReal sweep_radius;               //!< Radius of the sphere sweep (used for spheropolyhedra)
     unsigned int ignore;                    //!< Bitwise ignore flag for stats, overlaps. 1 will ignore, 0 will not ignore
                                             //   First bit is ignore overlaps, Second bit is ignore statistics
+    vec3<OverlapReal> obb_center;           //!< Center of the bounding box of the vertices in the body frame
+    vec3<OverlapReal> obb_lengths;          //!< Half lengths of the bounding box of the vertices in the body frame
     } __attribute__((aligned(32)));
 
 //! Support function for ShapePolyhedron
@@ -297,6 +305,44 @@ class SupportFuncConvexPolyhedron
         const poly3d_verts& verts;      //!< Vertices of the polyhedron
     };
 
+//! Compute the extents of the polyhedron vertices along the axes of a rotated frame
+/*! \param verts Polyhedron vertices
+    \param R Rotation from the body frame into the frame of the extents
+    \param lower Lowest coordinates of any vertex (output)
+    \param upper Highest coordinates of any vertex (output)
+
+    The sweep radius is not included.
+*/
+DEVICE inline void poly3d_extents(const poly3d_verts& verts,
+                                  const rotmat3<OverlapReal>& R,
+                                  vec3<OverlapReal>& lower,
+                                  vec3<OverlapReal>& upper)
+    {
+    lower = upper = vec3<OverlapReal>(0,0,0);
+    if (verts.N > 0)
+        lower = upper = R * vec3<OverlapReal>(verts.x[0], verts.y[0], verts.z[0]);
+
+    for (unsigned int i = 1; i < verts.N; i++)
+        {
+        vec3<OverlapReal> v = R * vec3<OverlapReal>(verts.x[i], verts.y[i], verts.z[i]);
+        lower.x = detail::min(lower.x, v.x); upper.x = detail::max(upper.x, v.x);
+        lower.y = detail::min(lower.y, v.y); upper.y = detail::max(upper.y, v.y);
+        lower.z = detail::min(lower.z, v.z); upper.z = detail::max(upper.z, v.z);
+        }
+    }
+
+#ifndef NVCC
+/*! The box is rotated and translated with the particle by the shapes, so that getOBB() does not loop over the
+    vertices. The sweep radius is not included.
+*/
+inline void poly3d_verts::updateOBB()
+    {
+    vec3<OverlapReal> lower, upper;
+    poly3d_extents(*this, rotmat3<OverlapReal>(quat<OverlapReal>()), lower, upper);
+    obb_center = OverlapReal(0.5)*(lower + upper);
+    obb_lengths = OverlapReal(0.5)*(upper - lower);
+    }
+#endif
 
 }; // end namespace detail
 
@@ -356,29 +402,21 @@ struct ShapeConvexPolyhedron
     //! Return the bounding box of the shape in world coordinates
     DEVICE detail::AABB getAABB(const vec3<Scalar>& pos) const
         {
-        // generate a tight AABB around the polyhedron
-        // detail::SupportFuncConvexPolyhedron sfunc(verts);
-
-        // // use support function of the to determine the furthest extent in each direction
-        // quat<OverlapReal> o(orientation);
-        // vec3<OverlapReal> e_x(1,0,0);
-        // vec3<OverlapReal> e_y(0,1,0);
-        // vec3<OverlapReal> e_z(0,0,1);
-        // vec3<OverlapReal> s_x = rotate(o, sfunc(rotate(conj(o),e_x)));
-        // vec3<OverlapReal> s_y = rotate(o, sfunc(rotate(conj(o),e_y)));
-        // vec3<OverlapReal> s_z = rotate(o, sfunc(rotate(conj(o),e_z)));
-        // vec3<OverlapReal> s_neg_x = rotate(o, sfunc(rotate(conj(o),-e_x)));
-        // vec3<OverlapReal> s_neg_y = rotate(o, sfunc(rotate(conj(o),-e_y)));
-        // vec3<OverlapReal> s_neg_z = rotate(o, sfunc(rotate(conj(o),-e_z)));
-
-        // // translate out from the position by the furthest extents
-        // vec3<Scalar> upper(pos.x + s_x.x, pos.y + s_y.y, pos.z + s_z.z);
-        // vec3<Scalar> lower(pos.x + s_neg_x.x, pos.y + s_neg_y.y, pos.z + s_neg_z.z);
-
-        // return detail::AABB(lower, upper);
-
-        // ^^^^^^^ The above method is slow, just use a box that bounds the circumsphere
-        return detail::AABB(pos, getCircumsphereDiameter()/Scalar(2));
+        // a single pass over the rotated vertices gives a tight AABB
+        vec3<OverlapReal> lower, upper;
+        detail::poly3d_extents(verts, rotmat3<OverlapReal>(quat<OverlapReal>(orientation)), lower, upper);
+        return detail::AABB(pos + vec3<Scalar>(lower), pos + vec3<Scalar>(upper));
+        }
+
+    //! Return a tight fitting OBB
+    DEVICE detail::OBB getOBB(const vec3<Scalar>& pos) const
+        {
+        // the box of the vertices in the body frame, rotated with the particle
+        detail::OBB obb;
+        obb.rotation = orientation;
+        obb.center = vec3<OverlapReal>(pos) + rotate(obb.rotation, verts.obb_center);
+        obb.lengths = verts.obb_lengths;
+        return obb;
         }
 
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
@@ -407,6 +445,20 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return (rsq*OverlapReal(4.0) <= DaDb * DaDb);
     }
 
+//! Check if the oriented bounding boxes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns true if the OBBs of both shapes overlap
+
+    \ingroup shape
+*/
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapeConvexPolyhedron& a,
+    const ShapeConvexPolyhedron &b)
+    {
+    return detail::overlap(a.getOBB(vec3<Scalar>(0,0,0)), b.getOBB(r_ab));
+    }
+
 //! Convex polyhedron overlap test
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -441,6 +493,42 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Convex polyhedron overlap test with a separating axis hint
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param sep_axis in/out separating axis in the space frame, see xenocollide_3d()
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                 const ShapeConvexPolyhedron& a,
+                                 const ShapeConvexPolyhedron& b,
+                                 unsigned int& err,
+                                 vec3<OverlapReal>& sep_axis)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    // the axis is cached in the space frame, xenocollide works in the frame of a
+    quat<OverlapReal> qa(a.orientation);
+    vec3<OverlapReal> n = rotate(conj(qa), sep_axis);
+
+    bool overlap = detail::xenocollide_3d(detail::SupportFuncConvexPolyhedron(a.verts),
+                                          detail::SupportFuncConvexPolyhedron(b.verts),
+                                          rotate(conj(qa), dr),
+                                          conj(qa) * quat<OverlapReal>(b.orientation),
+                                          DaDb/2.0,
+                                          err,
+                                          &n);
+
+    if (!overlap)
+        sep_axis = rotate(qa, n);
+    return overlap;
+    }
+
 }; // end namespace hpmc
 
 #undef DEVICE
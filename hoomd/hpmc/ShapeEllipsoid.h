@@ -6,6 +6,7 @@
 #include "HPMCPrecisionSetup.h"
 #include "hoomd/VectorMath.h"
 #include "ShapeSphere.h"    //< For the base template of test_overlap
+#include "OBB.h"
 
 #ifndef __SHAPE_ELLIPSOID_H__
 #define __SHAPE_ELLIPSOID_H__
@@ -121,27 +122,24 @@ struct ShapeEllipsoid
     //! Return the bounding box of the shape in world coordinates
     DEVICE detail::AABB getAABB(const vec3<Scalar>& pos) const
         {
-        OverlapReal max_axis = detail::max(axes.x, detail::max(axes.y, axes.z));
-
-        // generate a tight fitting AABB
-        // OverlapReal min_axis = min(axes.x, min(axes.y, axes.z));
-
-        // use support function of the ellipsoid to determine the furthest extent in each direction
-        // vec3<Scalar> e_x(1,0,0);
-        // vec3<Scalar> e_y(0,1,0);
-        // vec3<Scalar> e_z(0,0,1);
-        // vec3<Scalar> s_x = rotate(orientation, sfunc(rotate(conj(orientation),e_x)));
-        // vec3<Scalar> s_y = rotate(orientation, sfunc(rotate(conj(orientation),e_y)));
-        // vec3<Scalar> s_z = rotate(orientation, sfunc(rotate(conj(orientation),e_z)));
-
-        // // translate out from the position by the furthest extent
-        // vec3<Scalar> upper(pos.x + s_x.x, pos.y + s_y.y, pos.z + s_z.z);
-        // // the furthest extent is symmetrical
-        // vec3<Scalar> lower(pos.x - s_x.x, pos.y - s_y.y, pos.z - s_z.z);
-
-        // return detail::AABB(lower, upper);
-        // ^^^^^^^^^ The above method is slow, just use the circumsphere
-        return detail::AABB(pos, max_axis);
+        // the extent along each space axis follows from the half axes projected onto it
+        rotmat3<OverlapReal> R = rotmat3<OverlapReal>(quat<OverlapReal>(orientation));
+        vec3<OverlapReal> r0(R.row0.x*axes.x, R.row0.y*axes.y, R.row0.z*axes.z);
+        vec3<OverlapReal> r1(R.row1.x*axes.x, R.row1.y*axes.y, R.row1.z*axes.z);
+        vec3<OverlapReal> r2(R.row2.x*axes.x, R.row2.y*axes.y, R.row2.z*axes.z);
+        vec3<Scalar> extent(fast::sqrt(dot(r0,r0)), fast::sqrt(dot(r1,r1)), fast::sqrt(dot(r2,r2)));
+
+        return detail::AABB(pos - extent, pos + extent);
+        }
+
+    //! Return a tight fitting OBB
+    DEVICE detail::OBB getOBB(const vec3<Scalar>& pos) const
+        {
+        detail::OBB obb;
+        obb.center = pos;
+        obb.rotation = orientation;
+        obb.lengths = vec3<OverlapReal>(axes.x, axes.y, axes.z);
+        return obb;
         }
 
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
@@ -421,6 +419,20 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return (rsq*OverlapReal(4.0) <= DaDb * DaDb);
     }
 
+//! Check if the oriented bounding boxes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns true if the OBBs of both shapes overlap
+
+    \ingroup shape
+*/
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapeEllipsoid& a,
+    const ShapeEllipsoid &b)
+    {
+    return detail::overlap(a.getOBB(vec3<Scalar>(0,0,0)), b.getOBB(r_ab));
+    }
+
 //! Ellipsoid overlap test
 /*!
     \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
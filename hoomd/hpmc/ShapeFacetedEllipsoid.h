@@ -467,6 +467,20 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return (dot(dr,dr) <= DaDb*DaDb/OverlapReal(4.0));
     }
 
+//! Check if the oriented bounding boxes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns true if the OBBs of both shapes overlap
+
+    \ingroup shape
+*/
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapeFacetedEllipsoid& a,
+    const ShapeFacetedEllipsoid &b)
+    {
+    return detail::overlap(a.getOBB(vec3<Scalar>(0,0,0)), b.getOBB(r_ab));
+    }
+
 //! Overlap of faceted spheres
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -499,6 +513,43 @@ DEVICE inline bool test_overlap<ShapeFacetedEllipsoid, ShapeFacetedEllipsoid>(co
     */
     }
 
+//! Overlap of faceted spheres with a separating axis hint
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param sep_axis in/out separating axis in the space frame, see xenocollide_3d()
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                const ShapeFacetedEllipsoid& a,
+                                const ShapeFacetedEllipsoid& b,
+                                unsigned int& err,
+                                vec3<OverlapReal>& sep_axis)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    // the axis is cached in the space frame, xenocollide works in the frame of a
+    quat<OverlapReal> qa(a.orientation);
+    quat<OverlapReal> qb(b.orientation);
+    vec3<OverlapReal> n = rotate(conj(qa), sep_axis);
+
+    bool overlap = detail::xenocollide_3d(detail::SupportFuncFacetedEllipsoid(a.params),
+                                          detail::SupportFuncFacetedEllipsoid(b.params),
+                                          rotate(conj(qa), dr + rotate(qb,b.params.origin))-a.params.origin,
+                                          conj(qa) * qb,
+                                          DaDb/2.0,
+                                          err,
+                                          &n);
+
+    if (!overlap)
+        sep_axis = rotate(qa, n);
+    return overlap;
+    }
+
 }; // end namespace hpmc
 
 #undef DEVICE
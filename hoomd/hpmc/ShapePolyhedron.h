@@ -54,6 +54,12 @@ namespace hpmc
 namespace detail
 {
 
+//! Number of rows per triangle in poly3d_data::leaf_tris
+/*! The rows are the coordinates of the three vertices (x0, y0, z0, x1, ..., z2), followed by the unnormalized
+    face normal (nx, ny, nz) and the plane offset d = -dot(n, v0).
+*/
+const unsigned int poly3d_leaf_tri_rows = 13;
+
 //! Data structure for general polytopes
 /*! \ingroup hpmc_data_structs */
 
@@ -88,6 +94,10 @@ struct poly3d_data : param_base
     unsigned int hull_only;                         //!< If 1, only the hull of the shape is considered for overlaps
     OverlapReal sweep_radius;                       //!< Radius of a sweeping sphere
 
+    // The leaf triangles are only read by the CPU, they are not loaded into shared memory or managed memory
+    ManagedArray<OverlapReal> leaf_tris;            //!< Triangles of the leaf nodes in SoA layout, see initializeLeafTriangles()
+    ManagedArray<unsigned int> leaf_tri_ptr;        //!< Offset of every tree node in leaf_tris, in padded triangles
+
     //! Load dynamic data members into shared memory and increase pointer
     /*! \param ptr Pointer to load data to (will be incremented)
         \param available_bytes Size of remaining shared memory allocation
@@ -202,6 +212,63 @@ struct ShapePolyhedron
         return detail::AABB(pos, data.convex_hull_verts.diameter/Scalar(2));
         }
 
+    #ifndef NVCC
+    //! Build the SoA layout of the leaf triangles for the vectorized narrow phase
+    /*! \param params Shape parameters with a complete tree
+
+        The faces of every leaf node are stored as poly3d_leaf_tri_rows rows of consecutive values, padded to a
+        multiple of 8 faces, in the order of GPUTree::getParticle(). Faces with less than three vertices are stored
+        as zeros. Call again whenever the tree changes.
+    */
+    static void initializeLeafTriangles(param_type& params)
+        {
+        const detail::GPUTree& tree = params.tree;
+        params.leaf_tri_ptr = ManagedArray<unsigned int>(tree.getNumNodes()+1, false);
+
+        unsigned int n_pad = 0;
+        for (unsigned int node = 0; node < tree.getNumNodes(); ++node)
+            {
+            params.leaf_tri_ptr[node] = n_pad;
+            n_pad += ((tree.getNumParticles(node) + 7)/8)*8;
+            }
+        params.leaf_tri_ptr[tree.getNumNodes()] = n_pad;
+
+        params.leaf_tris = ManagedArray<OverlapReal>(detail::poly3d_leaf_tri_rows*n_pad, false);
+        std::fill(params.leaf_tris.get(), params.leaf_tris.get() + params.leaf_tris.size(), OverlapReal(0.0));
+
+        for (unsigned int node = 0; node < tree.getNumNodes(); ++node)
+            {
+            unsigned int start = params.leaf_tri_ptr[node];
+            unsigned int width = params.leaf_tri_ptr[node+1] - start;
+            OverlapReal *rows = params.leaf_tris.get() + detail::poly3d_leaf_tri_rows*start;
+
+            for (unsigned int i = 0; i < (unsigned int)tree.getNumParticles(node); ++i)
+                {
+                unsigned int face = tree.getParticle(node, i);
+                unsigned int offs = params.face_offs[face];
+                if (params.face_offs[face+1] - offs < 3)
+                    continue;
+
+                vec3<OverlapReal> v[3];
+                for (unsigned int k = 0; k < 3; ++k)
+                    {
+                    v[k] = params.verts[params.face_verts[offs+k]];
+                    rows[(3*k)*width + i] = v[k].x;
+                    rows[(3*k+1)*width + i] = v[k].y;
+                    rows[(3*k+2)*width + i] = v[k].z;
+                    }
+
+                // same plane equation as in NoDivTriTriIsect()
+                vec3<OverlapReal> n = cross(v[1] - v[0], v[2] - v[0]);
+                rows[9*width + i] = n.x;
+                rows[10*width + i] = n.y;
+                rows[11*width + i] = n.z;
+                rows[12*width + i] = -(n.x*v[0].x + n.y*v[0].y + n.z*v[0].z);
+                }
+            }
+        }
+    #endif
+
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel()
         {
@@ -550,6 +617,164 @@ DEVICE inline OverlapReal shortest_distance_triangles(
 
 #include <hoomd/extern/triangle_triangle.h>
 
+#if !defined(NVCC) && defined(__SSE__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+//! Test a triangle against all triangles in a leaf node with SIMD
+/*! \param U Vertices of the triangle, IN THE REFERENCE FRAME of b
+    \param mask_a Overlap mask of the triangle
+    \param b shape
+    \param cur_node_b Leaf node in b's tree to check
+    \param abs_tol an absolute tolerance for the triangle triangle check
+    \returns true if the triangle intersects any triangle in the leaf
+
+    The two plane tests that start NoDivTriTriIsect() are evaluated 8 (AVX) or 4 (SSE) faces at a time on the SoA
+    layout built by ShapePolyhedron::initializeLeafTriangles(). A pair is rejected when all vertices of one triangle
+    lie further than abs_tol on the same side of the plane of the other. Only the remaining pairs are passed to
+    NoDivTriTriIsect().
+*/
+inline bool test_triangle_leaf_overlap(float U[3][3],
+                                       unsigned int mask_a,
+                                       const ShapePolyhedron& b,
+                                       unsigned int cur_node_b,
+                                       OverlapReal abs_tol)
+    {
+    unsigned int nb = b.tree.getNumParticles(cur_node_b);
+    unsigned int start = b.data.leaf_tri_ptr[cur_node_b];
+    unsigned int width = b.data.leaf_tri_ptr[cur_node_b+1] - start;
+    const float *rows = b.data.leaf_tris.get() + detail::poly3d_leaf_tri_rows*start;
+
+    // plane of U, as in NoDivTriTriIsect()
+    float E1[3] = {U[1][0]-U[0][0], U[1][1]-U[0][1], U[1][2]-U[0][2]};
+    float E2[3] = {U[2][0]-U[0][0], U[2][1]-U[0][1], U[2][2]-U[0][2]};
+    float N[3] = {E1[1]*E2[2]-E1[2]*E2[1], E1[2]*E2[0]-E1[0]*E2[2], E1[0]*E2[1]-E1[1]*E2[0]};
+    float d = -(N[0]*U[0][0]+N[1]*U[0][1]+N[2]*U[0][2]);
+    float tol = abs_tol;
+    float neg_tol = -abs_tol;
+
+    #if defined(__AVX__)
+    const unsigned int lanes = 8;
+    __m256 nx_v = _mm256_broadcast_ss(&N[0]);
+    __m256 ny_v = _mm256_broadcast_ss(&N[1]);
+    __m256 nz_v = _mm256_broadcast_ss(&N[2]);
+    __m256 d_v = _mm256_broadcast_ss(&d);
+    __m256 tol_v = _mm256_broadcast_ss(&tol);
+    __m256 neg_tol_v = _mm256_broadcast_ss(&neg_tol);
+    __m256 u_v[3][3];
+    for (unsigned int k = 0; k < 3; ++k)
+        for (unsigned int l = 0; l < 3; ++l)
+            u_v[k][l] = _mm256_broadcast_ss(&U[k][l]);
+    #else
+    const unsigned int lanes = 4;
+    __m128 nx_v = _mm_load_ps1(&N[0]);
+    __m128 ny_v = _mm_load_ps1(&N[1]);
+    __m128 nz_v = _mm_load_ps1(&N[2]);
+    __m128 d_v = _mm_load_ps1(&d);
+    __m128 tol_v = _mm_load_ps1(&tol);
+    __m128 neg_tol_v = _mm_load_ps1(&neg_tol);
+    __m128 u_v[3][3];
+    for (unsigned int k = 0; k < 3; ++k)
+        for (unsigned int l = 0; l < 3; ++l)
+            u_v[k][l] = _mm_load_ps1(&U[k][l]);
+    #endif
+
+    for (unsigned int i = 0; i < nb; i += lanes)
+        {
+        int separated;
+
+        #if defined(__AVX__)
+        // signed distances of the vertices of V to the plane of U
+        __m256 all_above = _mm256_cmp_ps(tol_v, tol_v, _CMP_EQ_OQ); // all bits set
+        __m256 all_below = all_above;
+        for (unsigned int k = 0; k < 3; ++k)
+            {
+            __m256 x_v = _mm256_load_ps(rows + (3*k)*width + i);
+            __m256 y_v = _mm256_load_ps(rows + (3*k+1)*width + i);
+            __m256 z_v = _mm256_load_ps(rows + (3*k+2)*width + i);
+            __m256 dist_v = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx_v, x_v),
+                _mm256_mul_ps(ny_v, y_v)), _mm256_mul_ps(nz_v, z_v)), d_v);
+            all_above = _mm256_and_ps(all_above, _mm256_cmp_ps(dist_v, tol_v, _CMP_GE_OQ));
+            all_below = _mm256_and_ps(all_below, _mm256_cmp_ps(dist_v, neg_tol_v, _CMP_LE_OQ));
+            }
+        separated = _mm256_movemask_ps(_mm256_or_ps(all_above, all_below));
+
+        // signed distances of the vertices of U to the planes of V
+        __m256 vnx_v = _mm256_load_ps(rows + 9*width + i);
+        __m256 vny_v = _mm256_load_ps(rows + 10*width + i);
+        __m256 vnz_v = _mm256_load_ps(rows + 11*width + i);
+        __m256 vd_v = _mm256_load_ps(rows + 12*width + i);
+        all_above = _mm256_cmp_ps(tol_v, tol_v, _CMP_EQ_OQ);
+        all_below = all_above;
+        for (unsigned int k = 0; k < 3; ++k)
+            {
+            __m256 dist_v = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vnx_v, u_v[k][0]),
+                _mm256_mul_ps(vny_v, u_v[k][1])), _mm256_mul_ps(vnz_v, u_v[k][2])), vd_v);
+            all_above = _mm256_and_ps(all_above, _mm256_cmp_ps(dist_v, tol_v, _CMP_GE_OQ));
+            all_below = _mm256_and_ps(all_below, _mm256_cmp_ps(dist_v, neg_tol_v, _CMP_LE_OQ));
+            }
+        separated |= _mm256_movemask_ps(_mm256_or_ps(all_above, all_below));
+        #else
+        // signed distances of the vertices of V to the plane of U
+        __m128 all_above = _mm_cmpeq_ps(tol_v, tol_v); // all bits set
+        __m128 all_below = all_above;
+        for (unsigned int k = 0; k < 3; ++k)
+            {
+            __m128 x_v = _mm_load_ps(rows + (3*k)*width + i);
+            __m128 y_v = _mm_load_ps(rows + (3*k+1)*width + i);
+            __m128 z_v = _mm_load_ps(rows + (3*k+2)*width + i);
+            __m128 dist_v = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx_v, x_v),
+                _mm_mul_ps(ny_v, y_v)), _mm_mul_ps(nz_v, z_v)), d_v);
+            all_above = _mm_and_ps(all_above, _mm_cmpge_ps(dist_v, tol_v));
+            all_below = _mm_and_ps(all_below, _mm_cmple_ps(dist_v, neg_tol_v));
+            }
+        separated = _mm_movemask_ps(_mm_or_ps(all_above, all_below));
+
+        // signed distances of the vertices of U to the planes of V
+        __m128 vnx_v = _mm_load_ps(rows + 9*width + i);
+        __m128 vny_v = _mm_load_ps(rows + 10*width + i);
+        __m128 vnz_v = _mm_load_ps(rows + 11*width + i);
+        __m128 vd_v = _mm_load_ps(rows + 12*width + i);
+        all_above = _mm_cmpeq_ps(tol_v, tol_v);
+        all_below = all_above;
+        for (unsigned int k = 0; k < 3; ++k)
+            {
+            __m128 dist_v = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vnx_v, u_v[k][0]),
+                _mm_mul_ps(vny_v, u_v[k][1])), _mm_mul_ps(vnz_v, u_v[k][2])), vd_v);
+            all_above = _mm_and_ps(all_above, _mm_cmpge_ps(dist_v, tol_v));
+            all_below = _mm_and_ps(all_below, _mm_cmple_ps(dist_v, neg_tol_v));
+            }
+        separated |= _mm_movemask_ps(_mm_or_ps(all_above, all_below));
+        #endif
+
+        // the remaining lanes that hold faces of the leaf get the full test
+        unsigned int candidates = ~separated & ((1u << lanes) - 1);
+        if (nb - i < lanes)
+            candidates &= (1u << (nb - i)) - 1;
+
+        while (candidates)
+            {
+            unsigned int j = i + __builtin_ctz(candidates);
+            candidates &= candidates - 1;
+
+            unsigned int jface = b.tree.getParticle(cur_node_b, j);
+            if (b.data.face_offs[jface + 1] - b.data.face_offs[jface] < 3 || !(mask_a & b.data.face_overlap[jface]))
+                continue;
+
+            float V[3][3];
+            for (unsigned int k = 0; k < 3; ++k)
+                {
+                V[k][0] = rows[(3*k)*width + j];
+                V[k][1] = rows[(3*k+1)*width + j];
+                V[k][2] = rows[(3*k+2)*width + j];
+                }
+
+            if (NoDivTriTriIsect(V[0],V[1],V[2],U[0],U[1],U[2],abs_tol))
+                return true;
+            }
+        }
+
+    return false;
+    }
+#endif
+
 /*! Test overlap in narrow phase
 
     \param dr separation vector between the particles, IN THE REFERENCE FRAME of b
@@ -572,6 +797,11 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
     unsigned int na = a.tree.getNumParticles(cur_node_a);
     unsigned int nb = b.tree.getNumParticles(cur_node_b);
 
+    #if !defined(NVCC) && defined(__SSE__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+    // triangles without a sweep radius are tested against the whole leaf at once
+    bool batched = b.data.leaf_tris.size() > 0 && !a.isSpheroPolyhedron() && !b.isSpheroPolyhedron();
+    #endif
+
     for (unsigned int i= 0; i< na; i++)
         {
         unsigned int iface = a.tree.getParticle(cur_node_a, i);
@@ -596,6 +826,15 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
                 }
             }
 
+        #if !defined(NVCC) && defined(__SSE__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+        if (batched)
+            {
+            if (nverts_a > 2 && test_triangle_leaf_overlap(U, mask_a, b, cur_node_b, abs_tol))
+                return true;
+            continue;
+            }
+        #endif
+
         // loop through faces of cur_node_b
         for (unsigned int j= 0; j< nb; j++)
             {
@@ -267,6 +267,8 @@ inline ShapePolyhedron::param_type make_poly3d_data(pybind11::list verts,pybind1
     result.tree = GPUTree(tree, exec_conf->isCUDAEnabled());
     delete [] obbs;
 
+    ShapePolyhedron::initializeLeafTriangles(result);
+
     // set the diameter
     result.convex_hull_verts.diameter = 2*(sqrt(radius_sq)+result.sweep_radius);
 
@@ -300,8 +302,9 @@ poly3d_verts make_poly3d_verts(pybind11::list verts, OverlapReal sweep_radius, b
         result.z[i] = 0;
         }
 
-    // set the diameter
+    // set the diameter and the bounding box
     result.diameter = 2*(sqrt(radius_sq) + sweep_radius);
+    result.updateOBB();
 
     return result;
     }
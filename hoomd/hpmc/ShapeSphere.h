@@ -217,6 +217,21 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return true;
     }
 
+//! Check if the oriented bounding boxes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns true if the OBBs of both shapes overlap
+
+    Shapes with a tight OBB overload this function as a cheap pre-test in the broad phase. All other shapes have no
+    OBB pre-test.
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapeA &a, const ShapeB& b)
+    {
+    return true;
+    }
+
 //! Define the general overlap function
 /*! This is just a convenient spot to put this to make sure it is defined early
     \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
@@ -232,6 +247,24 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab, const ShapeA &a, const
     return true;
     }
 
+//! Define the general overlap function with a separating axis hint
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \param sep_axis in/out separating axis in the space frame
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    Shapes tested with XenoCollide overload this function to start from the separating axis found in a previous test
+    of the same pair. All other shapes ignore the hint and leave it at zero.
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab, const ShapeA &a, const ShapeB& b, unsigned int& err,
+    vec3<OverlapReal>& sep_axis)
+    {
+    return test_overlap(r_ab, a, b, err);
+    }
+
 //! Sphere-Sphere overlap
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -212,6 +212,38 @@ DEVICE inline bool test_overlap<ShapeSpheropolygon,ShapeSpheropolygon>(const vec
                                   err);
     }
 
+//! Spheropolygon overlap test with a separating axis hint
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param sep_axis in/out separating axis in the space frame, see xenocollide_2d()
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                const ShapeSpheropolygon& a,
+                                const ShapeSpheropolygon& b,
+                                unsigned int& err,
+                                vec3<OverlapReal>& sep_axis)
+    {
+    vec2<OverlapReal> dr(r_ab.x, r_ab.y);
+    vec2<OverlapReal> n(sep_axis.x, sep_axis.y);
+
+    bool overlap = detail::xenocollide_2d(detail::SupportFuncSpheropolygon(a.verts),
+                                          detail::SupportFuncSpheropolygon(b.verts),
+                                          dr,
+                                          quat<OverlapReal>(a.orientation),
+                                          quat<OverlapReal>(b.orientation),
+                                          err,
+                                          &n);
+
+    if (!overlap)
+        sep_axis = vec3<OverlapReal>(n.x, n.y, 0);
+    return overlap;
+    }
+
 }; // end namespace hpmc
 
 #undef HOSTDEVICE
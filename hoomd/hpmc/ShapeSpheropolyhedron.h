@@ -160,28 +160,23 @@ struct ShapeSpheropolyhedron
     //! Return the bounding box of the shape in world coordinates
     DEVICE detail::AABB getAABB(const vec3<Scalar>& pos) const
         {
-        // generate a tight fitting AABB
-        // detail::SupportFuncSpheropolyhedron sfunc(verts);
-
-        // // use support function of the to determine the furthest extent in each direction
-        // quat<OverlapReal> o(orientation);
-        // vec3<OverlapReal> e_x(1,0,0);
-        // vec3<OverlapReal> e_y(0,1,0);
-        // vec3<OverlapReal> e_z(0,0,1);
-        // vec3<OverlapReal> s_x = rotate(o, sfunc(rotate(conj(o),e_x)));
-        // vec3<OverlapReal> s_y = rotate(o, sfunc(rotate(conj(o),e_y)));
-        // vec3<OverlapReal> s_z = rotate(o, sfunc(rotate(conj(o),e_z)));
-        // vec3<OverlapReal> s_neg_x = rotate(o, sfunc(rotate(conj(o),-e_x)));
-        // vec3<OverlapReal> s_neg_y = rotate(o, sfunc(rotate(conj(o),-e_y)));
-        // vec3<OverlapReal> s_neg_z = rotate(o, sfunc(rotate(conj(o),-e_z)));
-
-        // // translate out from the position by the furthest extents
-        // vec3<Scalar> upper(pos.x + s_x.x, pos.y + s_y.y, pos.z + s_z.z);
-        // vec3<Scalar> lower(pos.x + s_neg_x.x, pos.y + s_neg_y.y, pos.z + s_neg_z.z);
-
-        // return detail::AABB(lower, upper);
-        // ^^^^^^ The above method is slow, just use the bounding sphere
-        return detail::AABB(pos, verts.diameter/Scalar(2));
+        // a single pass over the rotated vertices, extended by the sweep radius
+        vec3<OverlapReal> lower, upper;
+        detail::poly3d_extents(verts, rotmat3<OverlapReal>(quat<OverlapReal>(orientation)), lower, upper);
+        vec3<OverlapReal> sweep(verts.sweep_radius, verts.sweep_radius, verts.sweep_radius);
+        return detail::AABB(pos + vec3<Scalar>(lower - sweep), pos + vec3<Scalar>(upper + sweep));
+        }
+
+    //! Return a tight fitting OBB
+    DEVICE detail::OBB getOBB(const vec3<Scalar>& pos) const
+        {
+        // the box of the vertices in the body frame, rotated with the particle
+        detail::OBB obb;
+        obb.rotation = orientation;
+        obb.center = vec3<OverlapReal>(pos) + rotate(obb.rotation, verts.obb_center);
+        obb.lengths = verts.obb_lengths
+            + vec3<OverlapReal>(verts.sweep_radius, verts.sweep_radius, verts.sweep_radius);
+        return obb;
         }
 
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
@@ -210,6 +205,20 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return (rsq*OverlapReal(4.0) <= DaDb * DaDb);
     }
 
+//! Check if the oriented bounding boxes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns true if the OBBs of both shapes overlap
+
+    \ingroup shape
+*/
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapeSpheropolyhedron& a,
+    const ShapeSpheropolyhedron &b)
+    {
+    return detail::overlap(a.getOBB(vec3<Scalar>(0,0,0)), b.getOBB(r_ab));
+    }
+
 //! Convex polyhedron overlap test
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -245,6 +254,42 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Spheropolyhedron overlap test with a separating axis hint
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param sep_axis in/out separating axis in the space frame, see xenocollide_3d()
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                 const ShapeSpheropolyhedron& a,
+                                 const ShapeSpheropolyhedron& b,
+                                 unsigned int& err,
+                                 vec3<OverlapReal>& sep_axis)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    // the axis is cached in the space frame, xenocollide works in the frame of a
+    quat<OverlapReal> qa(a.orientation);
+    vec3<OverlapReal> n = rotate(conj(qa), sep_axis);
+
+    bool overlap = xenocollide_3d(detail::SupportFuncSpheropolyhedron(a.verts),
+                                  detail::SupportFuncSpheropolyhedron(b.verts),
+                                  rotate(conj(qa), dr),
+                                  conj(qa) * quat<OverlapReal>(b.orientation),
+                                  DaDb/2.0,
+                                  err,
+                                  &n);
+
+    if (!overlap)
+        sep_axis = rotate(qa, n);
+    return overlap;
+    }
+
 }; // end namespace hpmc
 
 #undef DEVICE
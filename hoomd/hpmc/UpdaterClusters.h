@@ -13,6 +13,7 @@
 
 #include <set>
 #include <list>
+#include <unordered_map>
 
 #include "Moves.h"
 #include "HPMCCounters.h"
@@ -240,6 +241,245 @@ void Graph::addEdge(unsigned int v, unsigned int w)
     adj.insert(std::make_pair(v,w));
     adj.insert(std::make_pair(w,v));
     }
+
+#ifdef ENABLE_MPI
+//! Send lists of plain data elements to every rank
+/*! \param send_buf Elements for every destination rank
+    \param recv_buf Received elements, in the order of the source ranks (output)
+    \param recv_offset Offset of the elements of every source rank in recv_buf, with one extra entry (output)
+    \param mpi_comm The MPI communicator
+*/
+template<class T>
+void all_to_all_v(const std::vector< std::vector<T> >& send_buf, std::vector<T>& recv_buf,
+    std::vector<unsigned int>& recv_offset, const MPI_Comm mpi_comm)
+    {
+    int nranks;
+    MPI_Comm_size(mpi_comm, &nranks);
+
+    std::vector<int> send_bytes(nranks), send_displ(nranks), recv_bytes(nranks), recv_displ(nranks);
+    std::vector<T> send_flat;
+    for (int r = 0; r < nranks; ++r)
+        {
+        send_displ[r] = send_flat.size()*sizeof(T);
+        send_bytes[r] = send_buf[r].size()*sizeof(T);
+        send_flat.insert(send_flat.end(), send_buf[r].begin(), send_buf[r].end());
+        }
+
+    MPI_Alltoall(&send_bytes.front(), 1, MPI_INT, &recv_bytes.front(), 1, MPI_INT, mpi_comm);
+
+    recv_offset.resize(nranks+1);
+    unsigned int n_recv = 0;
+    for (int r = 0; r < nranks; ++r)
+        {
+        recv_offset[r] = n_recv;
+        recv_displ[r] = n_recv*sizeof(T);
+        n_recv += recv_bytes[r]/sizeof(T);
+        }
+    recv_offset[nranks] = n_recv;
+
+    // the buffers must not be empty to take their address
+    send_flat.resize(std::max(send_flat.size(), (size_t)1));
+    recv_buf.resize(std::max(n_recv, 1u));
+
+    MPI_Alltoallv(&send_flat.front(), &send_bytes.front(), &send_displ.front(), MPI_BYTE,
+        &recv_buf.front(), &recv_bytes.front(), &recv_displ.front(), MPI_BYTE, mpi_comm);
+
+    recv_buf.resize(n_recv);
+    }
+
+//! Old state of a particle during a distributed cluster move
+struct cluster_ptl_old
+    {
+    Scalar4 postype;            //!< Position and type before the move
+    Scalar4 orientation;        //!< Orientation before the move
+    int3 image;                 //!< Image before the move
+    unsigned int reject;        //!< Non-zero if the particle leaves the active region
+    };
+
+//! A particle sent to a different rank during a distributed cluster move, together with its old state
+struct cluster_migrate_element
+    {
+    pdata_element ptl;          //!< The particle data
+    cluster_ptl_old old;        //!< State before the move
+    };
+
+//! Partial sums over a cluster, collected on every rank
+struct cluster_stats
+    {
+    unsigned int label;         //!< Label of the cluster
+    unsigned int reject;        //!< Non-zero if the cluster move is rejected
+    int delta_n;                //!< n_B_new - n_A_new - n_B_old + n_A_old for type swap moves
+    };
+
+//! Contribution to the change in patch energy of a particle pair
+struct cluster_pair_energy
+    {
+    unsigned int i;             //!< Tag of the first particle
+    unsigned int j;             //!< Tag of the second particle
+    float U;                    //!< Energy contribution
+    };
+
+//! Labels the connected components of a graph that is distributed over all ranks
+/*! Every rank adds the edges it knows about with addEdge(), and the nodes without edges with addNode(). Nodes are
+    identified by global particle tags. The components are first found on every rank with a union-find. connect()
+    then labels the components globally with the smallest tag they contain.
+
+    Nodes that are known on more than one rank are coordinated by a directory rank, tag % nranks, which is found
+    without communication. In every round, each rank sends the current label of the local component of its shared
+    nodes to their directory, which returns the smallest label received. The rounds stop once no label changes on
+    any rank. Only the shared nodes are communicated after the first round.
+*/
+class DistributedUnionFind
+    {
+    public:
+        //! Add a node, if not present
+        void addNode(unsigned int v)
+            {
+            find(v);
+            }
+
+        //! Connect two nodes
+        void addEdge(unsigned int v, unsigned int w)
+            {
+            unsigned int root_v = find(v);
+            unsigned int root_w = find(w);
+
+            // the smaller tag is the root, so that a root is also the initial label of the component
+            if (root_v < root_w)
+                m_parent[root_w] = root_v;
+            else if (root_w < root_v)
+                m_parent[root_v] = root_w;
+            }
+
+        //! Label the components globally (collective call)
+        inline void connect(const MPI_Comm mpi_comm);
+
+        //! Get the global label of a node
+        /*! \param v The node, which needs to be added before connect()
+        */
+        unsigned int getLabel(unsigned int v)
+            {
+            unsigned int root = find(v);
+            auto it = m_label.find(root);
+            return (it != m_label.end()) ? it->second : root;
+            }
+
+    private:
+        std::unordered_map<unsigned int, unsigned int> m_parent;  //!< Parent of every node in the local union-find
+        std::unordered_map<unsigned int, unsigned int> m_label;   //!< Global label of the local roots, if not the root
+
+        //! Find the local root of a node, and compress the path
+        unsigned int find(unsigned int v)
+            {
+            auto it = m_parent.find(v);
+            if (it == m_parent.end())
+                {
+                m_parent.insert(std::make_pair(v,v));
+                return v;
+                }
+
+            unsigned int root = v;
+            while (m_parent[root] != root)
+                root = m_parent[root];
+
+            while (v != root)
+                {
+                unsigned int next = m_parent[v];
+                m_parent[v] = root;
+                v = next;
+                }
+            return root;
+            }
+    };
+
+void DistributedUnionFind::connect(const MPI_Comm mpi_comm)
+    {
+    int nranks;
+    MPI_Comm_size(mpi_comm, &nranks);
+
+    // register all nodes with their directory
+    std::vector< std::vector<unsigned int> > send_nodes(nranks);
+    for (auto it = m_parent.begin(); it != m_parent.end(); ++it)
+        send_nodes[it->first % nranks].push_back(it->first);
+
+    std::vector<unsigned int> dir_nodes;
+    std::vector<unsigned int> dir_offset;
+    all_to_all_v(send_nodes, dir_nodes, dir_offset, mpi_comm);
+
+    // nodes registered by more than one rank are shared
+    std::unordered_map<unsigned int, unsigned int> n_ranks_node;
+    for (auto it = dir_nodes.begin(); it != dir_nodes.end(); ++it)
+        n_ranks_node[*it]++;
+
+    // the directory keeps the shared nodes of every rank, and returns them in the same order
+    std::vector< std::vector<unsigned int> > dir_shared(nranks);
+    for (int r = 0; r < nranks; ++r)
+        for (unsigned int k = dir_offset[r]; k < dir_offset[r+1]; ++k)
+            if (n_ranks_node[dir_nodes[k]] > 1)
+                dir_shared[r].push_back(dir_nodes[k]);
+
+    std::vector<unsigned int> shared;
+    std::vector<unsigned int> shared_offset;
+    all_to_all_v(dir_shared, shared, shared_offset, mpi_comm);
+
+    std::vector< std::vector<unsigned int> > send_labels(nranks);
+    std::vector< std::vector<unsigned int> > dir_min_labels(nranks);
+    std::vector<unsigned int> recv_labels;
+    std::vector<unsigned int> recv_offset;
+    std::unordered_map<unsigned int, unsigned int> dir_min;
+
+    bool changed = true;
+    while (changed)
+        {
+        // send the label of the local component of every shared node, in the order of the directory
+        for (int r = 0; r < nranks; ++r)
+            {
+            send_labels[r].clear();
+            for (unsigned int k = shared_offset[r]; k < shared_offset[r+1]; ++k)
+                send_labels[r].push_back(getLabel(shared[k]));
+            }
+        all_to_all_v(send_labels, recv_labels, recv_offset, mpi_comm);
+
+        // the directory finds the smallest label of every shared node
+        dir_min.clear();
+        for (int r = 0; r < nranks; ++r)
+            {
+            for (unsigned int k = recv_offset[r]; k < recv_offset[r+1]; ++k)
+                {
+                unsigned int v = dir_shared[r][k - recv_offset[r]];
+                auto it = dir_min.find(v);
+                if (it == dir_min.end())
+                    dir_min.insert(std::make_pair(v, recv_labels[k]));
+                else
+                    it->second = std::min(it->second, recv_labels[k]);
+                }
+            }
+
+        for (int r = 0; r < nranks; ++r)
+            {
+            dir_min_labels[r].clear();
+            for (auto it = dir_shared[r].begin(); it != dir_shared[r].end(); ++it)
+                dir_min_labels[r].push_back(dir_min[*it]);
+            }
+        all_to_all_v(dir_min_labels, recv_labels, recv_offset, mpi_comm);
+
+        // lower the labels of the local components
+        unsigned int n_changed = 0;
+        for (unsigned int k = 0; k < shared.size(); ++k)
+            {
+            unsigned int root = find(shared[k]);
+            if (recv_labels[k] < getLabel(root))
+                {
+                m_label[root] = recv_labels[k];
+                n_changed++;
+                }
+            }
+
+        MPI_Allreduce(MPI_IN_PLACE, &n_changed, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        changed = n_changed > 0;
+        }
+    }
+#endif
 } // end namespace detail
 
 /*! A generic cluster move for attractive interactions.
@@ -403,14 +643,15 @@ class UpdaterClusters : public Updater
                 #ifdef ENABLE_MPI
                 if (m_pdata->getDomainDecomposition())
                     {
-                    bcast(result.pivot_accept_count,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.reflection_accept_count,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.swap_accept_count,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.pivot_reject_count,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.reflection_reject_count,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.swap_reject_count,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.n_clusters,0,m_exec_conf->getMPICommunicator());
-                    bcast(result.n_particles_in_clusters,0,m_exec_conf->getMPICommunicator());
+                    // every rank counts the moves of its own particles
+                    MPI_Allreduce(MPI_IN_PLACE, &result.pivot_accept_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.reflection_accept_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.swap_accept_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.pivot_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.reflection_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.swap_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.n_clusters, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+                    MPI_Allreduce(MPI_IN_PLACE, &result.n_particles_in_clusters, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
                     }
                 #endif
 
@@ -487,11 +728,33 @@ class UpdaterClusters : public Updater
             \param pivot The current pivot point
             \param q The current line reflection axis
             \param line True if this is a line reflection
-            \param map Map to lookup new tag from old tag
+            \param map Map to lookup new tag from old tag, empty if the tags do not change
         */
         virtual void findInteractions(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q, bool swap,
             bool line, const std::map<unsigned int, unsigned int>& map);
 
+        //! Look up the new tag of a particle
+        /*! \param map Map to lookup new tag from old tag, empty if the tags do not change
+            \param tag The old tag
+        */
+        static unsigned int lookupTag(const std::map<unsigned int, unsigned int>& map, unsigned int tag)
+            {
+            if (map.empty())
+                return tag;
+
+            auto it = map.find(tag);
+            assert(it != map.end());
+            return it->second;
+            }
+
+        #ifdef ENABLE_MPI
+        //! Perform the cluster move with domain decomposition, without a global snapshot
+        void updateDistributed(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q, bool swap, bool line);
+
+        //! Send every local particle to the rank whose domain contains it
+        void migrateToOwners(std::unordered_map<unsigned int, detail::cluster_ptl_old> *old_state);
+        #endif
+
         //! Helper function to get interaction range
         virtual Scalar getNominalWidth()
             {
@@ -638,19 +901,9 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                 if (rsq_ij <= rcut_ij*rcut_ij)
                                     {
                                     // the particle pair
-                                    unsigned int new_tag_i;
-                                        {
-                                        auto it = map.find(m_tag_backup[i]);
-                                        assert(it != map.end());
-                                        new_tag_i = it->second;
-                                        }
+                                    unsigned int new_tag_i = lookupTag(map, m_tag_backup[i]);
 
-                                    unsigned int new_tag_j;
-                                        {
-                                        auto it = map.find(m_tag_backup[j]);
-                                        assert(it!=map.end());
-                                        new_tag_j = it->second;
-                                        }
+                                    unsigned int new_tag_j = lookupTag(map, m_tag_backup[j]);
                                     auto p = std::make_pair(new_tag_i,new_tag_j);
 
                                     // if particle interacts in different image already, add to that energy
@@ -745,12 +998,7 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                             // read in its position and orientation
                             unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                            unsigned int new_tag_j;
-                                {
-                                auto it = map.find(m_tag_backup[j]);
-                                assert(it != map.end());
-                                new_tag_j = it->second;
-                                }
+                            unsigned int new_tag_j = lookupTag(map, m_tag_backup[j]);
 
                             if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
 
@@ -835,12 +1083,7 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                 // read in its position and orientation
                                 unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                                unsigned int new_tag_j;
-                                    {
-                                    auto it = map.find(m_tag_backup[j]);
-                                    assert(it != map.end());
-                                    new_tag_j = it->second;
-                                    }
+                                unsigned int new_tag_j = lookupTag(map, m_tag_backup[j]);
 
                                 if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
 
@@ -1131,9 +1374,20 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
             }
         }
 
-    SnapshotParticleData<Scalar> snap(m_pdata->getNGlobal());
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        if (m_prof) m_prof->pop(m_exec_conf);
+
+        // every rank moves its own particles
+        updateDistributed(timestep, pivot, q, swap, line);
+
+        if (m_prof) m_prof->pop(m_exec_conf);
+        return;
+        }
+    #endif
 
-    // obtain particle data from all ranks
+    SnapshotParticleData<Scalar> snap(m_pdata->getNGlobal());
 
     // save origin information
     Scalar3 origin = m_pdata->getOrigin();
@@ -1145,15 +1399,6 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
     m_pdata->resetOrigin();
     auto map = m_pdata->takeSnapshot(snap);
 
-    #ifdef ENABLE_MPI
-    if (m_comm)
-        {
-        // we need the particle tag -> snapshot idx map on all ranks
-        bcast(map, 0, m_exec_conf->getMPICommunicator());
-        }
-    #endif
-
-
     // transform all particles on rank zero
     bool master = !m_exec_conf->getRank();
 
@@ -1251,51 +1496,6 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
 
     if (m_prof) m_prof->push(m_exec_conf,"Move");
 
-    // collect interactions on rank 0
-    #ifndef ENABLE_TBB
-    std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_overlap;
-    std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_interact_old_old;
-    std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_interact_new_old;
-    std::vector< std::set<std::pair<unsigned int, unsigned int> > > all_interact_new_new;
-    std::vector< std::set<unsigned int> > all_local_reject;
-
-    std::vector< std::map<std::pair<unsigned int, unsigned int>, float> > all_energy_old_old;
-    std::vector< std::map<std::pair<unsigned int, unsigned int>, float> > all_energy_new_old;
-    #else
-    std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_overlap;
-    std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_interact_old_old;
-    std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_interact_new_old;
-    std::vector< tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > > all_interact_new_new;
-    std::vector< tbb::concurrent_unordered_set<unsigned int> > all_local_reject;
-
-    std::vector< tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>, float> > all_energy_old_old;
-    std::vector< tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>, float> > all_energy_new_old;
-    #endif
-
-    #ifdef ENABLE_MPI
-    if (m_comm)
-        {
-        // combine lists from different ranks
-        gather_v(m_overlap, all_overlap, 0, m_exec_conf->getMPICommunicator());
-        gather_v(m_interact_old_old, all_interact_old_old, 0, m_exec_conf->getMPICommunicator());
-        gather_v(m_interact_new_old, all_interact_new_old, 0, m_exec_conf->getMPICommunicator());
-        gather_v(m_interact_new_new, all_interact_new_new, 0, m_exec_conf->getMPICommunicator());
-        gather_v(m_local_reject, all_local_reject, 0, m_exec_conf->getMPICommunicator());
-        }
-    #endif
-
-    if (m_mc->getPatchInteraction())
-        {
-        // collect energies on rank 0
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            gather_v(m_energy_old_old, all_energy_old_old, 0, m_exec_conf->getMPICommunicator());
-            gather_v(m_energy_new_old, all_energy_new_old, 0, m_exec_conf->getMPICommunicator());
-            }
-        #endif
-        }
-
     if (this->m_prof)
         this->m_prof->push("fill");
 
@@ -1312,87 +1512,16 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
         if (m_prof)
             m_prof->pop();
 
-
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            // complete the list of rejected particles
-            for (auto it_i = all_local_reject.begin(); it_i != all_local_reject.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    m_ptl_reject.insert(*it_j);
-                    }
-                }
-            }
-        #endif
-
         if (line && !swap)
             {
             if (m_prof)
                 m_prof->push("new new");
 
-            #ifdef ENABLE_MPI
-            if (m_comm)
-                {
-                for (auto it_i = all_interact_new_new.begin(); it_i != all_interact_new_new.end(); ++it_i)
-                    {
-                    for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                        {
-                        unsigned int i = it_j->first;
-                        unsigned int j = it_j->second;
-
-                        m_G.addEdge(i, j);
-                        }
-                    }
-                }
-            else
-            #endif
-                {
-                #ifdef ENABLE_TBB
-                tbb::parallel_for(m_interact_new_new.range(), [&] (decltype(m_interact_new_new.range()) r)
-                #else
-                auto &r = m_interact_new_new;
-                #endif
-                    {
-                    for (auto it = r.begin(); it != r.end(); ++it)
-                        {
-                        unsigned int i = it->first;
-                        unsigned int j = it->second;
-
-                        m_G.addEdge(i,j);
-                        }
-                    }
-                #ifdef ENABLE_TBB
-                    );
-                #endif
-                }
-
-            if (m_prof)
-                m_prof->pop();
-            }
-
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            for (auto it_i = all_interact_new_old.begin(); it_i != all_interact_new_old.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i, j);
-                    }
-                }
-            }
-        else
-        #endif
             {
             #ifdef ENABLE_TBB
-            tbb::parallel_for(m_interact_new_old.range(), [&] (decltype(m_interact_new_old.range()) r)
+            tbb::parallel_for(m_interact_new_new.range(), [&] (decltype(m_interact_new_new.range()) r)
             #else
-            auto &r = m_interact_new_old;
+            auto &r = m_interact_new_new;
             #endif
                 {
                 for (auto it = r.begin(); it != r.end(); ++it)
@@ -1408,122 +1537,97 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
             #endif
             }
 
+            if (m_prof)
+                m_prof->pop();
+            }
 
-        if (m_prof)
-            m_prof->push("overlap");
-
-        #ifdef ENABLE_MPI
-        if (m_comm)
+        {
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(m_interact_new_old.range(), [&] (decltype(m_interact_new_old.range()) r)
+        #else
+        auto &r = m_interact_new_old;
+        #endif
             {
-            for (auto it_i = all_overlap.begin(); it_i != all_overlap.end(); ++it_i)
+            for (auto it = r.begin(); it != r.end(); ++it)
                 {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
+                unsigned int i = it->first;
+                unsigned int j = it->second;
 
-                    m_G.addEdge(i,j);
-                    }
+                m_G.addEdge(i,j);
                 }
             }
-        else
+        #ifdef ENABLE_TBB
+            );
+        #endif
+        }
+
+        if (m_prof)
+            m_prof->push("overlap");
+
+        {
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
+        #else
+        auto &r = m_overlap;
         #endif
             {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
-            #else
-            auto &r = m_overlap;
-            #endif
+            for (auto it = r.begin(); it != r.end(); ++it)
                 {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
+                unsigned int i = it->first;
+                unsigned int j = it->second;
 
-                    m_G.addEdge(i,j);
-                    }
+                m_G.addEdge(i,j);
                 }
-            #ifdef ENABLE_TBB
-                );
-            #endif
             }
+        #ifdef ENABLE_TBB
+            );
+        #endif
+        }
 
         if (m_prof)
             m_prof->pop();
 
 
         // interactions due to hard depletant-excluded volume overlaps (not used in base class)
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            for (auto it_i = all_interact_old_old.begin(); it_i != all_interact_old_old.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i, j);
-                    }
-                }
-            }
-        else
+        {
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(m_interact_old_old.range(), [&] (decltype(m_interact_old_old.range()) r)
+        #else
+        auto &r = m_interact_old_old;
         #endif
             {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_interact_old_old.range(), [&] (decltype(m_interact_old_old.range()) r)
-            #else
-            auto &r = m_interact_old_old;
-            #endif
+            for (auto it = r.begin(); it != r.end(); ++it)
                 {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
+                unsigned int i = it->first;
+                unsigned int j = it->second;
 
-                    m_G.addEdge(i,j);
-                    }
+                m_G.addEdge(i,j);
                 }
-            #ifdef ENABLE_TBB
-                );
-            #endif
             }
+        #ifdef ENABLE_TBB
+            );
+        #endif
+        }
 
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            for (auto it_i = all_interact_new_old.begin(); it_i != all_interact_new_old.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i, j);
-                    }
-                }
-            }
-        else
+        {
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(m_interact_new_old.range(), [&] (decltype(m_interact_new_old.range()) r)
+        #else
+        auto &r = m_interact_new_old;
         #endif
             {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_interact_new_old.range(), [&] (decltype(m_interact_new_old.range()) r)
-            #else
-            auto &r = m_interact_new_old;
-            #endif
+            for (auto it = r.begin(); it != r.end(); ++it)
                 {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
+                unsigned int i = it->first;
+                unsigned int j = it->second;
 
-                    m_G.addEdge(i,j);
-                    }
+                m_G.addEdge(i,j);
                 }
-            #ifdef ENABLE_TBB
-                );
-            #endif
             }
+        #ifdef ENABLE_TBB
+            );
+        #endif
+        }
 
         if (m_mc->getPatchInteraction())
             {
@@ -1534,93 +1638,38 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
             std::map< std::pair<unsigned int, unsigned int>, float> delta_U;
             #endif
 
-            #ifdef ENABLE_MPI
-            if (m_comm)
+            for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
                 {
-                for (auto it_i = all_energy_old_old.begin(); it_i != all_energy_old_old.end(); ++it_i)
-                    {
-                    for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                        {
-                        float delU = -it_j->second;
-                        unsigned int i = it_j->first.first;
-                        unsigned int j = it_j->first.second;
+                float delU = -it->second;
+                unsigned int i = it->first.first;
+                unsigned int j = it->first.second;
 
-                        auto p = std::make_pair(i,j);
+                auto p = std::make_pair(i,j);
 
-                        // add to energy
-                        auto it = delta_U.find(p);
-                        if (it != delta_U.end())
-                            delU += it->second;
+                // add to energy
+                auto itj = delta_U.find(p);
+                if (itj != delta_U.end())
+                    delU += itj->second;
 
-                        // update map with new interaction energy
-                        delta_U[p] = delU;
-                        }
-                    }
+                // update map with new interaction energy
+                delta_U[p] = delU;
                 }
-            else
-            #endif
-                {
-                for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
-                    {
-                    float delU = -it->second;
-                    unsigned int i = it->first.first;
-                    unsigned int j = it->first.second;
-
-                    auto p = std::make_pair(i,j);
 
-                    // add to energy
-                    auto itj = delta_U.find(p);
-                    if (itj != delta_U.end())
-                        delU += itj->second;
-
-                    // update map with new interaction energy
-                    delta_U[p] = delU;
-                    }
-                }
-
-            #ifdef ENABLE_MPI
-            if (m_comm)
+            for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
                 {
-                for (auto it_i = all_energy_new_old.begin(); it_i != all_energy_new_old.end(); ++it_i)
-                    {
-                    for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                        {
-                        float delU = it_j->second;
-                        unsigned int i = it_j->first.first;
-                        unsigned int j = it_j->first.second;
+                float delU = it->second;
+                unsigned int i = it->first.first;
+                unsigned int j = it->first.second;
 
-                        // consider each pair uniquely
-                        auto p = std::make_pair(i,j);
+                auto p = std::make_pair(i,j);
 
-                        // add to energy
-                        auto it = delta_U.find(p);
-                        if (it != delta_U.end())
-                            delU += it->second;
+                // add to energy
+                auto itj = delta_U.find(p);
+                if (itj != delta_U.end())
+                    delU += itj->second;
 
-                        // update map with new interaction energy
-                        delta_U[p] = delU;
-                        }
-                    }
-                }
-            else
-            #endif
-                {
-                for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
-                    {
-                    float delU = it->second;
-                    unsigned int i = it->first.first;
-                    unsigned int j = it->first.second;
-
-                    auto p = std::make_pair(i,j);
-
-                    // add to energy
-                    auto itj = delta_U.find(p);
-                    if (itj != delta_U.end())
-                        delU += itj->second;
-
-                    // update map with new interaction energy
-                    delta_U[p] = delU;
-                    }
+                // update map with new interaction energy
+                delta_U[p] = delU;
                 }
 
             #ifdef ENABLE_TBB
@@ -1670,13 +1719,8 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
             bool reject = false;
             for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
                 {
-                bool mpi = false;
-                #ifdef ENABLE_MPI
-                mpi = (bool)m_comm;
-                if (mpi && m_ptl_reject.find(*it) != m_ptl_reject.end())
-                    reject = true;
-                #endif
-                if (!mpi && m_local_reject.find(*it) != m_local_reject.end())
+                if (m_local_reject.find(*it) != m_local_reject.end()
+                    || m_ptl_reject.find(*it) != m_ptl_reject.end())
                     reject = true;
                 }
 
@@ -1775,18 +1819,13 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
     if (this->m_prof) this->m_prof->pop();
     if (m_prof) m_prof->pop(m_exec_conf);
 
-    // in MPI and GPU simulations the integrator takes care of the grid shift
+    // in GPU simulations the integrator takes care of the grid shift
     bool grid_shift = true;
     #ifdef ENABLE_CUDA
     if (m_exec_conf->isCUDAEnabled())
         grid_shift = false;
     #endif
 
-    #ifdef ENABLE_MPI
-    if (m_comm)
-        grid_shift = false;
-    #endif
-
     if (grid_shift)
         {
         if (m_prof) m_prof->push(m_exec_conf,"Grid shift");
@@ -1831,6 +1870,420 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
     }
 
 
+#ifdef ENABLE_MPI
+/*! \param old_state Old state of the local particles, sent along with the particles (may be NULL)
+
+    Unlike Communicator::migrateParticles(), particles may be sent to any rank, not only to the neighbors.
+*/
+template< class Shape >
+void UpdaterClusters<Shape>::migrateToOwners(std::unordered_map<unsigned int, detail::cluster_ptl_old> *old_state)
+    {
+    if (m_prof) m_prof->push(m_exec_conf,"migrate");
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int nranks = m_exec_conf->getNRanks();
+    unsigned int my_rank = m_exec_conf->getRank();
+
+    // ghosts are exchanged again afterwards
+    m_pdata->removeAllGhostParticles();
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+
+    // flag all particles that leave this rank, in the order in which they are removed
+    std::vector<unsigned int> dest_rank;
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_comm_flags(m_pdata->getCommFlags(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            Scalar3 pos = make_scalar3(h_postype.data[i].x, h_postype.data[i].y, h_postype.data[i].z);
+            unsigned int rank = decomposition->placeParticle(global_box, pos, h_cart_ranks.data);
+
+            h_comm_flags.data[i] = (rank != my_rank);
+            if (rank != my_rank)
+                dest_rank.push_back(rank);
+            }
+        }
+
+    std::vector<pdata_element> out;
+    std::vector<unsigned int> comm_flags_out;
+    m_pdata->removeParticles(out, comm_flags_out);
+
+    std::vector< std::vector<detail::cluster_migrate_element> > send_buf(nranks);
+    for (unsigned int k = 0; k < out.size(); ++k)
+        {
+        detail::cluster_migrate_element e;
+        e.ptl = out[k];
+        if (old_state)
+            {
+            auto it = old_state->find(out[k].tag);
+            assert(it != old_state->end());
+            e.old = it->second;
+            old_state->erase(it);
+            }
+        send_buf[dest_rank[k]].push_back(e);
+        }
+
+    std::vector<detail::cluster_migrate_element> recv_buf;
+    std::vector<unsigned int> recv_offset;
+    detail::all_to_all_v(send_buf, recv_buf, recv_offset, mpi_comm);
+
+    std::vector<pdata_element> in(recv_buf.size());
+    for (unsigned int k = 0; k < recv_buf.size(); ++k)
+        {
+        in[k] = recv_buf[k].ptl;
+        if (old_state)
+            (*old_state)[in[k].tag] = recv_buf[k].old;
+        }
+    m_pdata->addParticles(in);
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+/*! \param timestep Current time step of the simulation
+    \param pivot The pivot point
+    \param q The line reflection axis
+    \param swap True if this is a type swap move
+    \param line True if this is a line reflection
+
+    Every rank transforms its local particles, which are then sent to the ranks owning their new positions. The
+    interactions are found with the local AABB trees and ghosts, and the clusters are labeled with a
+    detail::DistributedUnionFind. All random numbers of a cluster are drawn from a generator seeded with its label,
+    so that all ranks agree on its fate without further communication. Rejected clusters are moved back to their
+    old positions and ranks.
+*/
+template< class Shape >
+void UpdaterClusters<Shape>::updateDistributed(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q,
+    bool swap, bool line)
+    {
+    if (m_prof) m_prof->push(m_exec_conf,"Transform");
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int nranks = m_exec_conf->getNRanks();
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+
+    // compute the width of the active region
+    Scalar nominal_width = this->getNominalWidth();
+    Scalar3 range = nominal_width / box.getNearestPlaneDistance();
+
+    if (m_sysdef->getNDimensions() == 2)
+        {
+        // no interaction along z
+        range.z = 0;
+        }
+
+    // moves may not cross the global boundary along decomposed directions
+    BoxDim global_box_nonperiodic = box;
+    global_box_nonperiodic.setPeriodic(m_pdata->getBox().getPeriodic());
+
+    // store old locality data, before the particles are modified
+    m_aabb_tree_old = m_mc->buildAABBTree();
+
+    // transform the local particles, and remember their old state
+    std::unordered_map<unsigned int, detail::cluster_ptl_old> old_state;
+        {
+        auto& params = m_mc->getParams();
+
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        old_state.reserve(m_pdata->getN());
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            detail::cluster_ptl_old& old = old_state[h_tag.data[i]];
+            old.postype = h_postype.data[i];
+            old.orientation = h_orientation.data[i];
+            old.image = h_image.data[i];
+            old.reject = 0;
+
+            vec3<Scalar> pos(h_postype.data[i]);
+            quat<Scalar> orientation(h_orientation.data[i]);
+            unsigned int type = __scalar_as_int(h_postype.data[i].w);
+
+            if (swap)
+                {
+                // swap move
+                if (type == m_ab_types[0])
+                    type = m_ab_types[1];
+                else if (type == m_ab_types[1])
+                    type = m_ab_types[0];
+                }
+            else
+                {
+                // if the particle falls outside the active volume of global_box_nonperiodic, reject
+                if (!isActive(vec_to_scalar3(pos), global_box_nonperiodic, range))
+                    old.reject = 1;
+
+                if (!line)
+                    {
+                    // point reflection
+                    pos = pivot-(pos-pivot);
+                    }
+                else
+                    {
+                    // line reflection
+                    pos = lineReflection(pos, pivot, q);
+                    Shape shape_i(orientation, params[type]);
+                    if (shape_i.hasOrientation())
+                        orientation = q*orientation;
+                    }
+
+                // reject if outside active volume of box at new position
+                if (!isActive(vec_to_scalar3(pos), global_box_nonperiodic, range))
+                    old.reject = 1;
+
+                // wrap particle back into box
+                h_image.data[i] = box.getImage(pos);
+                pos = box.shift(pos,-h_image.data[i]);
+                }
+
+            h_postype.data[i] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+            h_orientation.data[i] = quat_to_scalar4(orientation);
+            }
+        }
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+
+    // send the particles to the ranks owning their new positions
+    migrateToOwners(&old_state);
+
+    // update ghosts & signal that AABB tree is invalid
+    m_mc->communicate(true);
+
+    // determine which particles interact, the tags are unchanged
+    findInteractions(timestep, pivot, q, swap, line, std::map<unsigned int, unsigned int>());
+
+    if (m_prof) m_prof->push(m_exec_conf,"Move");
+    if (m_prof) m_prof->push("connected components");
+
+    detail::DistributedUnionFind uf;
+
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            uf.addNode(h_tag.data[i]);
+        }
+
+    if (line && !swap)
+        {
+        for (auto it = m_interact_new_new.begin(); it != m_interact_new_new.end(); ++it)
+            uf.addEdge(it->first, it->second);
+        }
+
+    for (auto it = m_interact_new_old.begin(); it != m_interact_new_old.end(); ++it)
+        uf.addEdge(it->first, it->second);
+
+    for (auto it = m_overlap.begin(); it != m_overlap.end(); ++it)
+        uf.addEdge(it->first, it->second);
+
+    // interactions due to hard depletant-excluded volume overlaps (not used in base class)
+    for (auto it = m_interact_old_old.begin(); it != m_interact_old_old.end(); ++it)
+        uf.addEdge(it->first, it->second);
+
+    // the clusters of rejected particles are rejected
+    for (auto it = m_local_reject.begin(); it != m_local_reject.end(); ++it)
+        uf.addNode(*it);
+
+    if (m_mc->getPatchInteraction())
+        {
+        // the old and new energy of a pair are found on different ranks, sum them up on rank i % nranks
+        std::vector< std::vector<detail::cluster_pair_energy> > send_energy(nranks);
+        for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
+            {
+            detail::cluster_pair_energy e = {it->first.first, it->first.second, -it->second};
+            send_energy[e.i % nranks].push_back(e);
+            }
+        for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
+            {
+            detail::cluster_pair_energy e = {it->first.first, it->first.second, it->second};
+            send_energy[e.i % nranks].push_back(e);
+            }
+
+        std::vector<detail::cluster_pair_energy> recv_energy;
+        std::vector<unsigned int> recv_offset;
+        detail::all_to_all_v(send_energy, recv_energy, recv_offset, mpi_comm);
+
+        std::map< std::pair<unsigned int, unsigned int>, float> delta_U;
+        for (auto it = recv_energy.begin(); it != recv_energy.end(); ++it)
+            delta_U[std::make_pair(it->i, it->j)] += it->U;
+
+        for (auto it = delta_U.begin(); it != delta_U.end(); ++it)
+            {
+            float delU = it->second;
+            unsigned int i = it->first.first;
+            unsigned int j = it->first.second;
+
+            // create a RNG specific to this particle pair
+            hoomd::RandomGenerator rng_ij(hoomd::RNGIdentifier::UpdaterClustersPairwise, this->m_seed, timestep, std::min(i,j), std::max(i,j));
+
+            float pij = 1.0f-exp(-delU);
+            if (hoomd::detail::generate_canonical<float>(rng_ij) <= pij) // GCA
+                {
+                // add bond
+                uf.addEdge(i,j);
+                }
+            }
+        }
+
+    // compute connected components
+    uf.connect(mpi_comm);
+
+    if (m_prof) m_prof->pop();
+    if (m_prof) m_prof->push("reject");
+
+    // collect the rejection flags and the change in the number of A and B particles of every cluster
+    std::unordered_map<unsigned int, detail::cluster_stats> stats;
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            unsigned int label = uf.getLabel(h_tag.data[i]);
+            const detail::cluster_ptl_old& old = old_state[h_tag.data[i]];
+
+            detail::cluster_stats& s = stats[label];
+            s.label = label;
+            s.reject |= old.reject;
+
+            if (swap && m_ab_types.size())
+                {
+                unsigned int type_new = __scalar_as_int(h_postype.data[i].w);
+                unsigned int type_old = __scalar_as_int(old.postype.w);
+                s.delta_n += (type_new == m_ab_types[1]) - (type_new == m_ab_types[0])
+                    - (type_old == m_ab_types[1]) + (type_old == m_ab_types[0]);
+                }
+            }
+        }
+
+    for (auto it = m_local_reject.begin(); it != m_local_reject.end(); ++it)
+        {
+        unsigned int label = uf.getLabel(*it);
+        detail::cluster_stats& s = stats[label];
+        s.label = label;
+        s.reject = 1;
+        }
+
+    // combine the partial sums of every cluster on rank label % nranks
+    std::vector< std::vector<detail::cluster_stats> > send_stats(nranks);
+    for (auto it = stats.begin(); it != stats.end(); ++it)
+        send_stats[it->first % nranks].push_back(it->second);
+
+    std::vector<detail::cluster_stats> recv_stats;
+    std::vector<unsigned int> recv_offset;
+    detail::all_to_all_v(send_stats, recv_stats, recv_offset, mpi_comm);
+
+    std::unordered_map<unsigned int, detail::cluster_stats> total_stats;
+    for (auto it = recv_stats.begin(); it != recv_stats.end(); ++it)
+        {
+        detail::cluster_stats& s = total_stats[it->label];
+        s.label = it->label;
+        s.reject |= it->reject;
+        s.delta_n += it->delta_n;
+        }
+
+    // every cluster is counted once, on the rank that combines its sums
+    m_count_total.n_clusters += total_stats.size();
+
+    // return the totals in the order they were received
+    for (unsigned int r = 0; r < nranks; ++r)
+        {
+        send_stats[r].clear();
+        for (unsigned int k = recv_offset[r]; k < recv_offset[r+1]; ++k)
+            send_stats[r].push_back(total_stats[recv_stats[k].label]);
+        }
+    detail::all_to_all_v(send_stats, recv_stats, recv_offset, mpi_comm);
+
+    // decide on every cluster with a RNG specific to it
+    std::unordered_map<unsigned int, unsigned int> accept;
+    for (auto it = recv_stats.begin(); it != recv_stats.end(); ++it)
+        {
+        hoomd::RandomGenerator rng_cluster(hoomd::RNGIdentifier::UpdaterClustersCluster, this->m_seed, timestep, it->label);
+
+        bool flip = hoomd::detail::generate_canonical<float>(rng_cluster) <= m_flip_probability;
+        bool reject = it->reject;
+
+        if (swap && m_ab_types.size())
+            {
+            Scalar NdelMu = 0.5*(Scalar)it->delta_n*m_delta_mu;
+
+            if (hoomd::detail::generate_canonical<float>(rng_cluster) > exp(NdelMu))
+                reject = true;
+            }
+
+        // 0: not flipped, 1: flipped and rejected, 2: flipped and accepted
+        accept[it->label] = flip ? (reject ? 1 : 2) : 0;
+        }
+
+    // revert the clusters that are not moved
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        m_count_total.n_particles_in_clusters += m_pdata->getN();
+
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            unsigned int tag = h_tag.data[i];
+            unsigned int decision = accept[uf.getLabel(tag)];
+
+            if (decision != 2)
+                {
+                const detail::cluster_ptl_old& old = old_state[tag];
+                h_postype.data[i] = old.postype;
+                h_orientation.data[i] = old.orientation;
+                h_image.data[i] = old.image;
+                }
+
+            if (decision == 0)
+                continue;
+
+            unsigned int type = __scalar_as_int(h_postype.data[i].w);
+            if (swap)
+                {
+                if (type == m_ab_types[0] || type == m_ab_types[1])
+                    {
+                    if (decision == 2)
+                        m_count_total.swap_accept_count++;
+                    else
+                        m_count_total.swap_reject_count++;
+                    }
+                }
+            else if (line)
+                {
+                if (decision == 2)
+                    m_count_total.reflection_accept_count++;
+                else
+                    m_count_total.reflection_reject_count++;
+                }
+            else
+                {
+                if (decision == 2)
+                    m_count_total.pivot_accept_count++;
+                else
+                    m_count_total.pivot_reject_count++;
+                }
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    if (m_prof) m_prof->pop(m_exec_conf);
+
+    // send the reverted particles back to the ranks owning their old positions
+    migrateToOwners(NULL);
+
+    m_mc->communicate(true);
+    }
+#endif
+
 template < class Shape> void export_UpdaterClusters(pybind11::module& m, const std::string& name)
     {
     pybind11::class_< UpdaterClusters<Shape>, std::shared_ptr< UpdaterClusters<Shape> > >(m, name.c_str(), pybind11::base<Updater>())
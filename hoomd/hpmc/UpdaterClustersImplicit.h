@@ -73,7 +73,7 @@ class UpdaterClustersImplicit : public UpdaterClusters<Shape>
             \param pivot The current pivot point
             \param q The current line reflection axis
             \param line True if this is a line reflection
-            \param map Map to lookup new tag from old tag
+            \param map Map to lookup new tag from old tag, empty if the tags do not change
         */
         virtual void findInteractions(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q, bool swap, bool line,
             const std::map<unsigned int, unsigned int>& map);
@@ -180,18 +180,8 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                                 h_overlaps.data[overlap_idx(typ_j,depletant_type)] &&
                                 rsq_ij <= RaRb*RaRb)
                                 {
-                                unsigned int new_tag_i;
-                                    {
-                                    auto it = map.find(this->m_tag_backup[i]);
-                                    assert(it != map.end());
-                                    new_tag_i = it->second;
-                                    }
-                                unsigned int new_tag_j;
-                                    {
-                                    auto it = map.find(this->m_tag_backup[j]);
-                                    assert(it!=map.end());
-                                    new_tag_j = it->second;
-                                    }
+                                unsigned int new_tag_i = this->lookupTag(map, this->m_tag_backup[i]);
+                                unsigned int new_tag_j = this->lookupTag(map, this->m_tag_backup[j]);
 
                                 this->m_interact_old_old.push_back(std::make_pair(new_tag_i,new_tag_j));
 
@@ -266,12 +256,7 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                             // read in its position and orientation
                             unsigned int j = this->m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                            unsigned int new_tag_j;
-                                {
-                                auto it = map.find(this->m_tag_backup[j]);
-                                assert(it != map.end());
-                                new_tag_j = it->second;
-                                }
+                            unsigned int new_tag_j = this->lookupTag(map, this->m_tag_backup[j]);
 
                             if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
 
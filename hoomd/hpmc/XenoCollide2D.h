@@ -92,6 +92,7 @@ class CompositeSupportFunc2D
     \param qa Orientation of shape A
     \param qb Orientation of shape B
     \param err_count Error counter to increment whenever an infinite loop is encountered
+    \param sep_axis (optional) in/out separating axis, in the space frame
     \returns true when the two shapes overlap and false when they are disjoint.
 
     XenoCollide is a generic algorithm for detecting overlaps between two shapes. It operates with the support function
@@ -121,6 +122,10 @@ class CompositeSupportFunc2D
     This implementation works, but is minimally tested and only on shapes of diameter 1. gjkm_2d() is the production
     code for overlap detection of convex shapes.
 
+    **Warm start**
+    As in xenocollide_3d(), a non-zero *sep_axis* is checked before the portal refinement and is set to the separating
+    direction found (or to zero if there is none) when the shapes are disjoint.
+
     \ingroup minkowski
 */
 template<class SupportFuncA, class SupportFuncB>
@@ -129,7 +134,8 @@ DEVICE inline bool xenocollide_2d(const SupportFuncA& sa,
                                   const vec2<OverlapReal>& ab_t,
                                   const quat<OverlapReal>& qa,
                                   const quat<OverlapReal>& qb,
-                                  unsigned int& err_count)
+                                  unsigned int& err_count,
+                                  vec2<OverlapReal> *sep_axis = NULL)
     {
     // This implementation of XenoCollide is hand-written from the description of the algorithm on page 171 of _Games
     // Programming Gems 7_
@@ -139,6 +145,15 @@ DEVICE inline bool xenocollide_2d(const SupportFuncA& sa,
     const OverlapReal tol = OverlapReal(1e-7) * tol_multiplier;
     CompositeSupportFunc2D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, qa, qb);
 
+    if (sep_axis != NULL && dot(*sep_axis, *sep_axis) > OverlapReal(0.0))
+        {
+        // check the axis that separated the shapes last time
+        if (dot(S(*sep_axis), *sep_axis) < OverlapReal(0.0))
+            return false;
+
+        *sep_axis = vec2<OverlapReal>(0,0);
+        }
+
     // Phase 1: Portal Discovery
     // ------
     // find the origin ray v0
@@ -192,6 +207,8 @@ DEVICE inline bool xenocollide_2d(const SupportFuncA& sa,
         // if (origin outside support plane) return false
         if (dot(v3, v21_perp) < 0)
             {
+            if (sep_axis != NULL)
+                *sep_axis = v21_perp;
             return false;
             }
 
@@ -39,6 +39,7 @@ const unsigned int XENOCOLLIDE_3D_MAX_ITERATIONS = 1024;
     \param q Orientation of shape B in frame A
     \param R Approximate radius of Minkowski difference for scaling tolerance value
     \param err_count Error counter to increment whenever an infinite loop is encountered
+    \param sep_axis (optional) in/out separating axis, in frame A
     \returns true when the two shapes overlap and false when they are disjoint.
 
     XenoCollide is a generic algorithm for detecting overlaps between two shapes. It operates with the support function
@@ -65,6 +66,12 @@ const unsigned int XENOCOLLIDE_3D_MAX_ITERATIONS = 1024;
     and we avoid it for performance reasons. Support functions that require the use of normal n vectors should normalize
     it when needed.
 
+    **Warm start**
+    When *sep_axis* is given and not zero, the support plane of the Minkowski difference along it is checked first. If
+    it separates the origin from the Minkowski difference, the shapes are disjoint and no iterations are needed. Trial
+    moves are small, so the axis found for the same pair in the previous test often still separates them. When the
+    shapes are disjoint, *sep_axis* is set to the separating direction found, or to zero if there is none.
+
     \ingroup minkowski
 */
 template<class SupportFuncA, class SupportFuncB>
@@ -73,7 +80,8 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
                                   const vec3<OverlapReal>& ab_t,
                                   const quat<OverlapReal>& q,
                                   const OverlapReal R,
-                                  unsigned int& err_count)
+                                  unsigned int& err_count,
+                                  vec3<OverlapReal> *sep_axis = NULL)
     {
     // This implementation of XenoCollide is hand-written from the description of the algorithm on page 171 of _Games
     // Programming Gems 7_
@@ -90,6 +98,13 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
         return true;
         }
 
+    if (sep_axis != NULL && dot(*sep_axis, *sep_axis) > OverlapReal(0.0))
+        {
+        // check the axis that separated the shapes last time
+        if (dot(S(*sep_axis), *sep_axis) < OverlapReal(0.0))
+            return false;
+        }
+
     // Phase 1: Portal Discovery
     // ------
     // Find the origin ray v0 from the origin to an interior point of the Minkowski difference.
@@ -104,7 +119,12 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
 
     /* if (dot(v1, v1 - v0) <= 0) // by convexity */
     if (dot(v1, v0) > OverlapReal(0.0))
-        return false;   // origin is outside v1 support plane
+        {
+        // origin is outside v1 support plane
+        if (sep_axis != NULL)
+            *sep_axis = -v0;
+        return false;
+        }
 
     // find support v2 perpendicular to v0, v1 plane
     n = cross(v1, v0);
@@ -117,7 +137,11 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
     v2 = S(n); // Convexity should guarantee ||v2|| > 0, but v2 == v1 may be possible in edge cases of {B}-{A}
     // particles do not overlap if origin outside v2 support plane
     if (dot(v2, n) < OverlapReal(0.0))
+        {
+        if (sep_axis != NULL)
+            *sep_axis = n;
         return false;
+        }
 
     // Find next support direction perpendicular to plane (v1,v0,v2)
     n = cross(v1 - v0, v2 - v0);
@@ -145,7 +169,12 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
         // Get the next support point
         v3 = S(n);
         if (dot(v3, n) <= 0)
-            return false; // check if origin outside v3 support plane
+            {
+            // check if origin outside v3 support plane
+            if (sep_axis != NULL)
+                *sep_axis = n;
+            return false;
+            }
 
         // If origin lies on opposite side of a plane from the third support point, use outer-facing plane normal
         // to find a new support point.
@@ -199,6 +228,8 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
         // if (origin outside support plane) return false
         if (dot(v4, n) < OverlapReal(0.0))
             {
+            if (sep_axis != NULL)
+                *sep_axis = n;
             return false;
             }
 
@@ -211,7 +242,12 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
 
         // First, check if v4 is on plane (v2,v1,v3)
         if (fabs(d) < tol)
-            return false; // no more refinement possible, but not intersection detected
+            {
+            // no more refinement possible, but not intersection detected
+            if (sep_axis != NULL)
+                *sep_axis = vec3<OverlapReal>(0,0,0);
+            return false;
+            }
 
         // Second, check if origin is on plane (v2,v1,v3) and has been missed by other checks
         d = dot(v1 * tol_multiplier, n);
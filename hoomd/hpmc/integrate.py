@@ -391,7 +391,10 @@ class mode_hpmc(_integrator):
                    nR=None,
                    depletant_type=None,
                    ntrial=None,
-                   deterministic=None):
+                   deterministic=None,
+                   checkerboard=None,
+                   aabb_refit_threshold=None,
+                   axis_cache=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -404,6 +407,19 @@ class mode_hpmc(_integrator):
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
                 (Only supported with **depletant_mode='circumsphere'**)
             deterministic (bool): (if set) Make HPMC integration deterministic on the GPU by sorting the cell list.
+            checkerboard (bool): (if set) **CPU only**: Sweep the trial moves over a checkerboard of independent cells
+                and run the cells of each checkerboard set in parallel threads. Trial moves that leave their cell are
+                rejected. Ignored with implicit depletants. Not supported with patch energies, external fields, or boxes
+                smaller than two particle diameters; HPMC falls back to the serial sweep in these cases.
+            aabb_refit_threshold (float): (if set) **CPU only**: When the AABB tree is invalidated, refit the bounds of
+                the existing tree instead of building a new one, until the total surface area of its nodes exceeds
+                *aabb_refit_threshold* times the value after the last build. Set to 0 to build a new tree every
+                time (the default). Values around 1.5 work well for dense systems with small moves.
+            axis_cache (int): (if set) **CPU only**: Remember the separating axis of the last *axis_cache* disjoint
+                neighbors of every particle, and check it first in the next overlap test of the same pair. This skips most
+                of the narrow phase for shapes tested with XenoCollide (convex polyhedra, convex spheropolyhedra,
+                faceted ellipsoids and convex spheropolygons) in dense systems. Other shapes ignore the cache. Set to 0
+                to disable the cache (the default).
 
         .. note:: Simulations are only deterministic with respect to the same execution configuration (CPU or GPU) and
                   number of MPI ranks. Simulation output will not be identical if either of these is changed.
@@ -458,6 +474,15 @@ class mode_hpmc(_integrator):
         if deterministic is not None:
             self.cpp_integrator.setDeterministic(deterministic);
 
+        if checkerboard is not None:
+            self.cpp_integrator.setCheckerboard(checkerboard);
+
+        if aabb_refit_threshold is not None:
+            self.cpp_integrator.setAABBTreeRefitThreshold(aabb_refit_threshold);
+
+        if axis_cache is not None:
+            self.cpp_integrator.setSeparatingAxisCache(int(axis_cache));
+
     def map_overlaps(self):
         R""" Build an overlap map of the system
 
@@ -580,9 +605,13 @@ class mode_hpmc(_integrator):
         * *rotate_accept_count* - count of the number of accepted rotate moves
         * *rotate_reject_count* - count of the number of rejected rotate moves
         * *overlap_checks* - estimate of the number of overlap checks performed
+        * *candidate_reject_count* - number of overlap checks decided by the bounding volumes alone
         * *translate_acceptance* - Average translate acceptance ratio over the run
         * *rotate_acceptance* - Average rotate acceptance ratio over the run
         * *move_count* - Count of the number of trial moves during the run
+        * *candidate_rejection* - Fraction of the overlap checks decided by the bounding volumes alone
+
+        The bounding volume counts are only recorded by the CPU implementation.
         """
         counters = self.cpp_integrator.getCounters(1);
         return dict(translate_accept_count=counters.translate_accept_count,
@@ -592,7 +621,9 @@ class mode_hpmc(_integrator):
                     overlap_checks=counters.overlap_checks,
                     translate_acceptance=counters.getTranslateAcceptance(),
                     rotate_acceptance=counters.getRotateAcceptance(),
-                    move_count=counters.getNMoves());
+                    move_count=counters.getNMoves(),
+                    candidate_reject_count=counters.candidate_reject_count,
+                    candidate_rejection=counters.getCandidateRejection());
 
     def get_d(self,type=None):
         R""" Get the maximum trial displacement.
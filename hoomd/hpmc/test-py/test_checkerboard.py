@@ -0,0 +1,46 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import hoomd
+import unittest
+
+context.initialize()
+
+# This test runs HPMC with checkerboard sweeps enabled
+#
+# Success condition: no overlaps are created, moves are accepted, and every local particle receives nselect trial
+# moves per step
+#
+# Failure mode: overlaps appear when two threads move interacting particles at the same time
+#
+class checkerboard(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.5), n=8)
+        self.mc = hpmc.integrate.sphere(seed=42, d=0.2, nselect=2)
+        self.mc.shape_param.set('A', diameter=1.0)
+
+    def test_sweep(self):
+        self.mc.set_params(checkerboard=True)
+        run(50)
+
+        self.assertEqual(self.mc.count_overlaps(), 0)
+
+        counters = self.mc.get_counters()
+        self.assertGreater(counters['translate_acceptance'], 0.0)
+        if comm.get_num_ranks() == 1:
+            self.assertEqual(counters['move_count'], 512*50*2)
+
+    def test_toggle(self):
+        self.mc.set_params(checkerboard=True)
+        run(10)
+        self.mc.set_params(checkerboard=False)
+        run(10)
+        self.assertEqual(self.mc.count_overlaps(), 0)
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -49,6 +49,17 @@ class test_clusters_spheres (unittest.TestCase):
         run(100)
         self.assertTrue(self.clusters.get_swap_acceptance()<1.0)
 
+    def test_no_overlaps(self):
+        self.clusters.set_params(flip_probability=0.5)
+        run(50)
+
+        self.assertEqual(self.mc.count_overlaps(), 0)
+
+        # every particle is part of a cluster on every step, as on a single rank
+        counters = self.clusters.cpp_updater.getCounters(1)
+        self.assertEqual(counters.getNParticlesInClusters(), 50*len(self.system.particles))
+        self.assertTrue(self.clusters.get_pivot_acceptance() > 0 or self.clusters.get_reflection_acceptance() > 0)
+
     def tearDown(self):
         del self.clusters
         del self.mc
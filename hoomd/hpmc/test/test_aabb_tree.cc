@@ -106,3 +106,71 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( refit )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(2);
+
+    // build a test AABB tree big enough to exercise the node splitting
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    MY_CHECK_CLOSE(tree.getCost(), tree.getBuildCost(), tol);
+
+    // the tree cannot be refit for a different number of particles
+    UP_ASSERT(!tree.refit(aabbs, N-1));
+
+    // move all the points by a small amount and refit
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng));
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    UP_ASSERT(tree.refit(aabbs, N));
+
+    // every particle must be found, and every hit must be a true overlap
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        AABB query(points[i], Scalar(0.01));
+        tree.query(hits, query);
+        UP_ASSERT(in(i, hits));
+        }
+
+    // the root node of a refit tree bounds exactly the particle AABBs
+    AABB all = aabbs[0];
+    for (unsigned int i = 1; i < N; i++)
+        all = merge(all, aabbs[i]);
+    AABB root = tree.getNodeAABB(0);
+    MY_CHECK_CLOSE(root.getLower().x, all.getLower().x, tol);
+    MY_CHECK_CLOSE(root.getUpper().y, all.getUpper().y, tol);
+
+    // small moves leave the quality close to that of the original build
+    UP_ASSERT(tree.getCost() < Scalar(1.5)*tree.getBuildCost());
+
+    // shuffling the particles among the leaves keeps the tree valid but degrades its quality
+    for (unsigned int i = 0; i < N; i++)
+        aabbs[i] = AABB(points[(i*7919) % N], Scalar(1.0));
+    UP_ASSERT(tree.refit(aabbs, N));
+    UP_ASSERT(tree.getCost() > Scalar(1.5)*tree.getBuildCost());
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[(i*7919) % N], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+    }
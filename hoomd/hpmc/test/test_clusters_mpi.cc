@@ -0,0 +1,138 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_MPI
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/SystemDefinition.h"
+#include "hoomd/Communicator.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/IntegratorHPMCMono.h"
+#include "hoomd/hpmc/UpdaterClusters.h"
+#include "hoomd/hpmc/ShapeSphere.h"
+
+#include <memory>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+
+//! Test that components spanning several ranks get the same label everywhere
+UP_TEST( distributed_union_find_connect )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    MPI_Comm mpi_comm = exec_conf->getMPICommunicator();
+    int nranks, rank;
+    MPI_Comm_size(mpi_comm, &nranks);
+    MPI_Comm_rank(mpi_comm, &rank);
+
+    DistributedUnionFind uf;
+
+    // a chain 0-1-2-..., every rank only knows every nranks-th bond
+    unsigned int n_chain = 4*nranks;
+    for (unsigned int v = 0; v < n_chain; ++v)
+        if (v % nranks == (unsigned int)rank)
+            uf.addEdge(v, v+1);
+
+    // a chain with the smallest node at the far end, whose label has to travel through all ranks
+    for (unsigned int v = 0; v < n_chain; ++v)
+        if (v % nranks == (unsigned int)rank)
+            uf.addEdge(1000 + n_chain - v, 1000 + n_chain - v - 1);
+
+    // a star, every rank connects a leaf to the shared center
+    uf.addEdge(3000, 2000 - rank);
+
+    // a node known on every rank without any bonds, and a node only known on this rank
+    uf.addNode(4000);
+    uf.addNode(5000 + rank);
+
+    uf.connect(mpi_comm);
+
+    for (unsigned int v = 0; v < n_chain; ++v)
+        {
+        if (v % nranks == (unsigned int)rank)
+            {
+            CHECK_EQUAL_UINT(uf.getLabel(v), 0);
+            CHECK_EQUAL_UINT(uf.getLabel(v+1), 0);
+            CHECK_EQUAL_UINT(uf.getLabel(1000 + n_chain - v), 1000);
+            CHECK_EQUAL_UINT(uf.getLabel(1000 + n_chain - v - 1), 1000);
+            }
+        }
+
+    CHECK_EQUAL_UINT(uf.getLabel(3000), 2000 - (nranks-1));
+    CHECK_EQUAL_UINT(uf.getLabel(2000 - rank), 2000 - (nranks-1));
+    CHECK_EQUAL_UINT(uf.getLabel(4000), 4000);
+    CHECK_EQUAL_UINT(uf.getLabel(5000 + rank), 5000 + rank);
+    }
+
+//! Run cluster moves that are never accepted, and return the counters
+/*! \param exec_conf Execution configuration
+    \param decompose If true, decompose the box over all ranks
+*/
+hpmc_clusters_counters_t run_clusters(std::shared_ptr<ExecutionConfiguration> exec_conf, bool decompose)
+    {
+    // simple cubic lattice of spheres
+    unsigned int n = 6;
+    Scalar a = 1.2;
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(n*a);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->particle_data.resize(n*n*n);
+    for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n; ++j)
+            for (unsigned int k = 0; k < n; ++k)
+                snap->particle_data.pos[(i*n+j)*n+k] = vec3<Scalar>(a*(i+0.5)-n*a/2, a*(j+0.5)-n*a/2, a*(k+0.5)-n*a/2);
+
+    std::shared_ptr<DomainDecomposition> decomposition;
+    if (decompose)
+        decomposition = std::shared_ptr<DomainDecomposition>(new DomainDecomposition(exec_conf, snap->global_box.getL()));
+
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+
+    std::shared_ptr<IntegratorHPMCMono<ShapeSphere> > mc(new IntegratorHPMCMono<ShapeSphere>(sysdef, 123));
+    sph_params par;
+    par.radius = 0.5;
+    par.ignore = 0;
+    par.isOriented = false;
+    mc->setParam(0, par);
+
+    std::shared_ptr<UpdaterClusters<ShapeSphere> > clusters(new UpdaterClusters<ShapeSphere>(sysdef, mc, 54321));
+
+    // the configuration does not change, so the clusters are the same with and without domain decomposition
+    clusters->setFlipProbability(0.0);
+
+    if (decompose)
+        {
+        std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+        mc->setCommunicator(comm);
+        clusters->setCommunicator(comm);
+        }
+
+    for (unsigned int t = 0; t < 20; ++t)
+        clusters->update(t);
+
+    return clusters->getCounters(0);
+    }
+
+//! Test that the clusters found with domain decomposition are those found on a single rank
+UP_TEST( clusters_mpi_vs_single_rank )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    hpmc_clusters_counters_t counters = run_clusters(exec_conf, true);
+
+    // every rank runs the same system by itself
+    std::shared_ptr<MPIConfiguration> mpi_conf_self(new MPIConfiguration(MPI_COMM_SELF));
+    std::shared_ptr<ExecutionConfiguration> exec_conf_self(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+        std::vector<int>(), false, false, mpi_conf_self));
+    hpmc_clusters_counters_t counters_self = run_clusters(exec_conf_self, false);
+
+    UP_ASSERT_EQUAL(counters.n_particles_in_clusters, counters_self.n_particles_in_clusters);
+    UP_ASSERT_EQUAL(counters.n_clusters, counters_self.n_clusters);
+    UP_ASSERT_EQUAL(counters.pivot_accept_count, counters_self.pivot_accept_count);
+    UP_ASSERT_EQUAL(counters.reflection_accept_count, counters_self.reflection_accept_count);
+    }
+
+#endif // ENABLE_MPI
@@ -45,8 +45,9 @@ poly3d_verts setup_verts(const vector< vec3<OverlapReal> > vlist)
         result.z[i] = 0;
         }
 
-    // set the diameter
+    // set the diameter and the bounding box
     result.diameter = 2*sqrt(radius_sq);
+    result.updateOBB();
 
     return result;
     }
@@ -620,3 +621,48 @@ UP_TEST( overlap_cube_rot3 )
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
 
     }
+
+UP_TEST( overlap_cube_separating_axis )
+    {
+    // check that overlap tests started from a cached separating axis agree with the full test
+    vec3<Scalar> r_ij;
+    quat<Scalar> o;
+    quat<Scalar> o_rot(cos(M_PI/8.0), (Scalar)sin(M_PI/8.0)*vec3<Scalar>(0,0,1));
+
+    // build a cube
+    vector< vec3<OverlapReal> > vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,-0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,0.5,0.5));
+    poly3d_verts verts = setup_verts(vlist);
+
+    ShapeConvexPolyhedron a(o_rot, verts);
+    ShapeConvexPolyhedron b(o, verts);
+
+    // disjoint shapes return a separating axis
+    vec3<OverlapReal> axis(0,0,0);
+    r_ij = vec3<Scalar>(1.3,0.1,0);
+    UP_ASSERT(!test_overlap(r_ij,a,b,err_count,axis));
+    UP_ASSERT(dot(axis,axis) > 0);
+
+    // a small displacement keeps the pair disjoint, starting from the cached axis
+    r_ij = vec3<Scalar>(1.29,0.12,0.01);
+    UP_ASSERT(!test_overlap(r_ij,a,b,err_count,axis));
+    UP_ASSERT(dot(axis,axis) > 0);
+
+    // a stale axis does not hide an overlap
+    r_ij = vec3<Scalar>(0.9,0.1,0);
+    UP_ASSERT(test_overlap(r_ij,a,b,err_count,axis));
+    UP_ASSERT(test_overlap(r_ij,a,b,err_count));
+
+    // an axis that does not separate the shapes is replaced by one that does, pointing from b towards a
+    axis = vec3<OverlapReal>(0,1,0);
+    r_ij = vec3<Scalar>(1.3,0.1,0);
+    UP_ASSERT(!test_overlap(r_ij,a,b,err_count,axis));
+    UP_ASSERT(axis.x < 0);
+    }
@@ -464,3 +464,72 @@ UP_TEST( overlap_octahedron_sphere )
     UP_ASSERT(test_overlap(r_ij,a,b,err_count));
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
     }
+
+UP_TEST( overlap_octahedron_leaf_triangles )
+    {
+    // the vectorized narrow phase on the SoA leaf layout gives the same result as the face by face test
+    vec3<Scalar> r_ij;
+    quat<Scalar> o;
+    quat<Scalar> o_rot = quat<Scalar>::fromAxisAngle(vec3<Scalar>(1,2,3)*(1/sqrt(14.0)), 0.3);
+
+    // build an octahedron
+    poly3d_data data(6,8,24,6,false);
+    data.sweep_radius=data.convex_hull_verts.sweep_radius=0.0f;
+
+    data.verts[0] = vec3<OverlapReal>(-0.5,-0.5,0);
+    data.verts[1] = vec3<OverlapReal>(0.5,-0.5,0);
+    data.verts[2] = vec3<OverlapReal>(0.5,0.5,0);
+    data.verts[3] = vec3<OverlapReal>(-0.5,0.5,0);
+    data.verts[4] = vec3<OverlapReal>(0,0,0.707106781186548);
+    data.verts[5] = vec3<OverlapReal>(0,0,-0.707106781186548);
+    data.face_offs[0] = 0;
+    data.face_verts[0] = 0; data.face_verts[1] = 4; data.face_verts[2] = 1;
+    data.face_offs[1] = 3;
+    data.face_verts[3] = 1; data.face_verts[4] = 4; data.face_verts[5] = 2;
+    data.face_offs[2] = 6;
+    data.face_verts[6] = 2; data.face_verts[7] = 4; data.face_verts[8] = 3;
+    data.face_offs[3] = 9;
+    data.face_verts[9] = 3; data.face_verts[10] = 4; data.face_verts[11] = 0;
+    data.face_offs[4] = 12;
+    data.face_verts[12] = 0; data.face_verts[13] = 5; data.face_verts[14] = 1;
+    data.face_offs[5] = 15;
+    data.face_verts[15] = 1; data.face_verts[16] = 5; data.face_verts[17] = 2;
+    data.face_offs[6] = 18;
+    data.face_verts[18] = 2; data.face_verts[19] = 5; data.face_verts[20] = 3;
+    data.face_offs[7] = 21;
+    data.face_verts[21] = 3; data.face_verts[22] = 5; data.face_verts[23] = 0;
+    data.face_offs[8] = 24;
+    data.ignore = 0;
+    set_radius(data);
+    initialize_convex_hull(data);
+
+    ShapePolyhedron::param_type p = data;
+    p.tree = build_tree(data);
+
+    ShapePolyhedron::param_type p_leaf = p;
+    ShapePolyhedron::initializeLeafTriangles(p_leaf);
+    UP_ASSERT_EQUAL(p_leaf.leaf_tri_ptr.size(), p.tree.getNumNodes()+1);
+    UP_ASSERT_EQUAL(p_leaf.leaf_tris.size(), poly3d_leaf_tri_rows*p_leaf.leaf_tri_ptr[p.tree.getNumNodes()]);
+
+    ShapePolyhedron a(o, p);
+    ShapePolyhedron b(o_rot, p);
+    ShapePolyhedron a_leaf(o, p_leaf);
+    ShapePolyhedron b_leaf(o_rot, p_leaf);
+
+    unsigned int n_overlap = 0;
+    for (int i = -6; i <= 6; i++)
+        for (int j = -6; j <= 6; j++)
+            for (int k = -6; k <= 6; k++)
+                {
+                r_ij = vec3<Scalar>(0.2*i, 0.2*j, 0.2*k);
+                bool overlap = test_overlap(r_ij,a,b,err_count);
+                UP_ASSERT_EQUAL(test_overlap(r_ij,a_leaf,b_leaf,err_count), overlap);
+                UP_ASSERT_EQUAL(test_overlap(-r_ij,b_leaf,a_leaf,err_count), overlap);
+                if (overlap)
+                    n_overlap++;
+                }
+
+    // the grid samples both overlapping and separated configurations
+    UP_ASSERT(n_overlap > 0);
+    UP_ASSERT(n_overlap < 13*13*13);
+    }
@@ -48,8 +48,9 @@ poly3d_verts setup_verts(const vector< vec3<OverlapReal> > vlist, OverlapReal sw
         result.z[i] = 0;
         }
 
-    // set the diameter
+    // set the diameter and the bounding box
     result.diameter = 2*(sqrt(radius_sq)+sweep_radius);
+    result.updateOBB();
 
     return result;
     }
@@ -840,3 +841,58 @@ UP_TEST( overlap_cube_precise )
     UP_ASSERT(test_overlap(r_ij,a,b,err_count));
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
     }
+
+UP_TEST( bounding_volumes )
+    {
+    vec3<Scalar> r_ij;
+    quat<Scalar> o;
+
+    // build a flat rounded slab
+    vector< vec3<OverlapReal> > vlist;
+    vlist.push_back(vec3<OverlapReal>(-1.5,-0.5,-0.1));
+    vlist.push_back(vec3<OverlapReal>(1.5,-0.5,-0.1));
+    vlist.push_back(vec3<OverlapReal>(1.5,0.5,-0.1));
+    vlist.push_back(vec3<OverlapReal>(-1.5,0.5,-0.1));
+    vlist.push_back(vec3<OverlapReal>(-1.5,-0.5,0.1));
+    vlist.push_back(vec3<OverlapReal>(1.5,-0.5,0.1));
+    vlist.push_back(vec3<OverlapReal>(1.5,0.5,0.1));
+    vlist.push_back(vec3<OverlapReal>(-1.5,0.5,0.1));
+    poly3d_verts verts = setup_verts(vlist, 0.1);
+
+    // the AABB is tight around the vertices and the sweep radius
+    ShapeSpheropolyhedron a(o, verts);
+    AABB aabb = a.getAABB(vec3<Scalar>(1,2,3));
+    MY_CHECK_CLOSE(aabb.getLower().x, -0.6, tol);
+    MY_CHECK_CLOSE(aabb.getLower().y, 1.4, tol);
+    MY_CHECK_CLOSE(aabb.getLower().z, 2.8, tol);
+    MY_CHECK_CLOSE(aabb.getUpper().x, 2.6, tol);
+    MY_CHECK_CLOSE(aabb.getUpper().y, 2.6, tol);
+    MY_CHECK_CLOSE(aabb.getUpper().z, 3.2, tol);
+
+    // rotated by 90 degrees about z, the long axis points along y
+    quat<Scalar> o_rot = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), M_PI/2);
+    ShapeSpheropolyhedron b(o_rot, verts);
+    aabb = b.getAABB(vec3<Scalar>(0,0,0));
+    MY_CHECK_CLOSE(aabb.getUpper().x, 0.6, tol);
+    MY_CHECK_CLOSE(aabb.getUpper().y, 1.6, tol);
+
+    // stacked slabs: the circumspheres overlap, but the OBBs do not
+    r_ij = vec3<Scalar>(0,0,0.5);
+    UP_ASSERT(check_circumsphere_overlap(r_ij,a,a));
+    UP_ASSERT(!check_obb_overlap(r_ij,a,a));
+    UP_ASSERT(!check_obb_overlap(-r_ij,a,a));
+    UP_ASSERT(!test_overlap(r_ij,a,a,err_count));
+
+    // the OBBs overlap whenever the shapes do
+    r_ij = vec3<Scalar>(0,0,0.35);
+    UP_ASSERT(check_obb_overlap(r_ij,a,a));
+    UP_ASSERT(test_overlap(r_ij,a,a,err_count));
+
+    // crossed slabs
+    r_ij = vec3<Scalar>(0.5,0.5,0.3);
+    UP_ASSERT(check_obb_overlap(r_ij,a,b));
+    UP_ASSERT(test_overlap(r_ij,a,b,err_count));
+    r_ij = vec3<Scalar>(0.5,0.5,0.45);
+    UP_ASSERT(!check_obb_overlap(r_ij,a,b));
+    UP_ASSERT(!test_overlap(r_ij,a,b,err_count));
+    }
@@ -157,7 +157,6 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
@@ -176,25 +175,24 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
+    // the bonds by particle index, ordered by the first member
+    const std::vector<BondData::members_t>& table = m_bond_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = m_bond_data->getCPUTableGroups();
+
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
-        assert(bond.tag[0] < m_pdata->getN());
-        assert(bond.tag[1] < m_pdata->getN());
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-        assert(idx_a <= m_pdata->getMaximumTag());
-        assert(idx_b <= m_pdata->getMaximumTag());
+        // lookup the indices of the particles participating in the bond
+        const BondData::members_t& bond_idx = table[i];
+        unsigned int cur_bond = table_group[i];
+        unsigned int idx_a = bond_idx.idx[0];
+        unsigned int idx_b = bond_idx.idx[1];
 
         // throw an error if this bond is incomplete
         if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL)
             {
+            const BondData::members_t& bond = m_bond_data->getMembersByIndex(cur_bond);
             this->m_exec_conf->msg->error() << "bond.table: bond " <<
                 bond.tag[0] << " " << bond.tag[1] << " incomplete." << endl << endl;
             throw std::runtime_error("Error in bond calculation");
@@ -211,7 +209,7 @@ void BondTablePotential::computeForces(unsigned int timestep)
         dx = box.minImage(dx);
 
         // access needed parameters
-        unsigned int type = m_bond_data->getTypeByIndex(i);
+        unsigned int type = m_bond_data->getTypeByIndex(cur_bond);
         Scalar4 params = h_params.data[type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
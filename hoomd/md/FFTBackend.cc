@@ -0,0 +1,169 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "FFTBackend.h"
+
+#include <vector>
+#include <stdlib.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \file FFTBackend.cc
+    \brief Defines the backends for 3D FFTs of meshes local to one rank
+*/
+
+/*! \param dim Dimensions of the mesh
+ */
+FFTBackendKiss::FFTBackendKiss(uint3 dim)
+    : FFTBackend(dim)
+    {
+    // kiss FFT expects the slowest varying dimension first
+    int dims[3];
+    dims[0] = m_dim.z;
+    dims[1] = m_dim.y;
+    dims[2] = m_dim.x;
+
+    m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+    m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+    }
+
+FFTBackendKiss::~FFTBackendKiss()
+    {
+    free(m_kiss_fft);
+    free(m_kiss_ifft);
+    }
+
+void FFTBackendKiss::forward(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    kiss_fftnd(m_kiss_fft, in, out);
+    }
+
+void FFTBackendKiss::inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    kiss_fftnd(m_kiss_ifft, in, out);
+    }
+
+/*! \param exec_conf The execution configuration, which sets the number of threads
+    \param dim Dimensions of the mesh
+ */
+FFTBackendThreaded::FFTBackendThreaded(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint3 dim)
+    : FFTBackend(dim), m_exec_conf(exec_conf)
+    {
+    m_fft[0] = kiss_fft_alloc(m_dim.x, 0, NULL, NULL);
+    m_fft[1] = kiss_fft_alloc(m_dim.y, 0, NULL, NULL);
+    m_fft[2] = kiss_fft_alloc(m_dim.z, 0, NULL, NULL);
+
+    m_ifft[0] = kiss_fft_alloc(m_dim.x, 1, NULL, NULL);
+    m_ifft[1] = kiss_fft_alloc(m_dim.y, 1, NULL, NULL);
+    m_ifft[2] = kiss_fft_alloc(m_dim.z, 1, NULL, NULL);
+    }
+
+FFTBackendThreaded::~FFTBackendThreaded()
+    {
+    for (unsigned int i = 0; i < 3; ++i)
+        {
+        free(m_fft[i]);
+        free(m_ifft[i]);
+        }
+    }
+
+void FFTBackendThreaded::forward(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    transform(m_fft, in, out);
+    }
+
+void FFTBackendThreaded::inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    transform(m_ifft, in, out);
+    }
+
+/*! \param cfg 1D transforms along x, y and z
+    \param in Input mesh
+    \param out Output mesh
+
+    The first pass reads from \a in and writes to \a out, the two following passes transform \a out in place. The
+    kiss_fft configurations are only read during a transform, and so can be shared between threads.
+ */
+void FFTBackendThreaded::transform(kiss_fft_cfg *cfg, const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    const unsigned int nx = m_dim.x;
+    const unsigned int ny = m_dim.y;
+    const unsigned int nz = m_dim.z;
+
+    // lines along x are contiguous, line (y,z) starts at nx*(y + ny*z)
+    auto transform_x = [&](unsigned int first, unsigned int last)
+        {
+        for (unsigned int line = first; line < last; ++line)
+            {
+            kiss_fft_stride(cfg[0], in + line*nx, out + line*nx, 1);
+            }
+        };
+
+    // line (x,z) along y starts at x + nx*ny*z with stride nx
+    auto transform_y = [&](unsigned int first, unsigned int last)
+        {
+        std::vector<kiss_fft_cpx> buf(ny);
+        for (unsigned int line = first; line < last; ++line)
+            {
+            kiss_fft_cpx *start = out + (line % nx) + nx*ny*(line / nx);
+            kiss_fft_stride(cfg[1], start, &buf[0], nx);
+            for (unsigned int j = 0; j < ny; ++j)
+                start[j*nx] = buf[j];
+            }
+        };
+
+    // line (x,y) along z starts at x + nx*y with stride nx*ny
+    auto transform_z = [&](unsigned int first, unsigned int last)
+        {
+        std::vector<kiss_fft_cpx> buf(nz);
+        for (unsigned int line = first; line < last; ++line)
+            {
+            kiss_fft_cpx *start = out + line;
+            kiss_fft_stride(cfg[2], start, &buf[0], nx*ny);
+            for (unsigned int k = 0; k < nz; ++k)
+                start[k*nx*ny] = buf[k];
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // every pass must be complete before the next one starts, parallel_for returns only when all tasks are done
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ny*nz),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            transform_x(r.begin(), r.end());
+            });
+
+        if (ny > 1)
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nx*nz),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                transform_y(r.begin(), r.end());
+                });
+            }
+
+        if (nz > 1)
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nx*ny),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                transform_z(r.begin(), r.end());
+                });
+            }
+        }
+    else
+    #endif
+        {
+        transform_x(0, ny*nz);
+
+        // a transform of length one is the identity
+        if (ny > 1)
+            transform_y(0, nx*nz);
+        if (nz > 1)
+            transform_z(0, nx*ny);
+        }
+    }
@@ -0,0 +1,109 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __FFT_BACKEND_H__
+#define __FFT_BACKEND_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/extern/kiss_fft.h"
+#include "hoomd/extern/kiss_fftnd.h"
+
+#include <memory>
+
+/*! \file FFTBackend.h
+    \brief Declares the backends for 3D FFTs of meshes local to one rank
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Interface for complex-to-complex 3D FFTs of a mesh that is not distributed over ranks
+/*! The mesh is stored in row major order, with the x index varying fastest. Neither the forward transform nor the
+    inverse transform are normalized.
+*/
+class PYBIND11_EXPORT FFTBackend
+    {
+    public:
+        //! Constructor
+        /*! \param dim Dimensions of the mesh
+         */
+        FFTBackend(uint3 dim)
+            : m_dim(dim)
+            { }
+
+        virtual ~FFTBackend() { }
+
+        //! Forward transform
+        /*! \param in Input mesh
+            \param out Output mesh (must not overlap \a in)
+         */
+        virtual void forward(const kiss_fft_cpx *in, kiss_fft_cpx *out) = 0;
+
+        //! Inverse transform
+        /*! \param in Input mesh
+            \param out Output mesh (must not overlap \a in)
+         */
+        virtual void inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out) = 0;
+
+        //! Get the dimensions of the mesh
+        uint3 getDimensions() const
+            {
+            return m_dim;
+            }
+
+    protected:
+        uint3 m_dim;    //!< Dimensions of the mesh
+    };
+
+//! Serial 3D FFT with kiss_fftnd
+class PYBIND11_EXPORT FFTBackendKiss : public FFTBackend
+    {
+    public:
+        //! Constructor
+        FFTBackendKiss(uint3 dim);
+
+        virtual ~FFTBackendKiss();
+
+        //! Forward transform
+        virtual void forward(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+        //! Inverse transform
+        virtual void inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+    private:
+        kiss_fftnd_cfg m_kiss_fft;      //!< Forward transform configuration
+        kiss_fftnd_cfg m_kiss_ifft;     //!< Inverse transform configuration
+    };
+
+//! Thread-parallel 3D FFT from batches of 1D transforms
+/*! The 3D transform is separated into three passes of independent 1D transforms along x, y and z. Within every pass,
+    the lines of the mesh are distributed over the TBB threads. Lines along y and z are gathered into a contiguous
+    buffer per task, so that every thread only writes to its own lines of the output mesh. Without TBB, the passes
+    are executed serially.
+*/
+class PYBIND11_EXPORT FFTBackendThreaded : public FFTBackend
+    {
+    public:
+        //! Constructor
+        FFTBackendThreaded(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint3 dim);
+
+        virtual ~FFTBackendThreaded();
+
+        //! Forward transform
+        virtual void forward(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+        //! Inverse transform
+        virtual void inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+        kiss_fft_cfg m_fft[3];      //!< Forward 1D transforms along x, y and z
+        kiss_fft_cfg m_ifft[3];     //!< Inverse 1D transforms along x, y and z
+
+        //! Perform the three passes of 1D transforms
+        void transform(kiss_fft_cfg *cfg, const kiss_fft_cpx *in, kiss_fft_cpx *out);
+    };
+
+#endif // __FFT_BACKEND_H__
@@ -7,6 +7,13 @@
 #include "ForceDistanceConstraint.h"
 
 #include <string.h>
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -61,9 +68,8 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
         throw std::runtime_error("Error computing constraints.\n");
         }
 
-    // reallocate through amortized resizin
+    // reallocate through amortized resizing
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -82,26 +88,95 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
         m_prof->pop();
     }
 
-void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
+/*! The blocks are the connected components of the local constraints, where two constraints are connected if they
+    share a particle. They are found with a union-find over the local constraints, so that no global information is
+    needed. Each block is labeled by its first constraint.
+*/
+void ForceDistanceConstraint::buildMoleculeBlocks()
     {
-    // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
 
-    if (m_constraint_reorder)
+    // parent of every constraint, the root of a component is its smallest constraint index
+    std::vector<unsigned int> parent(n_constraint);
+    auto find = [&parent](unsigned int n)
         {
-        // reset flag
-        m_constraint_reorder = false;
+        while (parent[n] != n)
+            {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+            }
+        return n;
+        };
 
-        // resize lookup matrix
-        m_sparse_idxlookup.resize(n_constraint*n_constraint);
+    // first constraint seen for every particle tag
+    std::unordered_map<unsigned int, unsigned int> ptl_constraint;
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        parent[n] = n;
+        const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
+        for (unsigned int k = 0; k < 2; ++k)
+            {
+            auto it = ptl_constraint.insert(std::make_pair(constraint.tag[k], n));
+            if (!it.second)
+                {
+                unsigned int root_n = find(n);
+                unsigned int root_m = find(it.first->second);
+                parent[std::max(root_n, root_m)] = std::min(root_n, root_m);
+                }
+            }
+        }
+
+    // sort constraints by block, keeping the order of constraints within a block
+    std::vector< std::pair<unsigned int, unsigned int> > mol_constraint(n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        mol_constraint[n] = std::make_pair(find(n), n);
+    std::sort(mol_constraint.begin(), mol_constraint.end());
 
-        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
+    m_block_constraints.resize(n_constraint);
+    m_block_offset.clear();
+    m_block_matrix_offset.clear();
 
-        // reset lookup matrix values to -1
-        for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
+    unsigned int matrix_size = 0;
+    for (unsigned int i = 0; i < n_constraint; ++i)
+        {
+        if (i == 0 || mol_constraint[i].first != mol_constraint[i-1].first)
             {
-            h_sparse_idxlookup.data[i] = -1;
+            // start a new block and finish the previous one
+            if (i > 0)
+                {
+                unsigned int size = i - m_block_offset.back();
+                matrix_size += size*size;
+                }
+            m_block_offset.push_back(i);
+            m_block_matrix_offset.push_back(matrix_size);
             }
+        m_block_constraints[i] = mol_constraint[i].second;
+        }
+
+    if (n_constraint > 0)
+        {
+        unsigned int size = n_constraint - m_block_offset.back();
+        matrix_size += size*size;
+        }
+    m_block_offset.push_back(n_constraint);
+    m_block_matrix_offset.push_back(matrix_size);
+
+    m_block_matrix.resize(matrix_size);
+
+    m_exec_conf->msg->notice(7) << "ForceDistanceConstraint: " << m_block_offset.size()-1 << " molecule blocks, "
+                                << matrix_size << " matrix elements" << std::endl;
+    }
+
+void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    if (m_constraint_reorder)
+        {
+        // reset flag
+        m_constraint_reorder = false;
+
+        buildMoleculeBlocks();
         }
 
     // access particle data
@@ -110,16 +185,16 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
 
-    // access matrix elements
-    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
+    // access RHS vector
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
-    // clear matrix
-    memset(h_cmatrix.data, 0, sizeof(double)*m_cmatrix.size());
-
     const BoxDim& box = m_pdata->getBox();
 
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    m_terms.resize(n_constraint);
+
+    // first pass: compute the separations and the right hand side of every constraint
     for (unsigned int n = 0; n < n_constraint; ++n)
         {
         // lookup the tag of each of the particles participating in the constraint
@@ -128,7 +203,6 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
         assert(constraint.tag[1] <= m_pdata->getMaximumTag());
 
         // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
         unsigned int idx_a = h_rtag.data[constraint.tag[0]];
         unsigned int idx_b = h_rtag.data[constraint.tag[1]];
 
@@ -139,100 +213,101 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
             throw std::runtime_error("Error in constraint calculation");
             }
 
+        ConstraintTerm& term = m_terms[n];
+        term.idx_a = idx_a;
+        term.idx_b = idx_b;
 
         vec3<Scalar> ra(h_pos.data[idx_a]);
         vec3<Scalar> rb(h_pos.data[idx_b]);
-        vec3<Scalar> rn(ra-rb);
 
         // apply minimum image
-        rn = box.minImage(rn);
+        term.rn = box.minImage(ra-rb);
 
         vec3<Scalar> va(h_vel.data[idx_a]);
-        Scalar ma(h_vel.data[idx_a].w);
+        term.ma = h_vel.data[idx_a].w;
         vec3<Scalar> vb(h_vel.data[idx_b]);
-        Scalar mb(h_vel.data[idx_b].w);
+        term.mb = h_vel.data[idx_b].w;
 
         vec3<Scalar> rndot(va-vb);
-        vec3<Scalar> qn(rn+rndot*m_deltaT);
-
-        // fill matrix row
-        for (unsigned int m = 0; m < n_constraint; ++m)
-            {
-            // lookup the tag of each of the particles participating in the constraint
-            const ConstraintData::members_t constraint_m = m_cdata->getMembersByIndex(m);
-            assert(constraint_m.tag[0] <= m_pdata->getMaximumTag());
-            assert(constraint_m.tag[1] <= m_pdata->getMaximumTag());
-
-            // transform a and b into indices into the particle data arrays
-            // (MEM TRANSFER: 4 integers)
-            unsigned int idx_m_a = h_rtag.data[constraint_m.tag[0]];
-            unsigned int idx_m_b = h_rtag.data[constraint_m.tag[1]];
-            assert(idx_m_a <= m_pdata->getN()+m_pdata->getNGhosts());
-            assert(idx_m_b <= m_pdata->getN()+m_pdata->getNGhosts());
-
-            if (idx_m_a >= max_local || idx_m_b >= max_local)
-                {
-                this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
-                    constraint_m.tag[0] << " " << constraint_m.tag[1] << " incomplete." << std::endl << std::endl;
-                throw std::runtime_error("Error in constraint calculation");
-                }
+        term.qn = term.rn+rndot*m_deltaT;
 
-            vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
-            vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
-            vec3<Scalar> rm(rm_a-rm_b);
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
 
-            // apply minimum image
-            rm = box.minImage(rm);
+        // check distance violation
+        term.violated = fast::sqrt(dot(term.rn,term.rn))-d >= m_rel_tol*d || std::isnan(dot(term.rn,term.rn));
 
-            double delta(0.0);
-            if (idx_m_a == idx_a)
-                {
-                delta += double(4.0)*dot(qn,rm)/ma;
-                }
-            if (idx_m_b == idx_a)
-                {
-                delta -= double(4.0)*dot(qn,rm)/ma;
-                }
-            if (idx_m_a == idx_b)
-                {
-                delta -= double(4.0)*dot(qn,rm)/mb;
-                }
-            if (idx_m_b == idx_b)
-                {
-                delta += double(4.0)*dot(qn,rm)/mb;
-                }
+        // fill vector component
+        h_cvec.data[n] = (dot(term.qn,term.qn)-d*d)/m_deltaT/m_deltaT;
+        h_cvec.data[n] += double(2.0)*dot(term.qn,vec3<Scalar>(h_netforce.data[idx_a])/term.ma
+              -vec3<Scalar>(h_netforce.data[idx_b])/term.mb);
+        }
 
-            h_cmatrix.data[m*n_constraint+n] += delta;
+    // report the last violated constraint
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        if (m_terms[n].violated)
+            m_constraint_violated.resetFlags(n+1);
+        }
 
-            // update sparse matrix
-            int k = m_sparse_idxlookup[m*n_constraint+n];
+    // second pass: fill the dense matrix block of every molecule
+    auto fill_blocks = [&](unsigned int first, unsigned int last)
+        {
+        for (unsigned int block = first; block < last; ++block)
+            {
+            unsigned int offset = m_block_offset[block];
+            unsigned int size = m_block_offset[block+1] - offset;
+            double *matrix = m_block_matrix.data() + m_block_matrix_offset[block];
 
-            if ( (k == -1 && delta != double(0.0))
-                || (k != -1 && delta == double(0.0)))
+            for (unsigned int i = 0; i < size; ++i)
                 {
-                m_condition.resetFlags(1);
-                }
+                const ConstraintTerm& term_n = m_terms[m_block_constraints[offset+i]];
 
-            if (k != -1)
-                {
-                // update sparse matrix value directly
-                m_sparse.valuePtr()[k] = delta;
+                for (unsigned int j = 0; j < size; ++j)
+                    {
+                    const ConstraintTerm& term_m = m_terms[m_block_constraints[offset+j]];
+                    const vec3<Scalar>& rm = term_m.rn;
+
+                    double delta(0.0);
+                    if (term_m.idx_a == term_n.idx_a)
+                        {
+                        delta += double(4.0)*dot(term_n.qn,rm)/term_n.ma;
+                        }
+                    if (term_m.idx_b == term_n.idx_a)
+                        {
+                        delta -= double(4.0)*dot(term_n.qn,rm)/term_n.ma;
+                        }
+                    if (term_m.idx_a == term_n.idx_b)
+                        {
+                        delta -= double(4.0)*dot(term_n.qn,rm)/term_n.mb;
+                        }
+                    if (term_m.idx_b == term_n.idx_b)
+                        {
+                        delta += double(4.0)*dot(term_n.qn,rm)/term_n.mb;
+                        }
+
+                    // column-major, row i is constraint n and column j is constraint m
+                    matrix[j*size+i] = delta;
+                    }
                 }
             }
+        };
 
-        // get constraint distance
-        Scalar d = m_cdata->getValueByIndex(n);
+    unsigned int n_blocks = m_block_offset.size()-1;
 
-        // check distance violation
-        if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_blocks),
+            [&](const tbb::blocked_range<unsigned int>& r)
             {
-            m_constraint_violated.resetFlags(n+1);
-            }
-
-        // fill vector component
-        h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
-        h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
-              -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+            fill_blocks(r.begin(), r.end());
+            });
+        }
+    else
+    #endif
+        {
+        fill_blocks(0, n_blocks);
         }
     }
 
@@ -262,7 +337,93 @@ void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
         }
     }
 
+/*! Every molecule block is factorized with a dense LU decomposition with partial pivoting and solved independently.
+    Blocks are small for typical molecules, and the matrix entries change every step, so there is nothing to gain
+    from caching the factorization.
+*/
 void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
+    {
+    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
+    typedef Matrix<double, Dynamic, 1> vec_t;
+    typedef Map<matrix_t> matrix_map_t;
+
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0) return;
+
+    if (m_prof)
+        m_prof->push("solve");
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+
+    auto solve_blocks = [&](unsigned int first, unsigned int last) -> bool
+        {
+        bool success = true;
+        vec_t rhs;
+        vec_t x;
+        for (unsigned int block = first; block < last; ++block)
+            {
+            unsigned int offset = m_block_offset[block];
+            unsigned int size = m_block_offset[block+1] - offset;
+            matrix_map_t map_matrix(m_block_matrix.data() + m_block_matrix_offset[block], size, size);
+
+            // gather the right hand side
+            rhs.resize(size);
+            for (unsigned int i = 0; i < size; ++i)
+                rhs(i) = h_cvec.data[m_block_constraints[offset+i]];
+
+            x = map_matrix.partialPivLu().solve(rhs);
+
+            // scatter the solution
+            for (unsigned int i = 0; i < size; ++i)
+                {
+                if (!std::isfinite(x(i)))
+                    success = false;
+                h_lagrange.data[m_block_constraints[offset+i]] = x(i);
+                }
+            }
+        return success;
+        };
+
+    unsigned int n_blocks = m_block_offset.size()-1;
+    bool success = true;
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        success = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_blocks), true,
+            [&](const tbb::blocked_range<unsigned int>& r, bool result) -> bool
+            {
+            return solve_blocks(r.begin(), r.end()) && result;
+            },
+            [](bool a, bool b) -> bool { return a && b; });
+        }
+    else
+    #endif
+        {
+        success = solve_blocks(0, n_blocks);
+        }
+
+    if (!success)
+        {
+        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+        throw std::runtime_error("Error evaluating constraint forces.\n");
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! Solves the full n_constraint x n_constraint equation in m_sparse. The sparsity pattern is rebuilt from the dense
+    matrix m_cmatrix when m_condition is set. This code path is used by ForceDistanceConstraintGPU, which fills the
+    full matrix on the device.
+*/
+void ForceDistanceConstraint::solveConstraintsSparse(unsigned int timestep)
     {
     // use Eigen dense matrix algebra (slow for large matrices)
     typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
@@ -474,44 +635,58 @@ CommFlags ForceDistanceConstraint::getRequestedCommFlags(unsigned int timestep)
     }
 #endif
 
-//! Return maximum extent of molecule
+/*! \param iconstraint Constraint to start from
+    \param molecule Label of the molecule
+    \param visited Flags of the constraints already labeled
+    \param label Molecule label per particle tag
+    \param groups Global constraints
+    \param length Constraint lengths
+    \param ptl_constraints Constraints of every particle tag, in CSR format (see assignMoleculeTags())
+    \param ptl_offset Offset of the constraints of every particle tag in \a ptl_constraints
+    \param stack Work space for the search
+
+    \returns The sum of the constraint lengths of the molecule, an upper bound to its extent
+*/
 Scalar ForceDistanceConstraint::dfs(unsigned int iconstraint, unsigned int molecule, std::vector<int>& visited,
-    unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length)
+    unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length,
+    const std::vector<unsigned int>& ptl_constraints, const std::vector<unsigned int>& ptl_offset,
+    std::vector<unsigned int>& stack)
     {
     assert(iconstraint < groups.size());
 
-    // don't mark constraints already visited
-    assert(visited.size() > iconstraint);
-    if (visited[iconstraint])
-        {
-        return Scalar(0.0);
-        }
+    Scalar dmax(0.0);
 
-    // mark this constraint as visited
+    // depth first search with an explicit stack, molecules may be arbitrarily large
+    stack.clear();
+    stack.push_back(iconstraint);
     visited[iconstraint] = 1;
-
-    const ConstraintData::members_t constraint = groups[iconstraint];
-    assert(constraint.tag[0] <= m_pdata->getMaximumTag());
-    assert(constraint.tag[1] <= m_pdata->getMaximumTag());
-
-    label[constraint.tag[0]] = molecule;
-    label[constraint.tag[1]] = molecule;
-
-    // NOTE: this loop could be optimized with a reverse-lookup table ptl idx -> constraint
-    assert(iconstraint < length.size());
-    Scalar dmax = length[iconstraint];
-
-    for (unsigned int jconstraint = 0; jconstraint < groups.size(); ++jconstraint)
+    while (!stack.empty())
         {
-        ConstraintData::members_t tags_j = groups[jconstraint];
+        unsigned int n = stack.back();
+        stack.pop_back();
+
+        const ConstraintData::members_t constraint = groups[n];
+        assert(constraint.tag[0] <= m_pdata->getMaximumTag());
+        assert(constraint.tag[1] <= m_pdata->getMaximumTag());
 
-        if (iconstraint == jconstraint) continue;
+        assert(n < length.size());
+        dmax += length[n];
 
-        if (tags_j.tag[0] == constraint.tag[0] || tags_j.tag[1] == constraint.tag[0] ||
-            tags_j.tag[0] == constraint.tag[1] || tags_j.tag[1] == constraint.tag[1])
+        for (unsigned int k = 0; k < 2; ++k)
             {
-            // recursively mark connected constraint with current label
-            dmax += dfs(jconstraint, molecule, visited, label, groups, length);
+            unsigned int tag = constraint.tag[k];
+            label[tag] = molecule;
+
+            // push the unvisited constraints of this particle
+            for (unsigned int j = ptl_offset[tag]; j < ptl_offset[tag+1]; ++j)
+                {
+                unsigned int jconstraint = ptl_constraints[j];
+                if (!visited[jconstraint])
+                    {
+                    visited[jconstraint] = 1;
+                    stack.push_back(jconstraint);
+                    }
+                }
             }
         }
 
@@ -554,6 +729,28 @@ void ForceDistanceConstraint::assignMoleculeTags()
     unsigned int nconstraint_global = snap.size;
     std::vector<int> visited(nconstraint_global,0);
 
+    // reverse lookup table of the constraints of every particle tag
+    unsigned int max_tag = m_pdata->getMaximumTag();
+    std::vector<unsigned int> ptl_offset(max_tag+2, 0);
+    for (unsigned int n = 0; n < nconstraint_global; ++n)
+        {
+        ptl_offset[groups[n].tag[0]+1]++;
+        ptl_offset[groups[n].tag[1]+1]++;
+        }
+    for (unsigned int tag = 0; tag <= max_tag; ++tag)
+        ptl_offset[tag+1] += ptl_offset[tag];
+
+    std::vector<unsigned int> ptl_constraints(ptl_offset[max_tag+1]);
+        {
+        std::vector<unsigned int> fill(ptl_offset.begin(), ptl_offset.end()-1);
+        for (unsigned int n = 0; n < nconstraint_global; ++n)
+            {
+            ptl_constraints[fill[groups[n].tag[0]]++] = n;
+            ptl_constraints[fill[groups[n].tag[1]]++] = n;
+            }
+        }
+    std::vector<unsigned int> stack;
+
     // label per ptl (-1 == no label)
     m_molecule_tag.resize(m_pdata->getNGlobal());
 
@@ -578,7 +775,8 @@ void ForceDistanceConstraint::assignMoleculeTags()
             if (! visited[iconstraint])
                 {
                 // depth first search
-                Scalar d = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length);
+                Scalar d = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length,
+                    ptl_constraints, ptl_offset, stack);
                 if (d > m_d_max)
                     {
                     m_d_max = d;
@@ -21,6 +21,7 @@
 
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
+#include "hoomd/VectorMath.h"
 
 #include "hoomd/extern/Eigen/Eigen/Dense"
 #include "hoomd/extern/Eigen/Eigen/SparseLU"
@@ -31,6 +32,14 @@
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
     See Integrator for detailed documentation on constraint force implementation.
+
+    Two constraints couple in the matrix equation only if they share a particle, so the constraint matrix is block
+    diagonal with one block per molecule. On the CPU, the local constraints are grouped into per-molecule blocks with
+    a union-find whenever the constraint table changes, and every block is filled and solved independently (in
+    parallel with TBB). Memory and time then scale linearly with the number of molecules. The GPU
+    implementation assembles the full matrix and solves it with a global sparse LU decomposition
+    (solveConstraintsSparse()).
+
     \ingroup computes
 */
 class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
@@ -78,6 +87,24 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
             //!< The persistent state of the sparse matrix solver
         GPUVector<int> m_sparse_idxlookup;          //!< Reverse lookup from column-major to sparse matrix element
 
+        //! Per-constraint quantities used to fill the constraint matrix
+        struct ConstraintTerm
+            {
+            vec3<Scalar> rn;        //!< Minimum image separation of the two particles
+            vec3<Scalar> qn;        //!< Separation propagated by one time step
+            unsigned int idx_a;     //!< Index of the first particle
+            unsigned int idx_b;     //!< Index of the second particle
+            Scalar ma;              //!< Mass of the first particle
+            Scalar mb;              //!< Mass of the second particle
+            bool violated;          //!< True if the constraint is violated beyond the tolerance
+            };
+
+        std::vector<ConstraintTerm> m_terms;           //!< Cached per-constraint terms (CPU)
+        std::vector<unsigned int> m_block_offset;      //!< Start of each molecule block in m_block_constraints
+        std::vector<unsigned int> m_block_constraints; //!< Constraint indices, sorted by molecule
+        std::vector<unsigned int> m_block_matrix_offset; //!< Start of each dense block in m_block_matrix
+        std::vector<double> m_block_matrix;            //!< Dense per-molecule matrix blocks (column-major)
+
         bool m_constraint_reorder;         //!< True if groups have changed
         bool m_constraints_added_removed;  //!< True if global constraint topology has changed
 
@@ -95,6 +122,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         //! Solve the constraint matrix equation
         virtual void solveConstraints(unsigned int timestep);
 
+        //! Solve the full constraint matrix equation with a sparse LU decomposition
+        void solveConstraintsSparse(unsigned int timestep);
+
+        //! Group the local constraints into per-molecule blocks
+        void buildMoleculeBlocks();
+
         //! Solve the linear matrix-vector equation
         virtual void computeConstraintForces(unsigned int timestep);
 
@@ -108,6 +141,9 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         virtual void slotConstraintsAddedRemoved()
             {
             m_constraints_added_removed = true;
+
+            // the molecule blocks need to be rebuilt
+            m_constraint_reorder = true;
             }
 
         //! Returns the requested ghost layer width for all types
@@ -134,7 +170,9 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     private:
         //! Helper function to perform a depth-first search
         Scalar dfs(unsigned int iconstraint, unsigned int molecule, std::vector<int>& visited,
-            unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length);
+            unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length,
+            const std::vector<unsigned int>& ptl_constraints, const std::vector<unsigned int>& ptl_offset,
+            std::vector<unsigned int>& stack);
 
         #ifdef ENABLE_MPI
         bool m_comm_ghost_layer_connected = false; //!< Track if we have already connected to ghost layer width requests
@@ -118,7 +118,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
@@ -128,7 +127,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
@@ -137,27 +135,26 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
+    // the impropers by particle index, ordered by the first member
+    const std::vector<ImproperData::members_t>& table = m_improper_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = m_improper_data->getCPUTableGroups();
+
     // for each of the impropers
     const unsigned int size = (unsigned int)m_improper_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the improper
-        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
-        assert(improper.tag[0] <= m_pdata->getMaximumTag());
-        assert(improper.tag[1] <= m_pdata->getMaximumTag());
-        assert(improper.tag[2] <= m_pdata->getMaximumTag());
-        assert(improper.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[improper.tag[0]];
-        unsigned int idx_b = h_rtag.data[improper.tag[1]];
-        unsigned int idx_c = h_rtag.data[improper.tag[2]];
-        unsigned int idx_d = h_rtag.data[improper.tag[3]];
-
-        // throw an error if this angle is incomplete
+        // lookup the indices of the particles participating in the improper
+        const ImproperData::members_t& improper_idx = table[i];
+        unsigned int cur_improper = table_group[i];
+        unsigned int idx_a = improper_idx.idx[0];
+        unsigned int idx_b = improper_idx.idx[1];
+        unsigned int idx_c = improper_idx.idx[2];
+        unsigned int idx_d = improper_idx.idx[3];
+
+        // throw an error if this improper is incomplete
         if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
             {
+            const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(cur_improper);
             this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
                 improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
                 << " incomplete." << endl << endl;
@@ -220,7 +217,7 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         Scalar s = sqrt(1.0 - c*c);
         if (s < SMALL) s = SMALL;
 
-        unsigned int improper_type = m_improper_data->getTypeByIndex(i);
+        unsigned int improper_type = m_improper_data->getTypeByIndex(cur_improper);
         Scalar domega = acos(c) - m_chi[improper_type];
         Scalar a = m_K[improper_type] * domega;
 
@@ -11,6 +11,8 @@
 
 #include "IntegratorTwoStep.h"
 
+#include <algorithm>
+
 namespace py = pybind11;
 
 #ifdef ENABLE_MPI
@@ -21,7 +23,7 @@ using namespace std;
 
 IntegratorTwoStep::IntegratorTwoStep(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
     : Integrator(sysdef, deltaT), m_prepared(false), m_gave_warning(false),
-    m_aniso_mode(Automatic)
+    m_aniso_mode(Automatic), m_multiples_changed(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorTwoStep" << endl;
     }
@@ -108,6 +110,9 @@ void IntegratorTwoStep::update(unsigned int timestep)
     if (m_prof)
         m_prof->push("Integrate");
 
+    // second half of the impulses of the slow forces evaluated at the end of the previous step
+    applyPendingKicks();
+
     // perform the first step of the integration on all groups
     std::vector< std::shared_ptr<IntegrationMethodTwoStep> >::iterator method;
     for (method = m_methods.begin(); method != m_methods.end(); ++method)
@@ -123,8 +128,9 @@ void IntegratorTwoStep::update(unsigned int timestep)
         // a) that particles have migrated to the correct domains
         // b) that forces are calculated correctly, if ghost atom positions are updated every time step
 
-        // also updates rigid bodies after ghost updating
-        m_comm->communicate(timestep+1);
+        // also updates rigid bodies after ghost updating. The ghost update may still be in flight when
+        // communicate() returns, computeNetForce() finishes it
+        m_comm->communicate(timestep+1, true);
         }
     else
 #endif
@@ -140,6 +146,9 @@ void IntegratorTwoStep::update(unsigned int timestep)
 #endif
         computeNetForce(timestep+1);
 
+    // evaluate the slow forces that are due
+    computeSlowForces(timestep+1, false);
+
     // Call HalfStep hook
     if (m_half_step_hook)
         {
@@ -153,6 +162,9 @@ void IntegratorTwoStep::update(unsigned int timestep)
     for (method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->integrateStepTwo(timestep);
 
+    // first half of the impulses of the slow forces evaluated at this step
+    kickSlowForces(timestep+1, true);
+
     /* NOTE: For composite particles, it is assumed that positions and orientations are not updated
        in the second step.
 
@@ -177,6 +189,9 @@ void IntegratorTwoStep::setDeltaT(Scalar deltaT)
     std::vector< std::shared_ptr<IntegrationMethodTwoStep> >::iterator method;
     for (method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->setDeltaT(deltaT);
+
+    for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+        m_slow_forces[i]->setDeltaT(deltaT);
     }
 
 /*! \param new_method New integration method to add to the integrator
@@ -220,6 +235,125 @@ void IntegratorTwoStep::removeAllIntegrationMethods()
     m_gave_warning = false;
     }
 
+/*! \param fc ForceCompute to add
+    Forces with a multiple larger than one (see setForceMultiple()) are not added to the net force, they are kept in
+    a separate list.
+*/
+void IntegratorTwoStep::addForceCompute(std::shared_ptr<ForceCompute> fc)
+    {
+    assert(fc);
+    if (getForceMultiple(fc) > 1)
+        {
+        m_slow_forces.push_back(fc);
+        fc->setDeltaT(m_deltaT);
+        }
+    else
+        {
+        Integrator::addForceCompute(fc);
+        }
+    }
+
+/*! \param fc ForceCompute to set the multiple for
+    \param multiple The force is evaluated every \a multiple steps
+
+    The multiple is kept when the forces are removed and added again. A force that has already been added is moved
+    to the net force or to the slow forces as needed.
+*/
+void IntegratorTwoStep::setForceMultiple(std::shared_ptr<ForceCompute> fc, unsigned int multiple)
+    {
+    assert(fc);
+    if (multiple == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_standard: The force multiple must be a positive integer" << endl;
+        throw std::runtime_error("Error setting force multiple");
+        }
+
+    if (multiple > 1 && fc->isAnisotropic())
+        {
+        m_exec_conf->msg->error() << "integrate.mode_standard: Forces that apply torques must be evaluated every step" << endl;
+        throw std::runtime_error("Error setting force multiple");
+        }
+
+    if (multiple > 1 && m_constraint_forces.size() > 0)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_standard: Forces can only be evaluated less often than every step"
+                                  << " without rigid bodies and constraints" << endl;
+        throw std::runtime_error("Error setting force multiple");
+        }
+
+    // remove the force if it has already been added
+    bool added = false;
+    std::vector< std::shared_ptr<ForceCompute> >::iterator force = std::find(m_forces.begin(), m_forces.end(), fc);
+    if (force != m_forces.end())
+        {
+        m_forces.erase(force);
+        added = true;
+        }
+
+    for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+        {
+        if (m_slow_forces[i] == fc)
+            {
+            m_slow_forces.erase(m_slow_forces.begin()+i);
+            added = true;
+            break;
+            }
+        }
+
+    // the accelerations of the next run need to include or exclude the force
+    if (multiple != getForceMultiple(fc))
+        m_multiples_changed = true;
+
+    if (multiple == 1)
+        m_force_multiples.erase(fc);
+    else
+        m_force_multiples[fc] = multiple;
+
+    // add it back to the right list
+    if (added)
+        addForceCompute(fc);
+    }
+
+/*! \param fc ForceCompute to query
+    \returns The number of steps between evaluations of \a fc, 1 if it is evaluated every step
+*/
+unsigned int IntegratorTwoStep::getForceMultiple(std::shared_ptr<ForceCompute> fc) const
+    {
+    std::map< std::shared_ptr<ForceCompute>, unsigned int >::const_iterator it = m_force_multiples.find(fc);
+    if (it == m_force_multiples.end())
+        return 1;
+    return it->second;
+    }
+
+/*! \param thermo ComputeThermo to add
+
+    The slow forces are summed over the group of every registered ComputeThermo when they are evaluated.
+*/
+void IntegratorTwoStep::addThermo(std::shared_ptr<ComputeThermo> thermo)
+    {
+    assert(thermo);
+    m_thermos.push_back(thermo);
+    clearGroupExternal(thermo);
+    }
+
+/*! \post The slow forces are no longer included in the ComputeThermos registered so far
+*/
+void IntegratorTwoStep::removeAllThermos()
+    {
+    for (unsigned int t = 0; t < m_thermos.size(); t++)
+        clearGroupExternal(m_thermos[t]);
+    m_thermos.clear();
+    }
+
+/*! \param thermo ComputeThermo to reset
+*/
+void IntegratorTwoStep::clearGroupExternal(std::shared_ptr<ComputeThermo> thermo)
+    {
+    thermo->setGroupExternalEnergy(Scalar(0.0));
+    for (unsigned int k = 0; k < 6; k++)
+        thermo->setGroupExternalVirial(k, Scalar(0.0));
+    }
+
 /*! \param fc ForceComposite to add
 */
 void IntegratorTwoStep::addForceComposite(std::shared_ptr<ForceComposite> fc)
@@ -237,6 +371,181 @@ void IntegratorTwoStep::removeForceComputes()
 
     // Remove ForceComposite objects
     m_composite_forces.clear();
+
+    // Remove the slow forces, their multiples are kept
+    m_slow_forces.clear();
+    m_slow_energy.clear();
+    m_slow_virial.clear();
+    }
+
+/*! \param timestep Current time step
+    \param all If true, evaluate all slow forces, otherwise only those with a multiple that divides \a timestep
+
+    The potential energy and virial of every slow force are summed over the local members of the group of every
+    registered ComputeThermo right after the evaluation, while the force arrays still match the local particles.
+    The sums over all slow forces at their last evaluation are set as the group external energy and virial of the
+    ComputeThermo, so that a group only includes the slow forces on its own particles. The external energy and
+    virial of the slow forces themselves are included in every group, like those of the other forces.
+*/
+void IntegratorTwoStep::computeSlowForces(unsigned int timestep, bool all)
+    {
+    if (m_slow_forces.size() == 0)
+        return;
+
+    int64_t start_time = m_compute_clk.getTime();
+
+    const unsigned int n_thermos = m_thermos.size();
+    if (all)
+        {
+        m_slow_energy.assign(m_slow_forces.size()*n_thermos, Scalar(0.0));
+        m_slow_virial.assign(6*m_slow_forces.size()*n_thermos, Scalar(0.0));
+        }
+
+    for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+        {
+        if (!all && timestep % getForceMultiple(m_slow_forces[i]) != 0)
+            continue;
+
+        m_slow_forces[i]->compute(timestep);
+
+        GlobalArray<Scalar>& virial_array = m_slow_forces[i]->getVirialArray();
+        ArrayHandle<Scalar4> h_force(m_slow_forces[i]->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(virial_array, access_location::host, access_mode::read);
+        unsigned int virial_pitch = virial_array.getPitch();
+
+        // sum up the energy and virial of the local members of each group
+        for (unsigned int t = 0; t < n_thermos; t++)
+            {
+            std::shared_ptr<ParticleGroup> group = m_thermos[t]->getGroup();
+
+            Scalar energy = m_slow_forces[i]->getExternalEnergy();
+            Scalar virial[6];
+            for (unsigned int k = 0; k < 6; k++)
+                virial[k] = m_slow_forces[i]->getExternalVirial(k);
+
+            for (unsigned int group_idx = 0; group_idx < group->getNumMembers(); group_idx++)
+                {
+                unsigned int j = group->getMemberIndex(group_idx);
+                energy += h_force.data[j].w;
+                for (unsigned int k = 0; k < 6; k++)
+                    virial[k] += h_virial.data[k*virial_pitch+j];
+                }
+
+            m_slow_energy[i*n_thermos+t] = energy;
+            for (unsigned int k = 0; k < 6; k++)
+                m_slow_virial[6*(i*n_thermos+t)+k] = virial[k];
+            }
+        }
+
+    m_compute_time += double(m_compute_clk.getTime() - start_time)/1e9;
+
+    for (unsigned int t = 0; t < n_thermos; t++)
+        {
+        Scalar energy = Scalar(0.0);
+        Scalar virial[6] = {Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0)};
+        for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+            {
+            energy += m_slow_energy[i*n_thermos+t];
+            for (unsigned int k = 0; k < 6; k++)
+                virial[k] += m_slow_virial[6*(i*n_thermos+t)+k];
+            }
+
+        m_thermos[t]->setGroupExternalEnergy(energy);
+        for (unsigned int k = 0; k < 6; k++)
+            m_thermos[t]->setGroupExternalVirial(k, virial[k]);
+        }
+    }
+
+/*! \param timestep Current time step
+    \param apply If true, apply the impulses now
+
+    Every slow force evaluated at \a timestep changes the velocity of the integrated particles by
+    multiple * deltaT / 2 * F / m. The same change is kept by tag and applied again by applyPendingKicks() at the
+    start of the next step, after the particles may have been sorted.
+*/
+void IntegratorTwoStep::kickSlowForces(unsigned int timestep, bool apply)
+    {
+    m_kick_tag.clear();
+    m_kick_dv.clear();
+
+    bool due = false;
+    for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+        due = due || (timestep % getForceMultiple(m_slow_forces[i]) == 0);
+
+    if (!due)
+        return;
+
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // list the particles moved by the integration methods
+    std::vector<unsigned int> kick_idx;
+    std::vector< std::shared_ptr<IntegrationMethodTwoStep> >::iterator method;
+    for (method = m_methods.begin(); method != m_methods.end(); ++method)
+        {
+        std::shared_ptr<ParticleGroup> group = (*method)->getGroup();
+        for (unsigned int group_idx = 0; group_idx < group->getNumMembers(); group_idx++)
+            {
+            unsigned int j = group->getMemberIndex(group_idx);
+            kick_idx.push_back(j);
+            m_kick_tag.push_back(h_tag.data[j]);
+            m_kick_dv.push_back(make_scalar3(0.0, 0.0, 0.0));
+            }
+        }
+
+    for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+        {
+        unsigned int multiple = getForceMultiple(m_slow_forces[i]);
+        if (timestep % multiple != 0)
+            continue;
+
+        Scalar half_dt = Scalar(0.5)*Scalar(multiple)*m_deltaT;
+        ArrayHandle<Scalar4> h_force(m_slow_forces[i]->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int n = 0; n < kick_idx.size(); n++)
+            {
+            unsigned int j = kick_idx[n];
+            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
+            m_kick_dv[n].x += half_dt*h_force.data[j].x*minv;
+            m_kick_dv[n].y += half_dt*h_force.data[j].y*minv;
+            m_kick_dv[n].z += half_dt*h_force.data[j].z*minv;
+            }
+        }
+
+    if (apply)
+        {
+        for (unsigned int n = 0; n < kick_idx.size(); n++)
+            {
+            unsigned int j = kick_idx[n];
+            h_vel.data[j].x += m_kick_dv[n].x;
+            h_vel.data[j].y += m_kick_dv[n].y;
+            h_vel.data[j].z += m_kick_dv[n].z;
+            }
+        }
+    }
+
+/*! Particles that are no longer local are skipped.
+*/
+void IntegratorTwoStep::applyPendingKicks()
+    {
+    if (m_kick_tag.size() == 0)
+        return;
+
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (unsigned int n = 0; n < m_kick_tag.size(); n++)
+        {
+        unsigned int j = h_rtag.data[m_kick_tag[n]];
+        if (j >= m_pdata->getN())
+            continue;
+
+        h_vel.data[j].x += m_kick_dv[n].x;
+        h_vel.data[j].y += m_kick_dv[n].y;
+        h_vel.data[j].z += m_kick_dv[n].z;
+        }
+
+    m_kick_tag.clear();
+    m_kick_dv.clear();
     }
 
 
@@ -341,6 +650,14 @@ void IntegratorTwoStep::setAnisotropicMode(AnisotropicMode mode)
 */
 void IntegratorTwoStep::prepRun(unsigned int timestep)
     {
+    // the impulses of the slow forces bypass the constraint forces, and rigid body constituents are not integrated
+    if (m_slow_forces.size() > 0 && m_constraint_forces.size() > 0)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_standard: Forces can only be evaluated less often than every step"
+                                  << " without rigid bodies and constraints" << endl;
+        throw std::runtime_error("Error preparing the run");
+        }
+
     bool aniso = false;
 
     // set (an-)isotropic integration mode
@@ -390,11 +707,17 @@ void IntegratorTwoStep::prepRun(unsigned int timestep)
 #endif
         computeNetForce(timestep);
 
-    // accelerations only need to be calculated if the accelerations have not yet been set
-    if (!m_pdata->isAccelSet())
+    // evaluate all slow forces for their energy and virial, and the impulses of those starting a period
+    computeSlowForces(timestep, true);
+    kickSlowForces(timestep, false);
+
+    // accelerations only need to be calculated if the accelerations have not yet been set, or if forces have been
+    // moved in or out of the net force
+    if (!m_pdata->isAccelSet() || m_multiples_changed)
         {
         computeAccelerations(timestep);
         m_pdata->notifyAccelSet();
+        m_multiples_changed = false;
         }
 
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
@@ -403,7 +726,8 @@ void IntegratorTwoStep::prepRun(unsigned int timestep)
     m_prepared = true;
     }
 
-/*! Return the combined flags of all integration methods.
+/*! Return the combined flags of all integration methods. The energy and virial are always requested when there are
+    slow forces.
 */
 PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
     {
@@ -417,6 +741,14 @@ PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
         flags |= (*method)->getRequestedPDataFlags();
         }
 
+    // the energy and virial of the slow forces are kept from their last evaluation and used on the steps in
+    // between, so they must be computed on every evaluation, whatever the analyzers request on that step
+    if (m_slow_forces.size() > 0)
+        {
+        flags[pdata_flag::potential_energy] = 1;
+        flags[pdata_flag::pressure_tensor] = 1;
+        }
+
     return flags;
     }
 
@@ -437,6 +769,19 @@ void IntegratorTwoStep::setCommunicator(std::shared_ptr<Communicator> comm)
 
     Integrator::setCommunicator(comm);
     }
+
+/*! \param timestep Time step for which to determine the flags
+    The slow forces are not in the list of forces of the base class, their flags are added here.
+*/
+CommFlags IntegratorTwoStep::determineFlags(unsigned int timestep)
+    {
+    CommFlags flags = Integrator::determineFlags(timestep);
+
+    for (unsigned int i = 0; i < m_slow_forces.size(); i++)
+        flags |= m_slow_forces[i]->getRequestedCommFlags(timestep);
+
+    return flags;
+    }
 #endif
 
 //! Updates the rigid body constituent particles
@@ -466,7 +811,12 @@ void export_IntegratorTwoStep(py::module& m)
         .def("addIntegrationMethod", &IntegratorTwoStep::addIntegrationMethod)
         .def("removeAllIntegrationMethods", &IntegratorTwoStep::removeAllIntegrationMethods)
         .def("setAnisotropicMode", &IntegratorTwoStep::setAnisotropicMode)
+        .def("addForceCompute", &IntegratorTwoStep::addForceCompute)
+        .def("setForceMultiple", &IntegratorTwoStep::setForceMultiple)
+        .def("getForceMultiple", &IntegratorTwoStep::getForceMultiple)
         .def("addForceComposite", &IntegratorTwoStep::addForceComposite)
+        .def("addThermo", &IntegratorTwoStep::addThermo)
+        .def("removeAllThermos", &IntegratorTwoStep::removeAllThermos)
         .def("removeForceComputes", &IntegratorTwoStep::removeForceComputes)
         .def("initializeIntegrationMethods", &IntegratorTwoStep::initializeIntegrationMethods)
         ;
@@ -5,6 +5,7 @@
 // Maintainer: joaander
 
 #include "hoomd/Integrator.h"
+#include "hoomd/ComputeThermo.h"
 #include "IntegrationMethodTwoStep.h"
 
 #include "ForceComposite.h"
@@ -22,6 +23,8 @@
 
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
+#include <map>
+
 //! Integrates the system forward one step with possibly multiple methods
 /*! See IntegrationMethodTwoStep for most of the design notes regarding group integration. IntegratorTwoStep merely
     implements most of the things discussed there.
@@ -39,6 +42,17 @@
     one and two, and which can use the updated particle positions and velocities to update any slaved degrees
     of freedom (rigid bodies).
 
+    Forces can be evaluated less often than every step with multiple time step integration (r-RESPA). A force with a
+    multiple \a k set by setForceMultiple() is not part of the net force. It is evaluated every \a k steps and applied
+    as two velocity impulses of \a k deltaT / 2, one at the end of the step on which it is evaluated and one at the
+    start of the next step. In between, the integration methods integrate the remaining forces with the normal time
+    step. Different forces may use different multiples; nesting them (e.g. 1, 2, 4) gives the usual hierarchy of
+    levels. The potential energy and virial of these forces at their last evaluation are summed over the group of
+    every ComputeThermo registered with addThermo(), so that thermostats, barostats and loggers include the slow
+    forces on the particles of their group on every step. The energy and virial are requested on every step while
+    there are slow forces. Forces that apply torques cannot be slow, and
+    slow forces cannot be combined with rigid bodies or constraint forces, which they would bypass.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
@@ -93,6 +107,21 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         //! Get needed pdata flags
         virtual PDataFlags getRequestedPDataFlags();
 
+        //! Add a ForceCompute to the list
+        virtual void addForceCompute(std::shared_ptr<ForceCompute> fc);
+
+        //! Set the number of time steps between evaluations of a force
+        void setForceMultiple(std::shared_ptr<ForceCompute> fc, unsigned int multiple);
+
+        //! Get the number of time steps between evaluations of a force
+        unsigned int getForceMultiple(std::shared_ptr<ForceCompute> fc) const;
+
+        //! Add a ComputeThermo that includes the slow forces of its group
+        void addThermo(std::shared_ptr<ComputeThermo> thermo);
+
+        //! Remove all ComputeThermos
+        void removeAllThermos();
+
         //! Add a ForceComposite to the list
         virtual void addForceComposite(std::shared_ptr<ForceComposite> fc);
 
@@ -126,6 +155,32 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         AnisotropicMode m_aniso_mode; //!< Anisotropic mode for this integrator
 
         std::vector< std::shared_ptr<ForceComposite> > m_composite_forces; //!< A list of active composite forces
+
+        std::map< std::shared_ptr<ForceCompute>, unsigned int > m_force_multiples; //!< Evaluation period of slow forces
+        std::vector< std::shared_ptr<ForceCompute> > m_slow_forces;  //!< Forces evaluated less often than every step
+        bool m_multiples_changed;                //!< True if a force multiple changed since the last run
+        std::vector< std::shared_ptr<ComputeThermo> > m_thermos;  //!< ComputeThermos that include the slow forces
+        std::vector<Scalar> m_slow_energy;       //!< Energy of each slow force in each thermo group at its last evaluation
+        std::vector<Scalar> m_slow_virial;       //!< Virial of each slow force in each thermo group (6 per entry)
+        std::vector<unsigned int> m_kick_tag;    //!< Tags of the particles with a pending slow force impulse
+        std::vector<Scalar3> m_kick_dv;          //!< Pending velocity change from the slow forces
+
+#ifdef ENABLE_MPI
+        //! Determine the ghost communication flags, including those of the slow forces
+        virtual CommFlags determineFlags(unsigned int timestep);
+#endif
+
+        //! Evaluate the slow forces and sum their energy and virial over the groups of the ComputeThermos
+        void computeSlowForces(unsigned int timestep, bool all);
+
+        //! Remove the slow forces from a ComputeThermo
+        void clearGroupExternal(std::shared_ptr<ComputeThermo> thermo);
+
+        //! Compute the impulses of the slow forces evaluated at this time step
+        void kickSlowForces(unsigned int timestep, bool apply);
+
+        //! Apply the impulses left pending by kickSlowForces()
+        void applyPendingKicks();
     };
 
 //! Exports the IntegratorTwoStep class to python
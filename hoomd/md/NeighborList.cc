@@ -16,6 +16,11 @@ namespace py = pybind11;
 #include <iostream>
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#include <atomic>
+#endif
+
 using namespace std;
 
 /*! \file NeighborList.cc
@@ -33,7 +38,8 @@ using namespace std;
 NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_cut, Scalar r_buff)
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
-      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
+      m_rcut_changed(true), m_n_builds(0), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_dist_checks(0),
+      m_force_update(true),
       m_dist_check(true), m_has_been_updated_once(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
@@ -368,6 +374,7 @@ void NeighborList::compute(unsigned int timestep)
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_n_builds++;
         }
     if (m_prof) m_prof->pop();
     }
@@ -1139,19 +1146,27 @@ bool NeighborList::distanceCheck(unsigned int timestep)
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // max squared displacement for each type (after subtraction of homogeneous dilations)
+    const unsigned int ntypes = m_pdata->getNTypes();
+    m_type_max_dispsq.resize(ntypes);
+    for (unsigned int type = 0; type < ntypes; type++)
         {
-        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
-
         // minimum distance within which all particles should be included
-        Scalar old_rmin = h_rcut_max.data[type_i];
+        Scalar old_rmin = h_rcut_max.data[type];
 
         // maximum value we have checked for neighbors, defined by the buffer layer
         Scalar rmax = old_rmin + m_r_buff;
 
         // max displacement for each particle (after subtraction of homogeneous dilations)
         const Scalar delta_max = (rmax*lambda_min - old_rmin)/Scalar(2.0);
-        Scalar maxsq = (delta_max > 0) ? delta_max*delta_max : 0;
+        m_type_max_dispsq[type] = (delta_max > 0) ? delta_max*delta_max : 0;
+        }
+    const Scalar *maxsq = &m_type_max_dispsq.front();
+
+    // returns true if particle i has moved far enough to require a rebuild
+    auto moved_too_far = [&](unsigned int i) -> bool
+        {
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
 
         Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x*h_last_pos.data[i].x,
                                   h_pos.data[i].y - lambda.y*h_last_pos.data[i].y,
@@ -1159,10 +1174,44 @@ bool NeighborList::distanceCheck(unsigned int timestep)
 
         dx = box.minImage(dx);
 
-        if (dot(dx, dx) >= maxsq)
+        return dot(dx, dx) >= maxsq[type_i];
+        };
+
+    const unsigned int N = m_pdata->getN();
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // all threads stop as soon as one of them finds a particle that moved too far
+        std::atomic<bool> found(false);
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
             {
-            result = true;
-            break;
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                // poll the flag once every 256 particles
+                if ((i & 255) == 0 && found.load(std::memory_order_relaxed))
+                    break;
+
+                if (moved_too_far(i))
+                    {
+                    found.store(true, std::memory_order_relaxed);
+                    break;
+                    }
+                }
+            });
+        result = found.load();
+        }
+    else
+    #endif
+        {
+        for (unsigned int i = 0; i < N; i++)
+            {
+            if (moved_too_far(i))
+                {
+                result = true;
+                break;
+                }
             }
         }
 
@@ -1200,14 +1249,24 @@ void NeighborList::setLastUpdatedPos()
     assert(h_pos.data);
 
     // profile
-    if (m_prof) m_prof->push("Dist check");
+    if (m_prof) m_prof->push("Last pos");
 
     // update the last position arrays
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::overwrite);
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #endif
         {
         h_last_pos.data[i] = make_scalar4(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z, Scalar(0.0));
         }
+    #ifdef ENABLE_TBB
+        });
+    #endif
 
     // update last box nearest plane distance
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
@@ -1284,6 +1343,7 @@ bool NeighborList::needsUpdating(unsigned int timestep)
         else
             {
             result = distanceCheck(timestep);
+            m_dist_checks++;
             }
 
         if (result)
@@ -1327,6 +1387,7 @@ void NeighborList::printStats()
 
     m_exec_conf->msg->notice(1) << "-- Neighborlist stats:" << endl;
     m_exec_conf->msg->notice(1) << m_updates << " normal updates / " << m_forced_updates << " forced updates / " << m_dangerous_updates << " dangerous updates" << endl;
+    m_exec_conf->msg->notice(1) << m_dist_checks << " distance checks" << endl;
 
     // access the number of neighbors to generate stats
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
@@ -1356,7 +1417,7 @@ void NeighborList::printStats()
 
 void NeighborList::resetStats()
     {
-    m_updates = m_forced_updates = m_dangerous_updates = 0;
+    m_updates = m_forced_updates = m_dangerous_updates = m_dist_checks = 0;
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
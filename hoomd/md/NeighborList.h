@@ -430,6 +430,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_updates + m_forced_updates;
             }
 
+        //! Get the number of times the neighbor list has been built
+        /*! Unlike getNumUpdates(), the count is never reset. Consumers compare it to a previously stored value to
+            detect that the list has been rebuilt.
+        */
+        unsigned int getBuildCount() const
+            {
+            return m_n_builds;
+            }
+
 
 #ifdef ENABLE_MPI
         //! Set the communicator to use
@@ -474,6 +483,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         GlobalArray<unsigned int> m_nlist;      //!< Neighbor list data
         GlobalArray<unsigned int> m_n_neigh;    //!< Number of neighbors for each particle
         GlobalArray<Scalar4> m_last_pos;        //!< coordinates of last updated particle positions
+        std::vector<Scalar> m_type_max_dispsq;  //!< Maximum squared displacement per type in the distance check
         Scalar3 m_last_L;                    //!< Box lengths at last update
         Scalar3 m_last_L_local;              //!< Local Box lengths at last update
 
@@ -552,9 +562,11 @@ class PYBIND11_EXPORT NeighborList : public Compute
             m_rcut_changed = true;
             }
 
+        unsigned int m_n_builds;        //!< Number of times the neighbor list has been built (never reset)
         int64_t m_updates;              //!< Number of times the neighbor list has been updated
         int64_t m_forced_updates;       //!< Number of times the neighbor list has been forcibly updated
         int64_t m_dangerous_updates;    //!< Number of dangerous builds counted
+        int64_t m_dist_checks;          //!< Number of distance checks performed
         bool m_force_update;            //!< Flag to handle the forcing of neighborlist updates
         bool m_dist_check;              //!< Set to false to disable distance checks (nlist always built m_every steps)
         bool m_has_been_updated_once;   //!< True if the neighbor list has been updated at least once
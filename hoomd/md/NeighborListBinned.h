@@ -6,6 +6,7 @@
 
 #include "NeighborList.h"
 #include "hoomd/CellList.h"
+#include "hoomd/Autotuner.h"
 
 /*! \file NeighborListBinned.h
     \brief Declares the NeighborListBinned class
@@ -46,8 +47,26 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         //! Set the maximum diameter to use in computing neighbor lists
         virtual void setMaximumDiameter(Scalar d_max);
 
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            NeighborList::setAutotunerParams(enable, period);
+            if (m_cpu_tuner)
+                {
+                m_cpu_tuner->setPeriod(period/10);
+                m_cpu_tuner->setEnabled(enable);
+                }
+            }
+
+        //! Print neighbor list statistics and the tuned grain size
+        virtual void printStats();
+
     protected:
         std::shared_ptr<CellList> m_cl;   //!< The cell list
+        std::unique_ptr<Autotuner> m_cpu_tuner; //!< Autotuner for the grain size of the threaded build (CPU only)
 
         //! Builds the neighbor list
         virtual void buildNlist(unsigned int timestep);
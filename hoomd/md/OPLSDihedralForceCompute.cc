@@ -109,7 +109,6 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     // access the force and virial tensor arrays
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
@@ -126,12 +125,11 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     unsigned int virial_pitch = m_virial.getPitch();
 
     // From LAMMPS OPLS dihedral implementation
-    unsigned int i1,i2,i3,i4,n,dihedral_type;
+    unsigned int i1,i2,i3,i4,n,cur_dihedral,dihedral_type;
     Scalar3 vb1,vb2,vb3,vb2m;
     Scalar4 f1,f2,f3,f4;
     Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
@@ -144,26 +142,26 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box
     const BoxDim& box = m_pdata->getBox();
 
+    // the dihedrals by particle index, ordered by the first member
+    const std::vector<DihedralData::members_t>& table = m_dihedral_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = m_dihedral_data->getCPUTableGroups();
+
     // iterate through each dihedral
     const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
     for (n = 0; n < numDihedrals; n++)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
-        assert(dihedral.tag[0] < m_pdata->getNGlobal());
-        assert(dihedral.tag[1] < m_pdata->getNGlobal());
-        assert(dihedral.tag[2] < m_pdata->getNGlobal());
-        assert(dihedral.tag[3] < m_pdata->getNGlobal());
-
-        // i1 to i4 are the tags
-        i1 = h_rtag.data[dihedral.tag[0]];
-        i2 = h_rtag.data[dihedral.tag[1]];
-        i3 = h_rtag.data[dihedral.tag[2]];
-        i4 = h_rtag.data[dihedral.tag[3]];
+        // lookup the indices of the particles participating in the dihedral
+        const DihedralData::members_t& dihedral_idx = table[n];
+        cur_dihedral = table_group[n];
+        i1 = dihedral_idx.idx[0];
+        i2 = dihedral_idx.idx[1];
+        i3 = dihedral_idx.idx[2];
+        i4 = dihedral_idx.idx[3];
 
         // throw an error if this angle is incomplete
         if (i1 == NOT_LOCAL|| i2 == NOT_LOCAL || i3 == NOT_LOCAL || i4 == NOT_LOCAL)
             {
+            const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(cur_dihedral);
             this->m_exec_conf->msg->error() << "dihedral.opls: dihedral " <<
                 dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
                 << " incomplete." << endl << endl;
@@ -231,7 +229,7 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
         // get values for k1/2 through k4/2
         // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
+        dihedral_type = m_dihedral_data->getTypeByIndex(cur_dihedral);
         k1 = h_params.data[dihedral_type].x;
         k2 = h_params.data[dihedral_type].y;
         k3 = h_params.data[dihedral_type].z;
@@ -3,6 +3,11 @@
 
 #include "PPPMForceCompute.h"
 #include <map>
+#include <algorithm>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 namespace py = pybind11;
 
@@ -147,8 +152,7 @@ PPPMForceCompute::~PPPMForceCompute()
 
     if (m_kiss_fft_initialized)
         {
-        free(m_kiss_fft);
-        free(m_kiss_ifft);
+        m_fft_backend.reset();
         kiss_fft_cleanup();
         }
     #ifdef ENABLE_MPI
@@ -481,13 +485,7 @@ void PPPMForceCompute::initializeFFT()
 
     if (local_fft)
         {
-        int dims[3];
-        dims[0] = m_mesh_points.z;
-        dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
-
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+        m_fft_backend = createFFTBackend(m_mesh_points);
 
         m_kiss_fft_initialized = true;
         }
@@ -522,6 +520,18 @@ void PPPMForceCompute::initializeFFT()
     m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
     }
 
+/*! \param dim Dimensions of the mesh
+    \returns A thread-parallel FFT when running with more than one TBB thread, a serial kiss FFT otherwise
+ */
+std::unique_ptr<FFTBackend> PPPMForceCompute::createFFTBackend(uint3 dim)
+    {
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        return std::unique_ptr<FFTBackend>(new FFTBackendThreaded(m_exec_conf, dim));
+    #endif
+    return std::unique_ptr<FFTBackend>(new FFTBackendKiss(dim));
+    }
+
 //! CPU implementation of sinc(x)==sin(x)/x
 inline Scalar sinc(Scalar x)
     {
@@ -710,6 +720,73 @@ void PPPMForceCompute::computeInfluenceFunction()
     if (m_prof) m_prof->pop();
     }
 
+/*! \param postype Position of the particle
+    \param box The local box
+    \param cell Index of the mesh point the particle is assigned to (output)
+    \param d Distance of the particle to the mesh point in units of the mesh size (output)
+    \returns false if the position is NaN or outside the mesh
+ */
+bool PPPMForceCompute::findCell(const Scalar4& postype, const BoxDim& box, int3& cell, Scalar3& d) const
+    {
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+
+    // ignore if NaN
+    if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+        {
+        return false;
+        }
+
+    // compute coordinates in units of the mesh size
+    Scalar3 f = box.makeFraction(pos);
+    Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
+                                       f.y * (Scalar) m_mesh_points.y,
+                                       f.z * (Scalar) m_mesh_points.z);
+
+    reduced_pos.x += (Scalar) m_n_ghost_cells.x;
+    reduced_pos.y += (Scalar) m_n_ghost_cells.y;
+    reduced_pos.z += (Scalar) m_n_ghost_cells.z;
+
+    Scalar shift, shiftone;
+
+    if (m_order % 2)
+        {
+        shift =0.5;
+        shiftone = 0.0;
+        }
+    else
+        {
+        shift = 0.0;
+        shiftone = 0.5;
+        }
+
+    // find cell of the mesh the particle is in
+    int ix = (reduced_pos.x + shift);
+    int iy = (reduced_pos.y + shift);
+    int iz = (reduced_pos.z + shift);
+
+    d.x = shiftone+(Scalar)ix-reduced_pos.x;
+    d.y = shiftone+(Scalar)iy-reduced_pos.y;
+    d.z = shiftone+(Scalar)iz-reduced_pos.z;
+
+    // handle particles on the boundary
+    if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
+        ix = 0;
+    if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
+        iy = 0;
+    if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
+        iz = 0;
+
+    if (ix < 0 || ix >= (int)m_grid_dim.x ||
+        iy < 0 || iy >= (int)m_grid_dim.y ||
+        iz < 0 || iz >= (int)m_grid_dim.z)
+        {
+        return false;
+        }
+
+    cell = make_int3(ix, iy, iz);
+    return true;
+    }
+
 //! Assignment of particles to mesh using variable order interpolation scheme
 void PPPMForceCompute::assignParticles()
     {
@@ -728,87 +805,35 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+    int mult_fact = 2*m_order+1;
 
-        Scalar4 postype = h_postype.data[idx];
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    int nlower = -(m_order-1)/2;
+    int nupper = m_order/2;
 
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+    // spread the charge of a single particle over the stencil
+    auto assign_particle = [&](unsigned int idx)
+        {
+        int3 cell;
+        Scalar3 d;
+        if (!findCell(h_postype.data[idx], box, cell, d))
             {
-            continue;
+            // ignore, error will be thrown elsewhere (in CellList)
+            return;
             }
 
         Scalar qi = h_charge.data[idx];
 
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
-                                           f.y * (Scalar) m_mesh_points.y,
-                                           f.z * (Scalar) m_mesh_points.z);
-
-        reduced_pos.x += (Scalar) m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar) m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar) m_n_ghost_cells.z;
-
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift =0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
-        // find cell of the mesh the particle is in
-        int ix = (reduced_pos.x + shift);
-        int iy = (reduced_pos.y + shift);
-        int iz = (reduced_pos.z + shift);
-
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
-
-
-        // handle particles on the boundary
-        if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
-
-        if (ix < 0 || ix >= (int)m_grid_dim.x ||
-            iy < 0 || iy >= (int)m_grid_dim.y ||
-            iz < 0 || iz >= (int)m_grid_dim.z)
-            {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
-
-        int mult_fact = 2*m_order+1;
         Scalar Wx, Wy, Wz;
 
-        int nlower = -(m_order-1)/2;
-        int nupper = m_order/2;
-
         for (int i = nlower; i <= nupper ; ++i)
             {
             Wx = Scalar(0.0);
             for (int iorder = m_order-1; iorder >= 0; iorder--)
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
+                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * d.x;
                 }
 
-            int neighi = (int)ix + i;
+            int neighi = cell.x + i;
 
             if (! m_n_ghost_cells.x)
                 {
@@ -824,10 +849,10 @@ void PPPMForceCompute::assignParticles()
                 Wy = Scalar(0.0);
                 for (int iorder = m_order-1; iorder >= 0; iorder--)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
+                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * d.y;
                     }
 
-                int neighj = (int)iy + j;
+                int neighj = cell.y + j;
 
                 if (! m_n_ghost_cells.y)
                     {
@@ -842,10 +867,10 @@ void PPPMForceCompute::assignParticles()
                     Wz = Scalar(0.0);
                     for (int iorder = m_order-1; iorder >= 0; iorder--)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
+                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * d.z;
                         }
 
-                    int neighk = (int)iz + k;
+                    int neighk = cell.z + k;
                     if (! m_n_ghost_cells.z)
                         {
                         if (neighk >= (int)m_grid_dim.z)
@@ -863,7 +888,88 @@ void PPPMForceCompute::assignParticles()
                     }
                 }
             }
-        } // end loop over particles
+        };
+
+    unsigned int group_size = m_group->getNumMembers();
+
+    #ifdef ENABLE_TBB
+    // split the mesh into tiles of at least m_order points along y and z, the stencils of two particles overlap
+    // only if their tiles are neighbors
+    uint2 n_tiles = make_uint2(m_grid_dim.y / m_order, m_grid_dim.z / m_order);
+
+    // with periodic wrapping the first and the last tile are neighbors, and need to differ in color
+    if (!m_n_ghost_cells.y && n_tiles.x % 2)
+        n_tiles.x--;
+    if (!m_n_ghost_cells.z && n_tiles.y % 2)
+        n_tiles.y--;
+    n_tiles.x = std::max(n_tiles.x, 1u);
+    n_tiles.y = std::max(n_tiles.y, 1u);
+    const unsigned int n_tile = n_tiles.x*n_tiles.y;
+
+    if (m_exec_conf->getNumThreads() > 1 && n_tile > 1)
+        {
+        // sort the particles by tile
+        m_tile_idx.resize(group_size);
+        m_tile_offset.assign(n_tile+1, 0);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int idx = m_group->getMemberIndex(group_idx);
+
+            int3 cell;
+            Scalar3 d;
+            unsigned int tile = n_tile;
+            if (findCell(h_postype.data[idx], box, cell, d))
+                {
+                unsigned int ty = std::min((unsigned int)cell.y / m_order, n_tiles.x-1);
+                unsigned int tz = std::min((unsigned int)cell.z / m_order, n_tiles.y-1);
+                tile = ty + n_tiles.x*tz;
+                m_tile_offset[tile+1]++;
+                }
+            m_tile_idx[group_idx] = tile;
+            }
+
+        for (unsigned int tile = 0; tile < n_tile; ++tile)
+            m_tile_offset[tile+1] += m_tile_offset[tile];
+
+        std::vector<unsigned int> tile_fill(m_tile_offset.begin(), m_tile_offset.end()-1);
+        m_tile_members.resize(m_tile_offset[n_tile]);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int tile = m_tile_idx[group_idx];
+            if (tile < n_tile)
+                m_tile_members[tile_fill[tile]++] = m_group->getMemberIndex(group_idx);
+            }
+
+        // process the four colors of the checkerboard one after another
+        std::vector<unsigned int> tiles;
+        for (unsigned int color = 0; color < 4; ++color)
+            {
+            tiles.clear();
+            for (unsigned int tz = (color / 2); tz < n_tiles.y; tz += 2)
+                for (unsigned int ty = (color % 2); ty < n_tiles.x; ty += 2)
+                    tiles.push_back(ty + n_tiles.x*tz);
+
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, tiles.size(), 1),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    unsigned int tile = tiles[i];
+                    for (unsigned int j = m_tile_offset[tile]; j < m_tile_offset[tile+1]; ++j)
+                        assign_particle(m_tile_members[j]);
+                    }
+                });
+            }
+        }
+    else
+    #endif
+        {
+        // loop over group
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            assign_particle(m_group->getMemberIndex(group_idx));
+            }
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -877,7 +983,7 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        m_fft_backend->forward(h_mesh.data, h_fourier_mesh.data);
         if (m_prof) m_prof->pop();
         }
 
@@ -946,9 +1052,9 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        m_fft_backend->inverse(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
+        m_fft_backend->inverse(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+        m_fft_backend->inverse(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
         if (m_prof) m_prof->pop();
         }
 
@@ -1012,150 +1118,121 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
-        Scalar4 postype = h_postype.data[idx];
-
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
-            {
-            continue;
-            }
-
-        Scalar qi = h_charge.data[idx];
-
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
-                                           f.y * (Scalar) m_mesh_points.y,
-                                           f.z * (Scalar) m_mesh_points.z);
-        reduced_pos.x += (Scalar) m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar) m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar) m_n_ghost_cells.z;
-
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift =0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
+    int mult_fact = 2*m_order+1;
 
-        // find cell of the force mesh the particle is in
-        int ix = (reduced_pos.x + shift);
-        int iy = (reduced_pos.y + shift);
-        int iz = (reduced_pos.z + shift);
+    int nlower = -(m_order-1)/2;
+    int nupper = m_order/2;
 
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
-
-        // handle particles on the boundary
-        if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
-
-        if (ix < 0 || ix >= (int)m_grid_dim.x ||
-            iy < 0 || iy >= (int)m_grid_dim.y ||
-            iz < 0 || iz >= (int)m_grid_dim.z)
+    // gather the force on a range of group members, every particle only writes its own force
+    auto interpolate_range = [&](unsigned int first, unsigned int last)
+        {
+        for (unsigned int group_idx = first; group_idx < last; group_idx++)
             {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
+            unsigned int idx = m_group->getMemberIndex(group_idx);
 
-        Scalar3 force = make_scalar3(0.0,0.0,0.0);
-
-        int mult_fact = 2*m_order+1;
-        Scalar Wx, Wy, Wz;
-
-        int nlower = -(m_order-1)/2;
-        int nupper = m_order/2;
-
-        for (int i = nlower; i <= nupper ; ++i)
-            {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order-1; iorder >= 0; iorder--)
+            int3 cell;
+            Scalar3 d;
+            if (!findCell(h_postype.data[idx], box, cell, d))
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
+                // ignore, error will be thrown elsewhere (in CellList)
+                continue;
                 }
 
-            int neighi = (int)ix + i;
+            Scalar qi = h_charge.data[idx];
 
-            if (! m_n_ghost_cells.x)
-                {
-                if (neighi >= (int)m_grid_dim.x)
-                    neighi -= m_grid_dim.x;
-                else if (neighi < 0)
-                    neighi += m_grid_dim.x;
-                }
+            Scalar3 force = make_scalar3(0.0,0.0,0.0);
 
+            Scalar Wx, Wy, Wz;
 
-            for (int j = nlower; j <= nupper; ++j)
+            for (int i = nlower; i <= nupper ; ++i)
                 {
-                Wy = Scalar(0.0);
+                Wx = Scalar(0.0);
                 for (int iorder = m_order-1; iorder >= 0; iorder--)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
+                    Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * d.x;
                     }
 
-                int neighj = (int)iy + j;
+                int neighi = cell.x + i;
 
-                if (! m_n_ghost_cells.y)
+                if (! m_n_ghost_cells.x)
                     {
-                    if (neighj >= (int)m_grid_dim.y)
-                        neighj -= m_grid_dim.y;
-                    else if (neighj < 0)
-                        neighj += m_grid_dim.y;
+                    if (neighi >= (int)m_grid_dim.x)
+                        neighi -= m_grid_dim.x;
+                    else if (neighi < 0)
+                        neighi += m_grid_dim.x;
                     }
 
 
-                for (int k = nlower; k <= nupper; ++k)
+                for (int j = nlower; j <= nupper; ++j)
                     {
-                    Wz = Scalar(0.0);
+                    Wy = Scalar(0.0);
                     for (int iorder = m_order-1; iorder >= 0; iorder--)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
+                        Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * d.y;
                         }
 
-                    int neighk = (int)iz + k;
-                    if (! m_n_ghost_cells.z)
+                    int neighj = cell.y + j;
+
+                    if (! m_n_ghost_cells.y)
                         {
-                        if (neighk >= (int)m_grid_dim.z)
-                            neighk -= m_grid_dim.z;
-                        else if (neighk < 0)
-                            neighk += m_grid_dim.z;
+                        if (neighj >= (int)m_grid_dim.y)
+                            neighj -= m_grid_dim.y;
+                        else if (neighj < 0)
+                            neighj += m_grid_dim.y;
                         }
 
-                    unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
-                    kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
-                    kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
+                    for (int k = nlower; k <= nupper; ++k)
+                        {
+                        Wz = Scalar(0.0);
+                        for (int iorder = m_order-1; iorder >= 0; iorder--)
+                            {
+                            Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * d.z;
+                            }
+
+                        int neighk = cell.z + k;
+                        if (! m_n_ghost_cells.z)
+                            {
+                            if (neighk >= (int)m_grid_dim.z)
+                                neighk -= m_grid_dim.z;
+                            else if (neighk < 0)
+                                neighk += m_grid_dim.z;
+                            }
+
+                        unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
+
+                        kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
+                        kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
+                        kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
 
-                    Scalar W = Wx * Wy * Wz;
-                    force.x += qi*W*E_x.r;
-                    force.y += qi*W*E_y.r;
-                    force.z += qi*W*E_z.r;
+                        Scalar W = Wx * Wy * Wz;
+                        force.x += qi*W*E_x.r;
+                        force.y += qi*W*E_y.r;
+                        force.z += qi*W*E_z.r;
+                        }
                     }
                 }
-            }
 
-        h_force.data[idx] = make_scalar4(force.x,force.y,force.z,0.0);
-        }  // end of loop over particles
+            h_force.data[idx] = make_scalar4(force.x,force.y,force.z,0.0);
+            }  // end of loop over particles
+        };
+
+    unsigned int group_size = m_group->getNumMembers();
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            interpolate_range(r.begin(), r.end());
+            });
+        }
+    else
+    #endif
+        {
+        interpolate_range(0, group_size);
+        }
 
     if (m_prof) m_prof->pop();
     }
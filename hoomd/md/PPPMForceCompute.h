@@ -14,6 +14,7 @@
 #endif
 
 #include "hoomd/extern/kiss_fftnd.h"
+#include "FFTBackend.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -23,6 +24,13 @@ const Scalar EPS_HOC(1.0e-7);
 const unsigned int PPPM_MAX_ORDER = 7;
 
 /*! Compute the long-ranged part of the particle-particle particle-mesh Ewald sum (PPPM)
+
+    On a single rank, the mesh is transformed by a local FFTBackend created by createFFTBackend(). With more than one
+    TBB thread, the FFTs, the charge assignment and the force interpolation run in parallel. Charges are spread in a
+    colored order: the mesh is split into tiles along y and z that are wider than the interpolation stencil, and the
+    particles in tiles of the same color of a checkerboard are assigned concurrently since their stencils never
+    overlap. The ghost cells of a distributed mesh are part of the tiles, so the CommunicatorGrid exchange is
+    unchanged.
  */
 class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     {
@@ -177,9 +185,14 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Compute rigid body correction
         virtual void computeBodyCorrection();
 
+        //! Create the backend for FFTs local to this rank
+        virtual std::unique_ptr<FFTBackend> createFFTBackend(uint3 dim);
+
+        //! Find the mesh point closest to a particle
+        bool findCell(const Scalar4& postype, const BoxDim& box, int3& cell, Scalar3& d) const;
+
     private:
-        kiss_fftnd_cfg m_kiss_fft;         //!< The FFT configuration
-        kiss_fftnd_cfg m_kiss_ifft;        //!< Inverse FFT configuration
+        std::unique_ptr<FFTBackend> m_fft_backend; //!< Local FFT (if not distributed)
 
         #ifdef ENABLE_MPI
         dfft_plan m_dfft_plan_forward;     //!< Distributed FFT for forward transform
@@ -188,7 +201,11 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> > m_grid_comm_reverse; //!< Communicator for inv fourier mesh
         #endif
 
-        bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
+        bool m_kiss_fft_initialized;               //!< True if a local FFT has been set up
+
+        std::vector<unsigned int> m_tile_idx;      //!< Tile of every group member for colored charge assignment
+        std::vector<unsigned int> m_tile_offset;   //!< Offset of the first particle in every tile
+        std::vector<unsigned int> m_tile_members;  //!< Particle indices sorted by tile
 
         GlobalArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
@@ -0,0 +1,241 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#ifndef __PAIR_EVALUATOR_BATCH_H__
+#define __PAIR_EVALUATOR_BATCH_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "EvaluatorPairLJ.h"
+#include "EvaluatorPairYukawa.h"
+#include "EvaluatorPairGauss.h"
+#include "EvaluatorPairForceShiftedLJ.h"
+#include "EvaluatorPairMie.h"
+
+/*! \file PairEvaluatorBatch.h
+    \brief Defines the trait used by PotentialPair to evaluate batches of neighbors on the CPU
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Number of neighbors PotentialPair gathers into one batch
+/*! One batch fills a full AVX-512 register, or two AVX2 registers.
+*/
+#ifdef SINGLE_PRECISION
+const unsigned int pair_batch_width = 16;
+#else
+const unsigned int pair_batch_width = 8;
+#endif
+
+//! Trait that evaluates a pair potential on a batch of neighbors stored in SoA lanes
+/*! The scalar code path of PotentialPair constructs one evaluator per neighbor and calls evalForceAndEnergy() on it,
+    which compilers cannot vectorize. An evaluator opts into the batched code path by specializing this template with
+    \a supported set to true and an implementation of evalForceAndEnergy() that processes \a n lanes at once.
+
+    The batched implementation must be branch free across lanes: lanes that are outside of the cutoff (or that the
+    scalar evaluator would not evaluate) are masked and must return 0 in both \a force_divr and \a pair_eng. Written
+    this way, the loop over lanes vectorizes to AVX2 or AVX-512 instructions when the compiler targets them.
+
+    Only evaluators that need neither diameter nor charge can be batched. The batched path is never used with XPLOR
+    smoothing, so \a energy_shift is the same for all lanes.
+*/
+template< class evaluator >
+struct PairEvaluatorBatch
+    {
+    //! True if the evaluator provides a batched implementation
+    static const bool supported = false;
+
+    //! Evaluate the force and energy of a batch of pairs
+    /*! \param n Number of lanes in the batch (at most pair_batch_width)
+        \param rsq Squared distance of each pair
+        \param rcutsq Squared cutoff of each pair
+        \param params Parameters of each pair
+        \param force_divr Output force divided by r for each pair
+        \param pair_eng Output pair energy for each pair
+        \param energy_shift If true, the potential is shifted to 0 at the cutoff
+    */
+    static void evalForceAndEnergy(unsigned int n, const Scalar *rsq, const Scalar *rcutsq,
+        const typename evaluator::param_type *params, Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+        {
+        }
+    };
+
+//! Batched evaluation of EvaluatorPairLJ
+template<>
+struct PairEvaluatorBatch<EvaluatorPairLJ>
+    {
+    static const bool supported = true;
+
+    static void evalForceAndEnergy(unsigned int n, const Scalar *rsq, const Scalar *rcutsq,
+        const Scalar2 *params, Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar lj1 = params[k].x;
+            const Scalar lj2 = params[k].y;
+            const bool active = rsq[k] < rcutsq[k] && lj1 != Scalar(0.0);
+
+            Scalar r2inv = Scalar(1.0)/(active ? rsq[k] : Scalar(1.0));
+            Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar f = r2inv * r6inv * (Scalar(12.0)*lj1*r6inv - Scalar(6.0)*lj2);
+            Scalar e = r6inv * (lj1*r6inv - lj2);
+
+            Scalar rcut2inv = Scalar(1.0)/rcutsq[k];
+            Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+            if (energy_shift)
+                e -= rcut6inv * (lj1*rcut6inv - lj2);
+
+            force_divr[k] = active ? f : Scalar(0.0);
+            pair_eng[k] = active ? e : Scalar(0.0);
+            }
+        }
+    };
+
+//! Batched evaluation of EvaluatorPairYukawa
+template<>
+struct PairEvaluatorBatch<EvaluatorPairYukawa>
+    {
+    static const bool supported = true;
+
+    static void evalForceAndEnergy(unsigned int n, const Scalar *rsq, const Scalar *rcutsq,
+        const Scalar2 *params, Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar epsilon = params[k].x;
+            const Scalar kappa = params[k].y;
+            const bool active = rsq[k] < rcutsq[k] && epsilon != Scalar(0.0);
+
+            Scalar rsq_k = active ? rsq[k] : Scalar(1.0);
+            Scalar rinv = fast::rsqrt(rsq_k);
+            Scalar r = Scalar(1.0) / rinv;
+            Scalar r2inv = Scalar(1.0) / rsq_k;
+
+            Scalar exp_val = fast::exp(-kappa * r);
+            Scalar f = epsilon * exp_val * r2inv * (rinv + kappa);
+            Scalar e = epsilon * exp_val * rinv;
+
+            if (energy_shift)
+                {
+                Scalar rcutinv = fast::rsqrt(rcutsq[k]);
+                Scalar rcut = Scalar(1.0) / rcutinv;
+                e -= epsilon * fast::exp(-kappa * rcut) * rcutinv;
+                }
+
+            force_divr[k] = active ? f : Scalar(0.0);
+            pair_eng[k] = active ? e : Scalar(0.0);
+            }
+        }
+    };
+
+//! Batched evaluation of EvaluatorPairGauss
+template<>
+struct PairEvaluatorBatch<EvaluatorPairGauss>
+    {
+    static const bool supported = true;
+
+    static void evalForceAndEnergy(unsigned int n, const Scalar *rsq, const Scalar *rcutsq,
+        const Scalar2 *params, Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar epsilon = params[k].x;
+            const Scalar sigma = params[k].y;
+            const bool active = rsq[k] < rcutsq[k];
+
+            Scalar sigma_sq = sigma*sigma;
+            Scalar r_over_sigma_sq = (active ? rsq[k] : Scalar(0.0)) / sigma_sq;
+            Scalar exp_val = fast::exp(-Scalar(1.0)/Scalar(2.0) * r_over_sigma_sq);
+
+            Scalar f = epsilon / sigma_sq * exp_val;
+            Scalar e = epsilon * exp_val;
+
+            if (energy_shift)
+                e -= epsilon * fast::exp(-Scalar(1.0)/Scalar(2.0) * rcutsq[k] / sigma_sq);
+
+            force_divr[k] = active ? f : Scalar(0.0);
+            pair_eng[k] = active ? e : Scalar(0.0);
+            }
+        }
+    };
+
+//! Batched evaluation of EvaluatorPairForceShiftedLJ
+template<>
+struct PairEvaluatorBatch<EvaluatorPairForceShiftedLJ>
+    {
+    static const bool supported = true;
+
+    static void evalForceAndEnergy(unsigned int n, const Scalar *rsq, const Scalar *rcutsq,
+        const Scalar2 *params, Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar lj1 = params[k].x;
+            const Scalar lj2 = params[k].y;
+            const bool active = rsq[k] < rcutsq[k] && lj1 != Scalar(0.0);
+
+            Scalar rsq_k = active ? rsq[k] : Scalar(1.0);
+            Scalar r2inv = Scalar(1.0)/rsq_k;
+            Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar f = r2inv * r6inv * (Scalar(12.0)*lj1*r6inv - Scalar(6.0)*lj2);
+            Scalar e = r6inv * (lj1*r6inv - lj2);
+
+            Scalar rcut2inv = Scalar(1.0)/rcutsq[k];
+            Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+
+            if (energy_shift)
+                e -= rcut6inv * (lj1*rcut6inv - lj2);
+
+            // shift force and add linear term to potential
+            Scalar rcut_r_inv = fast::rsqrt(rsq_k*rcutsq[k]);
+            Scalar force_rcut_at_rcut = rcut6inv * (Scalar(12.0)*lj1*rcut6inv - Scalar(6.0)*lj2);
+            f -= rcut_r_inv * force_rcut_at_rcut;
+            e += (rsq_k*rcut_r_inv-Scalar(1.0))*force_rcut_at_rcut;
+
+            force_divr[k] = active ? f : Scalar(0.0);
+            pair_eng[k] = active ? e : Scalar(0.0);
+            }
+        }
+    };
+
+//! Batched evaluation of EvaluatorPairMie
+template<>
+struct PairEvaluatorBatch<EvaluatorPairMie>
+    {
+    static const bool supported = true;
+
+    static void evalForceAndEnergy(unsigned int n, const Scalar *rsq, const Scalar *rcutsq,
+        const Scalar4 *params, Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar mie1 = params[k].x;
+            const Scalar mie2 = params[k].y;
+            const Scalar mie3 = params[k].z;
+            const Scalar mie4 = params[k].w;
+            const bool active = rsq[k] < rcutsq[k] && mie1 != Scalar(0.0);
+
+            Scalar r2inv = Scalar(1.0)/(active ? rsq[k] : Scalar(1.0));
+            Scalar rninv = pow(r2inv,mie3/Scalar(2.0));
+            Scalar rminv = pow(r2inv,mie4/Scalar(2.0));
+            Scalar f = r2inv * (mie3 * mie1 * rninv - mie4 * mie2 * rminv);
+            Scalar e = mie1 * rninv - mie2 * rminv;
+
+            if (energy_shift)
+                {
+                Scalar rcutninv = Scalar(1.0)/pow(rcutsq[k],mie3/Scalar(2.0));
+                Scalar rcutminv = Scalar(1.0)/pow(rcutsq[k],mie4/Scalar(2.0));
+                e -= mie1 * rcutninv - mie2* rcutminv;
+                }
+
+            force_divr[k] = active ? f : Scalar(0.0);
+            pair_eng[k] = active ? e : Scalar(0.0);
+            }
+        }
+    };
+
+#endif // __PAIR_EVALUATOR_BATCH_H__
@@ -149,7 +149,6 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
@@ -182,6 +181,9 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     for (unsigned int i = 0; i< 6; i++)
         bond_virial[i]=Scalar(0.0);
 
+    // the bonds by particle index, ordered by the first member
+    const std::vector<typename BondData::members_t>& table = m_bond_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = m_bond_data->getCPUTableGroups();
     ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
     ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
 
@@ -191,19 +193,16 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     const unsigned int size = (unsigned int)m_bond_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
+        // lookup the indices of the particles participating in the bond
+        const typename BondData::members_t& bond_idx = table[i];
+        unsigned int cur_bond = table_group[i];
+        unsigned int idx_a = bond_idx.idx[0];
+        unsigned int idx_b = bond_idx.idx[1];
 
         // throw an error if this bond is incomplete
         if (idx_a >= max_local || idx_b >= max_local)
             {
+            const typename BondData::members_t& bond = h_bonds.data[cur_bond];
             this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
                 bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
             throw std::runtime_error("Error in bond calculation");
@@ -241,7 +240,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar rsq = dot(dx,dx);
 
         // get parameters for this bond type
-        param_type param = h_params.data[h_typeval.data[i].type];
+        param_type param = h_params.data[h_typeval.data[cur_bond].type];
 
         // compute the force and potential energy
         Scalar force_divr = Scalar(0.0);
@@ -17,7 +17,9 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/ForceCompute.h"
+#include "hoomd/Autotuner.h"
 #include "NeighborList.h"
+#include "PairEvaluatorBatch.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
 #ifdef ENABLE_CUDA
@@ -28,6 +30,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -130,11 +136,48 @@ class PotentialPair : public ForceCompute
             m_shift_mode = mode;
             }
 
+        //! Enable or disable the batched CPU evaluation for evaluators that support it
+        /*! \param vectorize True to evaluate neighbors in batches of SoA lanes (see PairEvaluatorBatch)
+        */
+        void setVectorize(bool vectorize)
+            {
+            if (vectorize && !PairEvaluatorBatch<evaluator>::supported)
+                {
+                m_exec_conf->msg->warning() << "pair." << evaluator::getName()
+                                            << ": Vectorized evaluation is not supported, ignoring" << std::endl;
+                }
+            m_vectorize = vectorize;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
         #endif
 
+        #ifdef ENABLE_TBB
+        //! Set autotuner parameters
+        /*! \param enable Enable/disable autotuning
+            \param period period (approximate) in time steps when returning occurs
+        */
+        virtual void setAutotunerParams(bool enable, unsigned int period)
+            {
+            ForceCompute::setAutotunerParams(enable, period);
+            if (m_cpu_tuner)
+                {
+                m_cpu_tuner->setPeriod(period);
+                m_cpu_tuner->setEnabled(enable);
+                }
+            }
+
+        //! Print the tuned grain size of the threaded force loop
+        virtual void printStats()
+            {
+            ForceCompute::printStats();
+            if (m_cpu_tuner && m_exec_conf->getNumThreads() > 1)
+                m_cpu_tuner->printStats();
+            }
+        #endif
+
         //! Calculates the energy between two lists of particles.
         template< class InputIterator >
         void computeEnergyBetweenSets(  InputIterator first1, InputIterator last1,
@@ -159,6 +202,7 @@ class PotentialPair : public ForceCompute
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
+        bool m_vectorize;                           //!< True if the batched evaluation should be used when supported
         Index2D m_typpair_idx;                      //!< Helper class for indexing per type pair arrays
         GlobalArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
         GlobalArray<Scalar> m_ronsq;                   //!< ron squared per type pair
@@ -166,9 +210,42 @@ class PotentialPair : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        //! Reaction force and virial on a particle owned by another thread (half neighbor list)
+        struct PairReaction
+            {
+            unsigned int idx;   //!< Index of the particle
+            Scalar4 force;      //!< Force and potential energy
+            Scalar virial[6];   //!< Virial
+            };
+
+        #ifdef ENABLE_TBB
+        std::vector< std::vector<PairReaction> > m_thread_reactions; //!< Deferred reactions of every chunk (half neighbor list)
+        std::unique_ptr<Autotuner> m_cpu_tuner;     //!< Autotuner for the grain size of the threaded loops
+        #endif
+
+        #ifdef ENABLE_MPI
+        std::vector<unsigned int> m_interior_list;  //!< Local particles without ghost neighbors
+        std::vector<unsigned int> m_boundary_list;  //!< Local particles with at least one ghost neighbor
+        unsigned int m_split_builds;                //!< Neighbor list build count at which the lists were split
+        unsigned int m_split_N;                     //!< Number of local particles at which the lists were split
+        bool m_interior_valid;                      //!< True if the interior forces are valid for m_interior_timestep
+        unsigned int m_interior_timestep;           //!< Time step of the last interior force computation
+        #endif
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces on a subset of the local particles
+        void computeForceList(const unsigned int *list, unsigned int n_list, bool zero);
+
+        #ifdef ENABLE_MPI
+        //! Compute the forces on particles without ghost neighbors
+        virtual void computeInteriorForces(unsigned int timestep);
+
+        //! Split the local particles into interior and boundary particles
+        void splitInteriorBoundary();
+        #endif
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -220,7 +297,11 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_vectorize(false),
+      m_typpair_idx(m_pdata->getNTypes())
+      #ifdef ENABLE_MPI
+      , m_split_builds(0), m_split_N(0), m_interior_valid(false), m_interior_timestep(0)
+      #endif
     {
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
@@ -254,6 +335,22 @@ PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysd
         }
     #endif
 
+    #ifdef ENABLE_TBB
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        // tune the number of particles that one TBB task processes with the host clock, the tuner is only
+        // used when running with more than one thread
+        std::vector<unsigned int> valid_params;
+        for (unsigned int grain = 16; grain <= 4096; grain *= 2)
+            valid_params.push_back(grain);
+
+        // the tuner is not synchronized across ranks: the grain size only affects the scheduling on this rank, and
+        // ranks that compute their interior forces early time a different number of complete force computations
+        m_cpu_tuner.reset(new Autotuner(valid_params, 5, 100000, "pair_" + evaluator::getName() + "_grain",
+            m_exec_conf));
+        }
+    #endif
+
     // initialize name
     m_prof_name = std::string("Pair ") + evaluator::getName();
     m_log_name = std::string("pair_") + evaluator::getName() + std::string("_energy") + log_suffix;
@@ -396,6 +493,34 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    #ifdef ENABLE_MPI
+    // the interior forces computed while the ghost update was in flight remain valid if the neighbor list was not
+    // rebuilt since, complete them with the forces on the boundary particles
+    const bool interior_valid = m_interior_valid && m_interior_timestep == timestep
+        && m_split_builds == m_nlist->getBuildCount() && m_split_N == m_pdata->getN();
+    m_interior_valid = false;
+
+    if (interior_valid)
+        computeForceList(m_boundary_list.data(), (unsigned int)m_boundary_list.size(), false);
+    else
+    #endif
+        {
+        computeForceList(NULL, m_pdata->getN(), true);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param list Indices of the local particles to compute the forces on, NULL computes the forces on particles
+        0..n_list-1
+    \param n_list Number of particles in \a list
+    \param zero True if the force and virial arrays should be zeroed first
+
+    With a half neighbor list, the reaction forces are also applied to particles not in \a list.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeForceList(const unsigned int *list, unsigned int n_list, bool zero)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -412,8 +537,8 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
 
     //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, zero ? access_mode::overwrite : access_mode::readwrite);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, zero ? access_mode::overwrite : access_mode::readwrite);
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
@@ -425,184 +550,442 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
-
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    if (zero)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
 
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+    const unsigned int N = m_pdata->getN();
 
-        // access diameter and charge (if needed)
-        Scalar di = Scalar(0.0);
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+    // use the batched evaluation if the evaluator supports it and it was requested, XPLOR smoothing is not supported
+    const bool use_batch = PairEvaluatorBatch<evaluator>::supported && m_vectorize && m_shift_mode != xplor;
 
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+    // adds the reaction force from the third law to particle j, or defers it if j is outside owned_begin..owned_end-1
+    auto add_reaction = [&](unsigned int j, const Scalar3& dx, Scalar force_divr, Scalar pair_eng,
+        unsigned int owned_begin, unsigned int owned_end, std::vector<PairReaction> *reactions)
+        {
+        Scalar force_div2r = force_divr * Scalar(0.5);
+        PairReaction r;
+        r.idx = j;
+        r.force = make_scalar4(-dx.x*force_divr, -dx.y*force_divr, -dx.z*force_divr, pair_eng * Scalar(0.5));
+        if (compute_virial)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
+            r.virial[0] = force_div2r*dx.x*dx.x;
+            r.virial[1] = force_div2r*dx.x*dx.y;
+            r.virial[2] = force_div2r*dx.x*dx.z;
+            r.virial[3] = force_div2r*dx.y*dx.y;
+            r.virial[4] = force_div2r*dx.y*dx.z;
+            r.virial[5] = force_div2r*dx.z*dx.z;
+            }
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+        if (j < owned_begin || j >= owned_end)
+            {
+            reactions->push_back(r);
+            return;
+            }
 
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
+        h_force.data[j].x += r.force.x;
+        h_force.data[j].y += r.force.y;
+        h_force.data[j].z += r.force.z;
+        h_force.data[j].w += r.force.w;
+        if (compute_virial)
+            for (unsigned int l = 0; l < 6; l++)
+                h_virial.data[l*m_virial_pitch+j] += r.virial[l];
+        };
+
+    // computes the forces on list entries first..last-1 and accumulates them into the force and virial arrays.
+    // Reaction forces from the third law on particles owned_begin..owned_end-1 are accumulated into the same arrays,
+    // the others are appended to reactions.
+    auto compute_range = [&](unsigned int first, unsigned int last, unsigned int owned_begin, unsigned int owned_end,
+        std::vector<PairReaction> *reactions)
+        {
+        for (unsigned int k = first; k < last; k++)
+            {
+            const unsigned int i = list ? list[k] : k;
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
-                {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
+            // access diameter and charge (if needed)
+            Scalar di = Scalar(0.0);
+            Scalar qi = Scalar(0.0);
             if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
+                di = h_diameter.data[i];
             if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-            if (evaluated)
+                qi = h_charge.data[i];
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar3 fi = make_scalar3(0, 0, 0);
+            Scalar pei = 0.0;
+            Scalar virialxxi = 0.0;
+            Scalar virialxyi = 0.0;
+            Scalar virialxzi = 0.0;
+            Scalar virialyyi = 0.0;
+            Scalar virialyzi = 0.0;
+            Scalar virialzzi = 0.0;
+
+            // loop over all of the neighbors of this particle
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+
+            if (use_batch)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                // gather the neighbors into SoA lanes and evaluate them one batch at a time
+                for (unsigned int k_first = 0; k_first < size; k_first += pair_batch_width)
                     {
-                    if (rsq >= ronsq && rsq < rcutsq)
+                    const unsigned int n_lanes = std::min(size - k_first, pair_batch_width);
+                    unsigned int lane_j[pair_batch_width];
+                    Scalar lane_dx[pair_batch_width];
+                    Scalar lane_dy[pair_batch_width];
+                    Scalar lane_dz[pair_batch_width];
+                    Scalar lane_rsq[pair_batch_width];
+                    Scalar lane_rcutsq[pair_batch_width];
+                    param_type lane_params[pair_batch_width];
+                    Scalar lane_force_divr[pair_batch_width];
+                    Scalar lane_pair_eng[pair_batch_width];
+
+                    for (unsigned int lane = 0; lane < n_lanes; lane++)
                         {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
+                        unsigned int j = h_nlist.data[myHead + k_first + lane];
+                        assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                        Scalar4 postypej = h_pos.data[j];
+                        Scalar3 dx = box.minImage(pi - make_scalar3(postypej.x, postypej.y, postypej.z));
+                        unsigned int typpair_idx = m_typpair_idx(typei, __scalar_as_int(postypej.w));
+
+                        lane_j[lane] = j;
+                        lane_dx[lane] = dx.x;
+                        lane_dy[lane] = dx.y;
+                        lane_dz[lane] = dx.z;
+                        lane_rsq[lane] = dot(dx, dx);
+                        lane_rcutsq[lane] = h_rcutsq.data[typpair_idx];
+                        lane_params[lane] = h_params.data[typpair_idx];
+                        }
 
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                    PairEvaluatorBatch<evaluator>::evalForceAndEnergy(n_lanes, lane_rsq, lane_rcutsq, lane_params,
+                        lane_force_divr, lane_pair_eng, m_shift_mode == shift);
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+                    // masked lanes have zero force and energy
+                    for (unsigned int lane = 0; lane < n_lanes; lane++)
+                        {
+                        Scalar force_divr = lane_force_divr[lane];
+                        Scalar force_div2r = force_divr * Scalar(0.5);
+                        fi.x += lane_dx[lane]*force_divr;
+                        fi.y += lane_dy[lane]*force_divr;
+                        fi.z += lane_dz[lane]*force_divr;
+                        pei += lane_pair_eng[lane] * Scalar(0.5);
+                        if (compute_virial)
+                            {
+                            virialxxi += force_div2r*lane_dx[lane]*lane_dx[lane];
+                            virialxyi += force_div2r*lane_dx[lane]*lane_dy[lane];
+                            virialxzi += force_div2r*lane_dx[lane]*lane_dz[lane];
+                            virialyyi += force_div2r*lane_dy[lane]*lane_dy[lane];
+                            virialyzi += force_div2r*lane_dy[lane]*lane_dz[lane];
+                            virialzzi += force_div2r*lane_dz[lane]*lane_dz[lane];
+                            }
+                        }
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                    if (third_law)
+                        {
+                        for (unsigned int lane = 0; lane < n_lanes; lane++)
+                            {
+                            // only add force to local particles that are within the cutoff
+                            unsigned int mem_idx = lane_j[lane];
+                            if (mem_idx >= m_pdata->getN() || !(lane_rsq[lane] < lane_rcutsq[lane]))
+                                continue;
+
+                            add_reaction(mem_idx, make_scalar3(lane_dx[lane], lane_dy[lane], lane_dz[lane]),
+                                lane_force_divr[lane], lane_pair_eng[lane], owned_begin, owned_end, reactions);
+                            }
                         }
                     }
+                }
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
+            // the scalar code path handles all neighbors when the batched one is not used
+            const unsigned int n_scalar = use_batch ? 0 : size;
+            for (unsigned int k = 0; k < n_scalar; k++)
+                {
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int j = h_nlist.data[myHead + k];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dx = pi - pj;
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                // access diameter and charge (if needed)
+                Scalar dj = Scalar(0.0);
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    dj = h_diameter.data[j];
+                if (evaluator::needsCharge())
+                    qj = h_charge.data[j];
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r_ij squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                param_type param = h_params.data[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                Scalar ronsq = Scalar(0.0);
+                if (m_shift_mode == xplor)
+                    ronsq = h_ronsq.data[typpair_idx];
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if (m_shift_mode == shift)
+                    energy_shift = true;
+                else if (m_shift_mode == xplor)
                     {
-                    virialxxi += force_div2r*dx.x*dx.x;
-                    virialxyi += force_div2r*dx.x*dx.y;
-                    virialxzi += force_div2r*dx.x*dx.z;
-                    virialyyi += force_div2r*dx.y*dx.y;
-                    virialyzi += force_div2r*dx.y*dx.z;
-                    virialzzi += force_div2r*dx.z*dx.z;
+                    if (ronsq > rcutsq)
+                        energy_shift = true;
                     }
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                // only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                // compute the force and potential energy
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq, rcutsq, param);
+                if (evaluator::needsDiameter())
+                    eval.setDiameter(di, dj);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
+
+                bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+                if (evaluated)
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    // modify the potential for xplor shifting
+                    if (m_shift_mode == xplor)
+                        {
+                        if (rsq >= ronsq && rsq < rcutsq)
+                            {
+                            // Implement XPLOR smoothing (FLOPS: 16)
+                            Scalar old_pair_eng = pair_eng;
+                            Scalar old_force_divr = force_divr;
+
+                            // calculate 1.0 / (xplor denominator)
+                            Scalar xplor_denom_inv =
+                                Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                                       (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                            // make modifications to the old pair energy and force
+                            pair_eng = old_pair_eng * s;
+                            // note: I'm not sure why the minus sign needs to be there: my notes have a +
+                            // But this is verified correct via plotting
+                            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                            }
+                        }
+
+                    Scalar force_div2r = force_divr * Scalar(0.5);
+                    // add the force, potential energy and virial to the particle i
+                    // (FLOPS: 8)
+                    fi += dx*force_divr;
+                    pei += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virialxxi += force_div2r*dx.x*dx.x;
+                        virialxyi += force_div2r*dx.x*dx.y;
+                        virialxzi += force_div2r*dx.x*dx.z;
+                        virialyyi += force_div2r*dx.y*dx.y;
+                        virialyzi += force_div2r*dx.y*dx.z;
+                        virialzzi += force_div2r*dx.z*dx.z;
                         }
+
+                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+                    // only add force to local particles
+                    if (third_law && j < m_pdata->getN())
+                        add_reaction(j, dx, force_divr, pair_eng, owned_begin, owned_end, reactions);
                     }
                 }
+
+            // finally, increment the force, potential energy and virial for particle i
+            unsigned int mem_idx = i;
+            h_force.data[mem_idx].x += fi.x;
+            h_force.data[mem_idx].y += fi.y;
+            h_force.data[mem_idx].z += fi.z;
+            h_force.data[mem_idx].w += pei;
+            if (compute_virial)
+                {
+                h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
+                h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
+                h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
+                h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
+                h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
+                h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+                }
             }
+        };
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+    #ifdef ENABLE_TBB
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    // only time complete force computations, the partial ones done with ghost update overlap vary in size
+    const bool tune = m_cpu_tuner && num_threads > 1 && !list;
+    const unsigned int grain = tune ? m_cpu_tuner->getParam() : 1;
+    if (tune)
+        m_cpu_tuner->begin();
+
+    if (num_threads > 1 && !third_law)
+        {
+        // with a full neighbor list, every particle only writes to its own force and virial
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_list, grain),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            compute_range(r.begin(), r.end(), 0, N, NULL);
+            });
+        }
+    else if (num_threads > 1)
+        {
+        // with a half neighbor list, the reaction forces on j would race between threads. Split the particles
+        // into one contiguous chunk per thread. Every chunk owns the particle indices from its first entry up to the
+        // first entry of the next chunk, and writes the forces on those directly. Reactions on particles owned by
+        // other chunks are deferred and applied in chunk order afterwards, so the result does not depend on the
+        // scheduling. The deferred reactions take memory proportional to the pairs that cross chunks, not N.
+        const unsigned int n_chunks = num_threads;
+        m_thread_reactions.resize(n_chunks);
+
+        // the lists are sorted by particle index, so the owned index ranges of the chunks do not overlap
+        auto chunk_begin = [&](unsigned int chunk) -> unsigned int
+            {
+            unsigned int first = (unsigned int)((unsigned long long)n_list*chunk/n_chunks);
+            if (chunk == 0)
+                return 0;
+            if (first >= n_list)
+                return N;
+            return list ? list[first] : first;
+            };
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+            [&](const tbb::blocked_range<unsigned int>& r)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                {
+                unsigned int first = (unsigned int)((unsigned long long)n_list*chunk/n_chunks);
+                unsigned int last = (unsigned int)((unsigned long long)n_list*(chunk+1)/n_chunks);
+                unsigned int owned_end = (chunk+1 == n_chunks) ? N : chunk_begin(chunk+1);
+
+                m_thread_reactions[chunk].clear();
+                compute_range(first, last, chunk_begin(chunk), owned_end, &m_thread_reactions[chunk]);
+                }
+            });
+
+        // apply the deferred reactions
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+            {
+            for (const PairReaction& r : m_thread_reactions[chunk])
+                {
+                h_force.data[r.idx].x += r.force.x;
+                h_force.data[r.idx].y += r.force.y;
+                h_force.data[r.idx].z += r.force.z;
+                h_force.data[r.idx].w += r.force.w;
+
+                if (compute_virial)
+                    {
+                    for (unsigned int k = 0; k < 6; ++k)
+                        h_virial.data[k*m_virial_pitch + r.idx] += r.virial[k];
+                    }
+                }
             }
         }
+    else
+    #endif
+        {
+        compute_range(0, n_list, 0, N, NULL);
+        }
+
+    #ifdef ENABLE_TBB
+    if (tune)
+        m_cpu_tuner->end();
+    #endif
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    Computes the forces on the particles whose neighbors are all local with the neighbor list of the previous
+    build. computeForces() uses the result if the neighbor list is not rebuilt at \a timestep.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeInteriorForces(unsigned int timestep)
+    {
+    m_interior_valid = false;
+
+    // the interior particles are only known once the neighbor list has been built
+    if (m_exec_conf->isCUDAEnabled() || m_nlist->getBuildCount() == 0)
+        return;
+
+    if (m_split_builds != m_nlist->getBuildCount() || m_split_N != m_pdata->getN())
+        splitInteriorBoundary();
+
+    if (m_interior_list.empty())
+        return;
+
+    if (m_prof) m_prof->push(m_prof_name);
+
+    computeForceList(m_interior_list.data(), (unsigned int)m_interior_list.size(), true);
+    m_interior_valid = true;
+    m_interior_timestep = timestep;
 
     if (m_prof) m_prof->pop();
     }
 
+/*! A local particle is an interior particle if none of its neighbors is a ghost particle.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::splitInteriorBoundary()
+    {
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    const unsigned int N = m_pdata->getN();
+    m_interior_list.clear();
+    m_boundary_list.clear();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const unsigned int myHead = h_head_list.data[i];
+        const unsigned int size = h_n_neigh.data[i];
+
+        bool interior = true;
+        for (unsigned int k = 0; k < size; k++)
+            {
+            if (h_nlist.data[myHead + k] >= N)
+                {
+                interior = false;
+                break;
+                }
+            }
+
+        if (interior)
+            m_interior_list.push_back(i);
+        else
+            m_boundary_list.push_back(i);
+        }
+
+    m_split_builds = m_nlist->getBuildCount();
+    m_split_N = N;
+    }
+#endif
+
 #ifdef ENABLE_MPI
 /*! \param timestep Current time step
  */
@@ -823,6 +1206,7 @@ template < class T > void export_PotentialPair(pybind11::module& m, const std::s
         .def("setRon", &T::setRon)
         .def("setShiftMode", &T::setShiftMode)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
+        .def("setVectorize", &T::setVectorize)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec)
     ;
@@ -72,6 +72,11 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
 
         //! Actually compute the forces (overwrites PotentialPair::computeForces())
         virtual void computeForces(unsigned int timestep);
+
+        #ifdef ENABLE_MPI
+        //! The conservative interior forces computed by PotentialPair would be overwritten by computeForces()
+        virtual void computeInteriorForces(unsigned int timestep) {}
+        #endif
     };
 
 /*! \param sysdef System to compute forces on
@@ -147,13 +147,11 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     unsigned int virial_pitch = m_virial.getPitch();
 
@@ -167,25 +165,25 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
+    // the angles by particle index, ordered by the first member
+    const std::vector<AngleData::members_t>& table = m_angle_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = m_angle_data->getCPUTableGroups();
+
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
+        // lookup the indices of the particles participating in the angle
+        const AngleData::members_t& angle_idx = table[i];
+        unsigned int cur_angle = table_group[i];
+        unsigned int idx_a = angle_idx.idx[0];
+        unsigned int idx_b = angle_idx.idx[1];
+        unsigned int idx_c = angle_idx.idx[2];
 
         // throw an error if this angle is incomplete
         if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
             {
+            const AngleData::members_t& angle = m_angle_data->getMembersByIndex(cur_angle);
             this->m_exec_conf->msg->error() << "angle.table: angle " <<
                 angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
             throw std::runtime_error("Error in angle calculation");
@@ -246,7 +244,7 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
         // compute index into the table and read in values
 
         /// Here we use the table!!
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
+        unsigned int angle_type = m_angle_data->getTypeByIndex(cur_angle);
         unsigned int value_i = floor(value_f);
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
@@ -142,6 +142,58 @@ class mode_standard(_integrator):
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+    def set_force_multiple(self, force, multiple):
+        R""" Evaluates a force only every few time steps (multiple time step integration).
+
+        Args:
+            force (:py:mod:`hoomd.md.force`): The force to evaluate less often.
+            multiple (int): Number of time steps between evaluations of *force*.
+
+        :py:class:`mode_standard` implements the reversible reference system propagator algorithm (r-RESPA). A force
+        with a *multiple* larger than 1 is evaluated every *multiple* time steps, and it changes the velocities of the
+        integrated particles by two impulses of ``multiple * dt / 2`` times the force divided by the mass: one
+        after the force is evaluated, and one at the start of the next time step. The integration methods integrate
+        all other forces with the time step *dt*. Set the same or nested multiples (e.g. 2 and 4) on slowly varying
+        forces, such as the long range electrostatics or dihedrals, to reduce the cost per time step.
+
+        The potential energy and virial of the force at its last evaluation are included in the thermodynamic
+        quantities on every time step, so that thermostats, barostats and :py:class:`hoomd.compute.thermo` see the
+        slow forces. The thermodynamic quantities of a group include the energy and virial of the particles that were
+        members of the group at the last evaluation. The per particle energies and virials do not include them.
+
+        Forces that apply torques must be evaluated every time step. Multiple time steps cannot be combined with
+        rigid bodies or constraints. While there are forces with a *multiple* larger than 1, the virial is
+        computed on every time step. A *multiple* of 1 restores the default.
+
+        Examples::
+
+            integrator_mode = integrate.mode_standard(dt=0.002)
+            integrator_mode.set_force_multiple(pppm, 4)
+            integrator_mode.set_force_multiple(dihedral, 2)
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        if force.cpp_force is None:
+            hoomd.context.msg.error('Bug in hoomd.integrate: cpp_force not set, please report\n');
+            raise RuntimeError('Error setting force multiple');
+
+        if int(multiple) != multiple or multiple < 1:
+            hoomd.context.msg.error("integrate.mode_standard: multiple must be a positive integer.\n");
+            raise ValueError("Error setting force multiple.");
+
+        self.cpp_integrator.setForceMultiple(force.cpp_force, int(multiple));
+
+    ## \internal
+    # \brief Updates each hoomd.compute.thermo, and registers them to include the slow forces of their group
+    def update_thermos(self):
+        _integrator.update_thermos(self);
+
+        self.cpp_integrator.removeAllThermos();
+        for t in hoomd.context.current.thermos:
+            self.cpp_integrator.addThermo(t.cpp_compute);
+
     def reset_methods(self):
         R""" (Re-)initialize the integrator variables in all integration methods
 
@@ -374,11 +374,12 @@ class pair(force._force):
         self.nlist.subscribe(lambda:self.get_rcut())
         self.nlist.update_rcut()
 
-    def set_params(self, mode=None):
+    def set_params(self, mode=None, vectorize=None):
         R""" Set parameters controlling the way forces are computed.
 
         Args:
             mode (str): (if set) Set the mode with which potentials are handled at the cutoff.
+            vectorize (bool): (if set) Evaluate neighbors in vectorized batches on the CPU.
 
         Valid values for *mode* are: "none" (the default), "shift", and "xplor":
 
@@ -389,15 +390,23 @@ class pair(force._force):
 
         See :py:class:`pair` for the equations.
 
+        *vectorize* is supported by :py:class:`lj`, :py:class:`yukawa`, :py:class:`gauss`,
+        :py:class:`force_shifted_lj` and :py:class:`mie`, and is ignored on the GPU and with **xplor**. Results
+        agree with the default code path to within floating point round off.
+
         Examples::
 
             mypair.set_params(mode="shift")
             mypair.set_params(mode="no_shift")
             mypair.set_params(mode="xplor")
+            mypair.set_params(vectorize=True)
 
         """
         hoomd.util.print_status_line();
 
+        if vectorize is not None:
+            self.cpp_force.setVectorize(bool(vectorize))
+
         if mode is not None:
             if mode == "no_shift":
                 self.cpp_force.setShiftMode(self.cpp_class.energyShiftMode.no_shift)
@@ -131,6 +131,133 @@ class analyze_log_query_tests (unittest.TestCase):
         hoomd.context.initialize();
 
 
+# test analyze.log_binary
+class analyze_log_binary_tests (unittest.TestCase):
+    def create_system(self):
+        init.create_lattice(lattice.sc(a=1.5),n=[8,8,8]); # must be close enough to interact
+        nl = hoomd.md.nlist.cell()
+        self.pair = hoomd.md.pair.lj(r_cut=2.5, nlist = nl)
+        self.pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        hoomd.md.integrate.mode_standard(dt=0.005);
+        hoomd.md.integrate.langevin(hoomd.group.all(), seed=1, kT=1.0);
+
+        hoomd.context.current.sorter.set_params(grid=8)
+
+    def setUp(self):
+        self.create_system();
+
+        if hoomd.comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.bin');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    # tests that the file holds the queried values, including records of an incomplete block
+    def test_read(self):
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy', 'kinetic_energy'], period = 10,
+                                       filename=self.tmp_file, block_records=4, overwrite=True);
+        hoomd.run(101);
+        U = log.query('potential_energy');
+        K = log.query('kinetic_energy');
+
+        log.set_params(quantities = ['kinetic_energy']);
+        hoomd.run(20);
+
+        if hoomd.comm.get_rank() == 0:
+            data = hoomd.analyze.read_log_binary(self.tmp_file);
+            numpy.testing.assert_array_equal(data['timestep'], numpy.arange(0, 121, 10));
+            self.assertAlmostEqual(data['potential_energy'][10], U);
+            self.assertAlmostEqual(data['kinetic_energy'][10], K);
+            self.assertTrue(numpy.all(numpy.isnan(data['potential_energy'][11:])));
+            self.assertFalse(numpy.any(numpy.isnan(data['kinetic_energy'])));
+
+    # tests appending to an existing log
+    def test_append(self):
+        hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file, overwrite=True);
+        hoomd.run(50);
+        self.pair = None;
+        hoomd.context.initialize();
+
+        self.create_system();
+        hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file);
+        hoomd.run(30);
+
+        if hoomd.comm.get_rank() == 0:
+            data = hoomd.analyze.read_log_binary(self.tmp_file);
+            numpy.testing.assert_array_equal(data['timestep'], [0, 10, 20, 30, 40, 0, 10, 20]);
+
+    # tests that appending to a file that is not a binary log is an error, and leaves the file untouched
+    def test_append_invalid(self):
+        # the file is only opened on the root rank
+        if hoomd.comm.get_num_ranks() > 1:
+            return
+
+        for text in ['a', 'not a binary log file\n'*400]:
+            with open(self.tmp_file, 'w') as f:
+                f.write(text);
+
+            hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file);
+            self.assertRaises(RuntimeError, hoomd.run, 1);
+
+            with open(self.tmp_file) as f:
+                self.assertEqual(f.read(), text);
+
+            self.pair = None;
+            hoomd.context.initialize();
+            self.create_system();
+
+    # tests that the index is written at the end of every run, and replaced by the next chunks
+    def test_index(self):
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file,
+                                       block_records=4, overwrite=True);
+
+        for n in [1, 2]:
+            hoomd.run(30);
+
+            if hoomd.comm.get_rank() == 0:
+                raw = numpy.fromfile(self.tmp_file, dtype=numpy.uint8);
+                offset = 0;
+                while True:
+                    size, count = numpy.frombuffer(raw[offset+8:offset+24].tobytes(), dtype=numpy.uint64);
+                    if offset + size == len(raw):
+                        break;
+                    offset += int(size);
+
+                # the index is the last chunk, and holds the number of records and the column and data chunks
+                self.assertEqual(raw[offset:offset+8].tobytes(), b'HLOGINDX');
+                index = numpy.frombuffer(raw[offset+24:offset+24+8*(int(count)+1)].tobytes(), dtype=numpy.uint64);
+                self.assertEqual(index[0], 3*n);
+                for chunk in index[1:]:
+                    self.assertIn(raw[chunk:chunk+8].tobytes(), [b'HLOGCOLS', b'HLOGDATA']);
+
+    # tests that a stale logger does not write to a file that was overwritten by a new logger
+    def test_stale_logger(self):
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file,
+                                       overwrite=True);
+        hoomd.run(50);
+        log.disable();
+
+        log2 = hoomd.analyze.log_binary(quantities = ['kinetic_energy'], period = 10, filename=self.tmp_file,
+                                        overwrite=True);
+        hoomd.run(30);
+
+        # destroy both loggers
+        log = None;
+        log2 = None;
+        self.pair = None;
+        hoomd.context.initialize();
+
+        if hoomd.comm.get_rank() == 0:
+            data = hoomd.analyze.read_log_binary(self.tmp_file);
+            numpy.testing.assert_array_equal(data['timestep'], [50, 60, 70]);
+            self.assertNotIn('potential_energy', data);
+
+    def tearDown(self):
+        self.pair = None;
+        hoomd.context.initialize();
+        if (hoomd.comm.get_rank()==0):
+            os.remove(self.tmp_file);
+
 try:
     import h5py
 except ImportError:
@@ -132,5 +132,57 @@ class constrain_distance_tests (unittest.TestCase):
         del self.nl
         context.initialize();
 
+# test several independent molecules, solved block by block
+class constrain_distance_molecules_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        snap = data.make_snapshot(N=14,box=data.boxdim(L=25),particle_types=['A'])
+        if comm.get_rank() == 0:
+            # four triangles
+            for m in range(4):
+                x0 = -9 + 6*m
+                snap.particles.position[3*m+0] = (x0,0,0)
+                snap.particles.position[3*m+1] = (x0+1.5,0,0)
+                snap.particles.position[3*m+2] = (x0,-1.5,0)
+                snap.particles.velocity[3*m+0] = (0.1*m,0.2,-0.3)
+                snap.particles.velocity[3*m+1] = (-0.2,0.1*m,0.1)
+                snap.particles.velocity[3*m+2] = (0.3,-0.1,0.1*m)
+            snap.particles.mass[:] = [0.7, 0.95, 0.12]*4 + [1.0, 2.0]
+
+            # and one dimer
+            snap.particles.position[12] = (0,6,0)
+            snap.particles.position[13] = (1.0,6,0)
+            snap.particles.velocity[12] = (0,0.5,0)
+            snap.particles.velocity[13] = (0,-0.5,0.2)
+
+            snap.constraints.resize(13)
+            for m in range(4):
+                snap.constraints.group[3*m+0] = [3*m+0, 3*m+1]
+                snap.constraints.group[3*m+1] = [3*m+0, 3*m+2]
+                snap.constraints.group[3*m+2] = [3*m+1, 3*m+2]
+                snap.constraints.value[3*m+0] = 1.5
+                snap.constraints.value[3*m+1] = 1.5
+                snap.constraints.value[3*m+2] = math.sqrt(2*1.5**2)
+            snap.constraints.group[12] = [12, 13]
+            snap.constraints.value[12] = 1.0
+        self.system = init.read_snapshot(snap)
+
+    def test_molecules(self):
+        constraint = md.constrain.distance()
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(100)
+
+        box = self.system.box
+        for c in self.system.constraints:
+            pos_a = self.system.particles[c.a].position
+            pos_b = self.system.particles[c.b].position
+            d = box.min_image((pos_a[0]-pos_b[0], pos_a[1]-pos_b[1], pos_a[2]-pos_b[2]))
+            self.assertAlmostEqual(math.sqrt(d[0]*d[0]+d[1]*d[1]+d[2]*d[2]), c.d, 4)
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
@@ -11,8 +11,8 @@ import os
 class integrate_nve_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
-        md.force.constant(fx=0.1, fy=0.1, fz=0.1)
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.f = md.force.constant(fx=0.1, fy=0.1, fz=0.1)
 
         context.current.sorter.set_params(grid=8)
 
@@ -65,6 +65,114 @@ class integrate_nve_tests (unittest.TestCase):
         # second call does nothing
         nve.enable()
 
+    # test multiple time step integration
+    def test_force_multiple(self):
+        mode = md.integrate.mode_standard(dt=0.005);
+        nve = md.integrate.nve(group=group.all())
+        mode.set_force_multiple(self.f, 2);
+        run(1);
+
+        # the first impulse of the slow force
+        v = self.s.particles[0].velocity;
+        self.assertAlmostEqual(v[0], 0.0005, 6);
+
+        # after a full period, the velocity is the same as with the force evaluated every step
+        run(1);
+        v = self.s.particles[0].velocity;
+        self.assertAlmostEqual(v[0], 0.001, 6);
+        self.assertAlmostEqual(v[1], 0.001, 6);
+        self.assertAlmostEqual(v[2], 0.001, 6);
+
+        # back to every step
+        mode.set_force_multiple(self.f, 1);
+        run(2);
+        v = self.s.particles[0].velocity;
+        self.assertAlmostEqual(v[0], 0.002, 6);
+
+        with self.assertRaises(ValueError):
+            mode.set_force_multiple(self.f, 0);
+
+    # test that the energy and pressure include the slow forces on every step
+    def test_force_multiple_thermo(self):
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist=nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        log = analyze.log(filename=None, quantities=['potential_energy', 'pressure'], period=3)
+
+        # the particles do not move with dt=0
+        mode = md.integrate.mode_standard(dt=0);
+        nve = md.integrate.nve(group=group.all())
+        run(1);
+        U = log.query('potential_energy');
+        P = log.query('pressure');
+        self.assertNotAlmostEqual(U, 0.0, 3);
+        self.assertNotAlmostEqual(P, 0.0, 3);
+
+        # the log period does not line up with the multiple, the values are the same on every step
+        mode.set_force_multiple(lj, 2);
+        for i in range(7):
+            run(1);
+            self.assertAlmostEqual(log.query('potential_energy'), U, 4);
+            self.assertAlmostEqual(log.query('pressure'), P, 4);
+
+    # test that the thermo of a group only includes the slow forces on its members
+    def test_force_multiple_groups(self):
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist=nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        groupA = group.tags(name='a', tag_min=0, tag_max=49)
+        groupB = group.tags(name='b', tag_min=50, tag_max=99)
+        compute.thermo(group=groupA)
+        compute.thermo(group=groupB)
+        log = analyze.log(filename=None, quantities=['potential_energy', 'potential_energy_a', 'potential_energy_b',
+                                                     'pressure', 'pressure_a', 'pressure_b'], period=1)
+
+        # the particles do not move with dt=0
+        mode = md.integrate.mode_standard(dt=0);
+        md.integrate.nve(group=groupA)
+        md.integrate.nve(group=groupB)
+        run(1);
+        U_a = log.query('potential_energy_a');
+        P_a = log.query('pressure_a');
+
+        mode.set_force_multiple(lj, 2);
+        for i in range(3):
+            run(1);
+            self.assertAlmostEqual(log.query('potential_energy_a'), U_a, 4);
+            self.assertAlmostEqual(log.query('pressure_a'), P_a, 4);
+            self.assertAlmostEqual(log.query('potential_energy_a') + log.query('potential_energy_b'),
+                                   log.query('potential_energy'), 4);
+            self.assertAlmostEqual(log.query('pressure_a') + log.query('pressure_b'), log.query('pressure'), 4);
+
+    # test that thermostats and barostats run with slow forces
+    def test_force_multiple_nvt_npt(self):
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist=nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        log = analyze.log(filename=None, quantities=['potential_energy', 'pressure'], period=3)
+
+        mode = md.integrate.mode_standard(dt=0.005);
+        nvt = md.integrate.nvt(group=group.all(), kT=1.2, tau=0.5)
+        mode.set_force_multiple(lj, 2);
+        run(10);
+
+        # on an evaluation step, the values match an evaluation of all forces on the same state
+        U = log.query('potential_energy');
+        P = log.query('pressure');
+        mode.set_force_multiple(lj, 1);
+        mode.set_params(dt=0);
+        run(1);
+        self.assertAlmostEqual(log.query('potential_energy'), U, 4);
+        self.assertAlmostEqual(log.query('pressure'), P, 4);
+
+        nvt.disable();
+        mode.set_params(dt=0.005);
+        mode.set_force_multiple(lj, 2);
+        md.integrate.npt(group=group.all(), kT=1.2, tau=0.5, P=1.0, tauP=0.5);
+        run(10);
+        P = log.query('pressure');
+        self.assertTrue(abs(P) < 1e6);
+
     def tearDown(self):
         context.initialize();
 
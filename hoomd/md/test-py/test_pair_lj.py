@@ -39,6 +39,8 @@ class pair_lj_tests (unittest.TestCase):
         lj.set_params(mode="shift");
         lj.set_params(mode="xplor");
         self.assertRaises(RuntimeError, lj.set_params, mode="blah");
+        lj.set_params(vectorize=True);
+        lj.set_params(vectorize=False);
 
     # test default coefficients
     def test_default_coeff(self):
@@ -97,6 +99,31 @@ class pair_lj_tests (unittest.TestCase):
         del self.s, self.nl
         context.initialize();
 
+# md.pair.lj with the ghost update overlapped with the interior force computation
+class pair_lj_ghost_overlap_tests (unittest.TestCase):
+    def run_lj(self, overlap):
+        s = init.create_lattice(lattice.sc(a=1.2),n=[8,8,8]);
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist = nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.langevin(group=group.all(), kT=1.2, seed=12);
+        comm.set_ghost_update_overlap(overlap);
+        run(200);
+        snap = s.take_snapshot();
+        del s, nl, lj
+        context.initialize();
+        return snap
+
+    # the trajectory must not depend on whether the ghost update is overlapped
+    def test_same_trajectory(self):
+        snap_ref = self.run_lj(False);
+        snap = self.run_lj(True);
+
+        if comm.get_rank() == 0:
+            for i in range(snap.particles.N):
+                for d in range(3):
+                    self.assertAlmostEqual(snap.particles.position[i][d], snap_ref.particles.position[i][d], 4);
 
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
@@ -40,6 +40,9 @@ typedef std::function<std::shared_ptr<Communicator> (std::shared_ptr<SystemDefin
 std::shared_ptr<Communicator> base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                          std::shared_ptr<DomainDecomposition> decomposition);
 
+std::shared_ptr<Communicator> direct_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                         std::shared_ptr<DomainDecomposition> decomposition);
+
 #ifdef ENABLE_CUDA
 std::shared_ptr<Communicator> gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                   std::shared_ptr<DomainDecomposition> decomposition);
@@ -3450,6 +3453,15 @@ std::shared_ptr<Communicator> base_class_communicator_creator(std::shared_ptr<Sy
     return std::shared_ptr<Communicator>(new Communicator(sysdef, decomposition) );
     }
 
+//! Communicator creator for unit tests of the single-stage ghost exchange
+std::shared_ptr<Communicator> direct_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                         std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    comm->setDirectGhostExchange(true);
+    return comm;
+    }
+
 #ifdef ENABLE_CUDA
 std::shared_ptr<Communicator> gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                   std::shared_ptr<DomainDecomposition> decomposition)
@@ -3595,6 +3607,45 @@ UP_TEST( communicator_ghosts_test)
         }
     }
 
+UP_TEST( communicator_ghosts_direct_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_direct = bind(direct_communicator_creator, _1, _2);
+
+    // test in a cubic box
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(communicator_creator_direct,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(new DomainDecomposition(exec_conf_cpu,box.getL())),
+                                 make_scalar3(0.0,0.0,0.0));
+        }
+    // triclinic box
+        {
+        BoxDim box(1.0,-.6,.7,.5);
+        test_communicator_ghosts(communicator_creator_direct,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(new DomainDecomposition(exec_conf_cpu,box.getL())),
+                                 make_scalar3(0.0,0.0,0.0));
+        }
+    // balanced decomposition
+        {
+        Scalar3 origin = make_scalar3(0.1,-0.12,0.14);
+        vector<Scalar> fx(1), fy(1), fz(1);
+        fx[0] = 0.55; fy[0] = 0.44; fz[0] = 0.57;
+        BoxDim box(2.0);
+        test_communicator_ghosts(communicator_creator_direct,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(new DomainDecomposition(exec_conf_cpu,box.getL(), fx, fy, fz)),
+                                 origin);
+        }
+    }
+
 UP_TEST( communicator_bonded_ghosts_test)
     {
     if (!exec_conf_cpu)
@@ -443,6 +443,58 @@ void const_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     }
     }
 
+//! Check that the CPU bond table is ordered by particle index and follows particle sorts
+void bond_cpu_table_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_4(new SystemDefinition(4, BoxDim(1000.0), 1, 1, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_4 = sysdef_4->getParticleData();
+    std::shared_ptr<BondData> bond_data = sysdef_4->getBondData();
+
+    bond_data->addBondedGroup(Bond(0, 3,2));
+    bond_data->addBondedGroup(Bond(0, 0,1));
+    bond_data->addBondedGroup(Bond(0, 2,0));
+
+    {
+    const std::vector<BondData::members_t>& table = bond_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = bond_data->getCPUTableGroups();
+    CHECK_EQUAL_UINT(table[0].idx[0], 0);
+    CHECK_EQUAL_UINT(table[0].idx[1], 1);
+    CHECK_EQUAL_UINT(table_group[0], 1);
+    CHECK_EQUAL_UINT(table[1].idx[0], 2);
+    CHECK_EQUAL_UINT(table[1].idx[1], 0);
+    CHECK_EQUAL_UINT(table_group[1], 2);
+    CHECK_EQUAL_UINT(table[2].idx[0], 3);
+    CHECK_EQUAL_UINT(table[2].idx[1], 2);
+    CHECK_EQUAL_UINT(table_group[2], 0);
+    }
+
+    // reverse the particle order in memory
+    {
+    ArrayHandle<unsigned int> h_tag(pdata_4->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(pdata_4->getRTags(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < 4; i++)
+        {
+        h_tag.data[i] = 3-i;
+        h_rtag.data[3-i] = i;
+        }
+    }
+    pdata_4->notifyParticleSort();
+
+    {
+    const std::vector<BondData::members_t>& table = bond_data->getCPUTable();
+    const std::vector<unsigned int>& table_group = bond_data->getCPUTableGroups();
+    CHECK_EQUAL_UINT(table[0].idx[0], 0);
+    CHECK_EQUAL_UINT(table[0].idx[1], 1);
+    CHECK_EQUAL_UINT(table_group[0], 0);
+    CHECK_EQUAL_UINT(table[1].idx[0], 1);
+    CHECK_EQUAL_UINT(table[1].idx[1], 3);
+    CHECK_EQUAL_UINT(table_group[1], 2);
+    CHECK_EQUAL_UINT(table[2].idx[0], 3);
+    CHECK_EQUAL_UINT(table[2].idx[1], 2);
+    CHECK_EQUAL_UINT(table_group[2], 1);
+    }
+    }
+
 //! PotentialBondHarmonic creator for bond_force_basic_tests()
 std::shared_ptr<PotentialBondHarmonic> base_class_bf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -464,6 +516,12 @@ UP_TEST( PotentialBondHarmonic_basic )
     bond_force_basic_tests(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the CPU bond table
+UP_TEST( BondData_cpu_table )
+    {
+    bond_cpu_table_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for bond forces on the GPU
 UP_TEST( PotentialBondHarmonicGPU_basic )
@@ -531,6 +531,89 @@ void lj_force_shift_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionCo
     }
     }
 
+#ifdef ENABLE_TBB
+//! Check that two values agree to within a relative tolerance, or an absolute one for values close to zero
+static void check_close_or_small(Scalar a, Scalar b)
+    {
+    UP_ASSERT(std::abs(a - b) <= tol * std::max(Scalar(1.0), std::abs(b)));
+    }
+
+//! Test that the threaded CPU code path reproduces the serial result for half and full neighbor lists
+void lj_force_threaded_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setRcut(0, 0, Scalar(3.0));
+    fc->setParams(0,0,make_scalar2(Scalar(4.0),Scalar(4.0)));
+
+    // reference forces computed serially with a half neighbor list
+    exec_conf->setNumThreads(1);
+    nlist->setStorageMode(NeighborList::half);
+    fc->forceCompute(0);
+
+    std::vector<Scalar4> ref_force(N);
+    std::vector<Scalar> ref_virial(6*N);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            ref_force[i] = h_force.data[i];
+            for (unsigned int k = 0; k < 6; k++)
+                ref_virial[k*N+i] = h_virial.data[k*pitch+i];
+            }
+        }
+
+    exec_conf->setNumThreads(4);
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        nlist->setStorageMode(modes[m]);
+        fc->forceCompute(0);
+
+        std::vector<Scalar4> first_force(N);
+            {
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+            unsigned int pitch = fc->getVirialArray().getPitch();
+            for (unsigned int i = 0; i < N; i++)
+                {
+                check_close_or_small(h_force.data[i].x, ref_force[i].x);
+                check_close_or_small(h_force.data[i].y, ref_force[i].y);
+                check_close_or_small(h_force.data[i].z, ref_force[i].z);
+                check_close_or_small(h_force.data[i].w, ref_force[i].w);
+                for (unsigned int k = 0; k < 6; k++)
+                    check_close_or_small(h_virial.data[k*pitch+i], ref_virial[k*N+i]);
+                first_force[i] = h_force.data[i];
+                }
+            }
+
+        // repeating the computation with the same number of threads must give bitwise identical results
+        fc->forceCompute(0);
+            {
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            for (unsigned int i = 0; i < N; i++)
+                {
+                UP_ASSERT_EQUAL(h_force.data[i].x, first_force[i].x);
+                UP_ASSERT_EQUAL(h_force.data[i].y, first_force[i].y);
+                UP_ASSERT_EQUAL(h_force.data[i].z, first_force[i].z);
+                UP_ASSERT_EQUAL(h_force.data[i].w, first_force[i].w);
+                }
+            }
+        }
+    }
+#endif
+
 //! LJForceCompute creator for unit tests
 std::shared_ptr<PotentialPairLJ> base_class_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                   std::shared_ptr<NeighborList> nlist)
@@ -538,6 +621,15 @@ std::shared_ptr<PotentialPairLJ> base_class_lj_creator(std::shared_ptr<SystemDef
     return std::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef, nlist));
     }
 
+//! LJForceCompute creator with the batched evaluation for unit tests
+std::shared_ptr<PotentialPairLJ> vectorized_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    lj->setVectorize(true);
+    return lj;
+    }
+
 #ifdef ENABLE_CUDA
 //! LJForceComputeGPU creator for unit tests
 std::shared_ptr<PotentialPairLJGPU> gpu_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -570,6 +662,36 @@ UP_TEST( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for particle test with the batched evaluation
+UP_TEST( PotentialPairLJ_vectorized_particle )
+    {
+    ljforce_creator lj_creator_vec = bind(vectorized_lj_creator, _1, _2);
+    lj_force_particle_test(lj_creator_vec, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for shift test with the batched evaluation
+UP_TEST( PotentialPairLJ_vectorized_shift )
+    {
+    ljforce_creator lj_creator_vec = bind(vectorized_lj_creator, _1, _2);
+    lj_force_shift_test(lj_creator_vec, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing the batched evaluation to the scalar one
+UP_TEST( PotentialPairLJ_vectorized_compare )
+    {
+    ljforce_creator lj_creator_vec = bind(vectorized_lj_creator, _1, _2);
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_base, lj_creator_vec, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! test case for the threaded CPU code path
+UP_TEST( PotentialPairLJ_threaded )
+    {
+    lj_force_threaded_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
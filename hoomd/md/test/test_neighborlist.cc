@@ -1250,6 +1250,124 @@ void neighborlist_2d_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
         }
     }
 
+#ifdef ENABLE_TBB
+//! Test that the threaded distance check finds a single particle that crossed the buffer, like the serial one
+template <class NL>
+void neighborlist_dist_check_threads_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // simple cubic lattice, large enough that every thread gets several blocks of particles
+    const unsigned int n = 12;
+    const Scalar a = Scalar(1.2);
+    const unsigned int N = n*n*n;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(n*a), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::vector<Scalar3> lattice(N);
+    for (unsigned int i = 0; i < N; i++)
+        lattice[i] = make_scalar3(a*(i % n) - n*a/2, a*((i/n) % n) - n*a/2, a*(i/(n*n)) - n*a/2);
+
+    // the buffer allows every particle to move by (r_buff)/2 = 0.2 before the list has to be rebuilt
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(1.0), Scalar(0.4)));
+    nlist->setRCutPair(0,0,1.0);
+    nlist->setEvery(1, true);
+
+    // the first and last particle, particles at the boundaries of the polling blocks, and the last chunk
+    unsigned int moved[] = {0, 255, 256, N/2, N-2, N-1};
+    unsigned int threads[] = {1, 4};
+    unsigned int timestep = 0;
+
+    for (unsigned int t = 0; t < 2; t++)
+        {
+        exec_conf->setNumThreads(threads[t]);
+
+        for (unsigned int k = 0; k < sizeof(moved)/sizeof(unsigned int); k++)
+            {
+            // build the list for the lattice
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+                for (unsigned int i = 0; i < N; i++)
+                    h_pos.data[i] = make_scalar4(lattice[i].x, lattice[i].y, lattice[i].z, __int_as_scalar(0));
+                }
+            nlist->forceUpdate();
+            nlist->compute(timestep++);
+            unsigned int builds = nlist->getBuildCount();
+
+            // a move within the buffer does not require a rebuild
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+                h_pos.data[moved[k]].x += Scalar(0.15);
+                }
+            nlist->compute(timestep++);
+            CHECK_EQUAL_UINT(nlist->getBuildCount(), builds);
+
+            // a move past the buffer does
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+                h_pos.data[moved[k]].x += Scalar(0.1);
+                }
+            nlist->compute(timestep++);
+            CHECK_EQUAL_UINT(nlist->getBuildCount(), builds+1);
+            }
+        }
+    }
+
+//! Test that a threaded build gives the same neighbor lists as the serial build
+template <class NL>
+void neighborlist_threads_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // dense enough that the cell list is also built with several chunks
+    RandomInitializer init(4000, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    nlist->setRCutPair(0,0,3.0);
+    for (unsigned int i=0; i < pdata->getN()-2; i++)
+        {
+        nlist->addExclusion(i,i+1);
+        nlist->addExclusion(i,i+2);
+        }
+
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    unsigned int timestep = 0;
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        nlist->setStorageMode(modes[m]);
+
+        // the serial build is the reference
+        exec_conf->setNumThreads(1);
+        nlist->forceUpdate();
+        nlist->compute(timestep++);
+
+        std::vector< std::vector<unsigned int> > ref_list(pdata->getN());
+            {
+            ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(), access_location::host, access_mode::read);
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                ref_list[i].assign(h_nlist.data + h_head_list.data[i],
+                                   h_nlist.data + h_head_list.data[i] + h_n_neigh.data[i]);
+            }
+
+        exec_conf->setNumThreads(4);
+        nlist->forceUpdate();
+        nlist->compute(timestep++);
+
+        // every particle has the same neighbors in the same order
+        ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            {
+            CHECK_EQUAL_UINT(h_n_neigh.data[i], ref_list[i].size());
+            for (unsigned int j = 0; j < ref_list[i].size() && j < h_n_neigh.data[i]; j++)
+                CHECK_EQUAL_UINT(h_nlist.data[h_head_list.data[i] + j], ref_list[i][j]);
+            }
+        }
+    }
+#endif
+
 ///////////////
 // BINNED CPU
 ///////////////
@@ -1303,6 +1421,13 @@ UP_TEST( NeighborListBinned_2d )
     {
     neighborlist_2d_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+//! threaded build test case for binned class
+UP_TEST( NeighborListBinned_threads )
+    {
+    neighborlist_threads_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
 
 ////////////////////
 // STENCIL CPU
@@ -1422,6 +1547,13 @@ UP_TEST( NeighborListTree_comparison )
     {
     neighborlist_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+//! threaded distance check test case for tree class
+UP_TEST( NeighborListTree_dist_check_threads )
+    {
+    neighborlist_dist_check_threads_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
 
 #ifdef ENABLE_CUDA
 ///////////////
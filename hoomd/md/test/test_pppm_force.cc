@@ -199,6 +199,58 @@ void pppm_force_particle_test_triclinic(pppmforce_creator pppm_creator, std::sha
     }
 
 
+#ifdef ENABLE_TBB
+//! Compare two values relative to their magnitude, or absolutely if they are small
+static void check_close_or_small(Scalar a, Scalar b)
+    {
+    UP_ASSERT(std::abs(a - b) <= tol_small * std::max(Scalar(1.0), std::abs(b)));
+    }
+
+//! Test that the threaded FFT, charge assignment and force interpolation reproduce the serial result
+void pppm_force_threaded_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create a random system of positive and negative charges
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    for (unsigned int i = 0; i < N; i++)
+        snap->particle_data.charge[i] = (i % 2) ? Scalar(-1.0) : Scalar(1.0);
+
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(2.0), Scalar(0.4)));
+    std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    // reference forces computed serially, the mesh is wide enough to be split into several tiles
+    exec_conf->setNumThreads(1);
+    std::shared_ptr<PPPMForceCompute> fc_serial = pppm_creator(sysdef, nlist, group_all);
+    fc_serial->setParams(32, 32, 32, 5, Scalar(1.5), Scalar(2.0));
+    fc_serial->compute(0);
+
+    exec_conf->setNumThreads(4);
+    std::shared_ptr<PPPMForceCompute> fc_threaded = pppm_creator(sysdef, nlist, group_all);
+    fc_threaded->setParams(32, 32, 32, 5, Scalar(1.5), Scalar(2.0));
+    fc_threaded->compute(0);
+
+    ArrayHandle<Scalar4> h_force_serial(fc_serial->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_threaded(fc_threaded->getForceArray(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        check_close_or_small(h_force_threaded.data[i].x, h_force_serial.data[i].x);
+        check_close_or_small(h_force_threaded.data[i].y, h_force_serial.data[i].y);
+        check_close_or_small(h_force_threaded.data[i].z, h_force_serial.data[i].z);
+        }
+
+    MY_CHECK_CLOSE(fc_threaded->getExternalEnergy(), fc_serial->getExternalEnergy(), tol_small);
+    for (unsigned int k = 0; k < 6; k++)
+        check_close_or_small(fc_threaded->getExternalVirial(k), fc_serial->getExternalVirial(k));
+    }
+#endif
+
 //! PPPMForceCompute creator for unit tests
 std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                      std::shared_ptr<NeighborList> nlist,
@@ -233,6 +285,15 @@ UP_TEST( PPPMForceCompute_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for the threaded CPU code path
+UP_TEST( PPPMForceCompute_threaded )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_threaded_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 
 #ifdef ENABLE_CUDA
 //! test case for bond forces on the GPU
@@ -7,6 +7,11 @@
 #include "EAMForceCompute.h"
 
 #include <vector>
+#include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 using namespace std;
 
@@ -343,13 +348,6 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
 
-    // index and remainder
-    Scalar position;  // look up position, scalar
-    unsigned int int_position;  // look up index for position, integer
-    unsigned int idxs; // look up index in F, rho, rphi array, considering shift, integer
-    Scalar remainder;  // look up remainder in array, integer
-    Scalar4 v, dv;  // value, d(value)
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -374,206 +372,357 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // sum up the number of forces calculated
     int64_t n_calc = 0;
 
-    // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
+    // parameters for each particle, including the ghosts
+    const unsigned int N = m_pdata->getN();
+    const unsigned int N_tot = N + m_pdata->getNGhosts();
+    m_atom_electron_density.assign(N_tot, Scalar(0.0));
+    m_atom_dFdP.assign(N_tot, Scalar(0.0));
     unsigned int ntypes = m_pdata->getNTypes();
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    for (unsigned int i = 0; i < N; i++)
+        n_calc += 2*h_n_neigh.data[i];
+
+    // sum up the electron density P = sum{rho} for the particles in [first, last)
+    auto compute_density = [&](unsigned int first, unsigned int last, Scalar *atomElectronDensity)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
+        for (unsigned int i = first; i < last; i++)
+            {
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
 
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int) h_n_neigh.data[i];
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int) h_n_neigh.data[i];
 
-        for (unsigned int j = 0; j < size; j++)
-            {
-            // increment our calculation counter
-            n_calc++;
+            for (unsigned int j = 0; j < size; j++)
+                {
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N_tot);
 
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+                // calculate dr
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
 
-            // calculate dr
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+                // start computing the force
+                // calculate r squared
+                Scalar rsq = dot(dx, dx);
 
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
+                // only compute the force if the particles are closer than the cut-off
+                if (rsq < r_cut_sq)
+                    {
+                    // calculate position r for rho(r)
+                    Scalar position = sqrt(rsq) * rdr;
+                    unsigned int int_position = (unsigned int) position;
+                    int_position = min(int_position, nr - 1);
+                    Scalar remainder = position - int_position;
+                    // calculate P = sum{rho}
+                    unsigned int idxs = int_position + nr * (typej * ntypes + typei);
+                    Scalar4 v = h_rho.data[idxs];
+                    atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
+                            + v.x * remainder * remainder * remainder;
+                    // if third_law, pair it
+                    if (third_law)
+                        {
+                        idxs = int_position + nr * (typei * ntypes + typej);
+                        v = h_rho.data[idxs];
+                        atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
+                                + v.x * remainder * remainder * remainder;
+                        }
+                    }
+                }
+            }
+        };
+
+    // compute the embedding energy F(P) and its derivative dF/dP for the particles in [first, last)
+    auto compute_embedding = [&](unsigned int first, unsigned int last)
+        {
+        for (unsigned int i = first; i < last; i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            // calculate position rho for F(rho)
+            Scalar position = m_atom_electron_density[i] * rdrho;
+            unsigned int int_position = (unsigned int) position;
+            int_position = min(int_position, nrho - 1);
+            Scalar remainder = position - int_position;
+
+            unsigned int idxs = int_position + typei * nrho;
+            Scalar4 v = h_F.data[idxs];
+            Scalar4 dv = h_dF.data[idxs];
+            // compute dF / dP
+            m_atom_dFdP[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            // compute embedded energy F(P), sum up each particle
+            h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
+                    + v.x * remainder * remainder * remainder;
+            }
+        };
+
+    // compute the forces on the particles in [first, last), reaction forces and virials go to force and virial
+    auto compute_force = [&](unsigned int first, unsigned int last, Scalar4 *force, Scalar *virial,
+        unsigned int virial_pitch)
+        {
+        for (unsigned int i = first; i < last; i++)
+            {
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar fxi = 0.0;
+            Scalar fyi = 0.0;
+            Scalar fzi = 0.0;
+            Scalar pei = 0.0;
+            Scalar viriali[6];
+            for (int k = 0; k < 6; k++)
+                viriali[k] = 0.0;
+
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int) h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int) position;
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N_tot);
+
+                // calculate \Delta r
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // start computing the force
+                // calculate r squared
+                Scalar rsq = dot(dx, dx);
+
+                // calculate position r for phi(r)
+                if (rsq >= r_cut_sq)
+                    continue;
+                Scalar r = sqrt(rsq);
+                Scalar inverseR = 1.0 / r;
+                Scalar position = r * rdr;
+                unsigned int int_position = (unsigned int) position;
                 int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
-                // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                        + v.x * remainder * remainder * remainder;
-                // if third_law, pair it
+                Scalar remainder = position - int_position;
+                // calculate the shift position for type ij
+                int shift =
+                        (typei >= typej) ?
+                                (int) (0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr :
+                                (int) (0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
+
+                unsigned int idxs = int_position + shift;
+                Scalar4 v = h_rphi.data[idxs];
+                Scalar4 dv = h_drphi.data[idxs];
+                // pair_eng = phi
+                Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
+                        + v.x * remainder * remainder * remainder) * inverseR;
+                // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
+                Scalar derivativePhi = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
+                // derivativeRhoI = drho / dr of i
+                idxs = int_position + typei * ntypes * nr + typej * nr;
+                dv = h_drho.data[idxs];
+                Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+                // derivativeRhoJ = drho / dr of j
+                idxs = int_position + typej * ntypes * nr + typei * nr;
+                dv = h_drho.data[idxs];
+                Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+                // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
+                Scalar fullDerivativePhi = m_atom_dFdP[i] * derivativeRhoJ
+                        + m_atom_dFdP[k] * derivativeRhoI + derivativePhi;
+                // compute forces
+                Scalar pairForce = -fullDerivativePhi * inverseR;
+                // every particle of the pair gets half of the virial, like the energy
+                Scalar pairForce_div2 = Scalar(0.5) * pairForce;
+                Scalar virial_pair[6];
+                virial_pair[0] = dx.x * dx.x * pairForce_div2;
+                virial_pair[1] = dx.x * dx.y * pairForce_div2;
+                virial_pair[2] = dx.x * dx.z * pairForce_div2;
+                virial_pair[3] = dx.y * dx.y * pairForce_div2;
+                virial_pair[4] = dx.y * dx.z * pairForce_div2;
+                virial_pair[5] = dx.z * dx.z * pairForce_div2;
+                for (int l = 0; l < 6; l++)
+                    viriali[l] += virial_pair[l];
+                fxi += dx.x * pairForce;
+                fyi += dx.y * pairForce;
+                fzi += dx.z * pairForce;
+                pei += pair_eng * 0.5;
+
                 if (third_law)
                     {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                            + v.x * remainder * remainder * remainder;
+                    force[k].x -= dx.x * pairForce;
+                    force[k].y -= dx.y * pairForce;
+                    force[k].z -= dx.z * pairForce;
+                    force[k].w += pair_eng * 0.5;
+
+                    // with domain decomposition, the owner of a ghost neighbor adds the other half of the virial
+                    if (k < N)
+                        {
+                        for (int l = 0; l < 6; l++)
+                            virial[l * virial_pitch + k] += virial_pair[l];
+                        }
                     }
                 }
+            force[i].x += fxi;
+            force[i].y += fyi;
+            force[i].z += fzi;
+            force[i].w += pei;
+            for (int k = 0; k < 6; k++)
+                virial[k * virial_pitch + i] += viriali[k];
             }
-        }
+        };
+
+    #ifdef ENABLE_TBB
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        {
+        // with a half neighbor list, the contributions to neighbors would race between threads. Split the particles
+        // into one contiguous chunk per thread and let every chunk but the first accumulate into a private buffer,
+        // which is summed in chunk order so that the result does not depend on the scheduling.
+        const unsigned int n_chunks = third_law ? num_threads : 1;
+        if (third_law)
+            m_thread_density.resize((n_chunks-1)*N_tot);
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, third_law ? n_chunks : N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            if (!third_law)
+                {
+                compute_density(r.begin(), r.end(), m_atom_electron_density.data());
+                return;
+                }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                {
+                unsigned int first = (unsigned int)((unsigned long long)N*chunk/n_chunks);
+                unsigned int last = (unsigned int)((unsigned long long)N*(chunk+1)/n_chunks);
+
+                Scalar *density = m_atom_electron_density.data();
+                if (chunk > 0)
+                    {
+                    density = m_thread_density.data() + (chunk-1)*N_tot;
+                    memset((void*)density, 0, sizeof(Scalar)*N_tot);
+                    }
+                compute_density(first, last, density);
+                }
+            });
+
+        if (third_law)
+            {
+            // only the densities of the local particles are needed
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    for (unsigned int chunk = 1; chunk < n_chunks; ++chunk)
+                        m_atom_electron_density[i] += m_thread_density[(chunk-1)*N_tot + i];
+                });
+            }
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            compute_embedding(r.begin(), r.end());
+            });
+        }
+    else
+    #endif
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int) position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                + v.x * remainder * remainder * remainder;
+        compute_density(0, N, m_atom_electron_density.data());
+        compute_embedding(0, N);
+        }
 
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        // the forces on local particles depend on dF/dP of their ghost neighbors, which is known only to the owner
+        m_comm->updateGhostScalars(m_atom_dFdP.data());
         }
+    #endif
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #ifdef ENABLE_TBB
+    if (num_threads > 1 && !third_law)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar fxi = 0.0;
-        Scalar fyi = 0.0;
-        Scalar fzi = 0.0;
-        Scalar pei = 0.0;
-        Scalar viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int) h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
             {
-            // increment our calculation counter
-            n_calc++;
+            compute_force(r.begin(), r.end(), h_force.data, h_virial.data, virial_pitch);
+            });
+        }
+    else if (num_threads > 1)
+        {
+        const unsigned int n_chunks = num_threads;
+        m_thread_force.resize((n_chunks-1)*N_tot);
+        m_thread_virial.resize((n_chunks-1)*6*N);
 
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                {
+                unsigned int first = (unsigned int)((unsigned long long)N*chunk/n_chunks);
+                unsigned int last = (unsigned int)((unsigned long long)N*(chunk+1)/n_chunks);
 
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+                Scalar4 *force = h_force.data;
+                Scalar *virial = h_virial.data;
+                unsigned int pitch = virial_pitch;
+                if (chunk > 0)
+                    {
+                    force = m_thread_force.data() + (chunk-1)*N_tot;
+                    memset((void*)force, 0, sizeof(Scalar4)*N_tot);
+                    virial = m_thread_virial.data() + (chunk-1)*6*N;
+                    memset((void*)virial, 0, sizeof(Scalar)*6*N);
+                    pitch = N;
+                    }
+                compute_force(first, last, force, virial, pitch);
+                }
+            });
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-
-            // calculate position r for phi(r)
-            if (rsq >= r_cut_sq)
-                continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int) position;
-            int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
-            // calculate the shift position for type ij
-            int shift =
-                    (typei >= typej) ?
-                            (int) (0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr :
-                            (int) (0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
-            // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                    + v.x * remainder * remainder * remainder) * inverseR;
-            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
-            // derivativeRhoI = drho / dr of i
-            idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // derivativeRhoJ = drho / dr of j
-            idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                    + atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
-            // compute forces
-            Scalar pairForce = -fullDerivativePhi * inverseR;
-            viriali[0] += dx.x * dx.x * pairForce;
-            viriali[1] += dx.x * dx.y * pairForce;
-            viriali[2] += dx.x * dx.z * pairForce;
-            viriali[3] += dx.y * dx.y * pairForce;
-            viriali[4] += dx.y * dx.z * pairForce;
-            viriali[5] += dx.z * dx.z * pairForce;
-            fxi += dx.x * pairForce;
-            fyi += dx.y * pairForce;
-            fzi += dx.z * pairForce;
-            pei += pair_eng * 0.5;
-
-            if (third_law)
+        // sum the per-thread buffers into the force and virial arrays
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
                 {
-                h_force.data[k].x -= dx.x * pairForce;
-                h_force.data[k].y -= dx.y * pairForce;
-                h_force.data[k].z -= dx.z * pairForce;
-                h_force.data[k].w += pair_eng * 0.5;
+                for (unsigned int chunk = 1; chunk < n_chunks; ++chunk)
+                    {
+                    const Scalar4 f = m_thread_force[(chunk-1)*N_tot + i];
+                    h_force.data[i].x += f.x;
+                    h_force.data[i].y += f.y;
+                    h_force.data[i].z += f.z;
+                    h_force.data[i].w += f.w;
+
+                    for (unsigned int l = 0; l < 6; ++l)
+                        h_virial.data[l*virial_pitch + i] += m_thread_virial[(chunk-1)*6*N + l*N + i];
+                    }
                 }
-            }
-        h_force.data[i].x += fxi;
-        h_force.data[i].y += fyi;
-        h_force.data[i].z += fzi;
-        h_force.data[i].w += pei;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k * virial_pitch + i] += viriali[k];
+            });
+        }
+    else
+    #endif
+        {
+        compute_force(0, N, h_force.data, h_virial.data, virial_pitch);
         }
 
     int64_t flops = m_pdata->getN() * 5 + n_calc * (3 + 5 + 9 + 1 + 9 + 6 + 8);
@@ -42,6 +42,13 @@
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ \b Parallelization
+ The electron densities and dF/dP of the local particles are complete after the first two passes, because every
+ local particle has all of its neighbors (local or ghost) in the neighbor list. The force pass also needs dF/dP of
+ the ghost neighbors, which is copied from their owners with Communicator::updateGhostScalars() in between. With
+ more than one TBB thread, each of the three passes runs in parallel over the local particles. With a half neighbor
+ list, the contributions to the neighbors are accumulated in per-thread buffers.
+
  \ingroup computes
  */
 class EAMForceCompute: public ForceCompute
@@ -93,6 +100,12 @@ protected:
     GPUArray<Scalar4> m_drphi;             //!< derivative pair wise function and its coefficients
     GPUArray<Scalar> m_dFdP;               //!< derivative F / derivative P
 
+    std::vector<Scalar> m_atom_electron_density;   //!< Electron density of every local and ghost particle
+    std::vector<Scalar> m_atom_dFdP;               //!< dF/dP of every local and ghost particle
+    std::vector<Scalar> m_thread_density;          //!< Per-thread electron densities with a half neighbor list
+    std::vector<Scalar4> m_thread_force;           //!< Per-thread forces with a half neighbor list
+    std::vector<Scalar> m_thread_virial;           //!< Per-thread virials of the local particles with a half neighbor list
+
     //! Actually compute the forces
     virtual void computeForces(unsigned int timestep);
 
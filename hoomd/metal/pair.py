@@ -38,7 +38,7 @@ class eam(force._force):
     and are also described here: http://enpub.fulton.asu.edu/cms/potentials/submain/format.htm
 
     .. attention::
-        EAM is **NOT** supported in MPI parallel simulations.
+        EAM is supported in MPI parallel simulations only on the CPU.
 
     Example::
 
@@ -62,10 +62,10 @@ class eam(force._force):
 
         hoomd.util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (_hoomd.is_MPI_available()):
-            if hoomd.context.current.system_definition.getParticleData().getDomainDecomposition():
-                hoomd.context.msg.error("pair.eam is not supported in multi-processor simulations.\n\n")
+            if hoomd.context.current.system_definition.getParticleData().getDomainDecomposition() and hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.error("pair.eam is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up pair potential.")
 
         # initialize the base class
@@ -1,11 +1,25 @@
 from hoomd import *
 from hoomd import md
 from hoomd import metal
+from hoomd import _hoomd
+from hoomd.md import _md
 import unittest
 import numpy
 import os
 context.initialize()
 
+# the unit test uses a potential, which is sparsed from G.Purja Pun & Y. Mishin, 2009
+def write_potential():
+    tmpd = os.getcwd() + '/eamtemp/'
+    potf = tmpd + 'testpot'
+    if comm.get_rank() == 0:
+        os.system('rm -rf ' + tmpd)
+        os.system('mkdir -p ' + tmpd)
+        with open(potf, 'w') as outf:
+            outf.write('test potential sparse from:\n Mishin-Ni-Al-2009.eam.alloy\n Alloy\n 2 Ni Al\n 20 0.250661 20 0.31436 6.28721\n 28 58.71 3.52 fcc\n -0.0225464 -1.76636 -2.37638 -2.58753 -2.56335 \n -2.44363 -2.1936 -1.69669 -0.881535 0.259267 \n 1.71214 3.47279 5.52768 7.84679 10.3946 \n 13.1387 16.0533 19.12 22.3271 25.6681 \n 0.166428 0.170459 0.167088 0.158941 0.148264 \n 0.134559 0.116655 0.0950843 0.0717676 0.0494264 \n 0.0305923 0.0166948 0.00778478 0.00291687 0.00076581 \n 9.6658e-05 8.84137e-07 0 0 0 \n 13 26.982 4.05 fcc\n -4.3767e-11 -1.6886 -2.24356 -2.61981 -2.8881 \n -3.03673 -3.07531 -3.14579 -3.15517 -3.04228 \n -2.80696 -2.44921 -1.96903 -1.36641 -0.641356 \n 0.206131 1.17605 2.2684 3.48319 4.82042 \n 0.396504 0.268377 0.182302 0.130397 0.104787 \n 0.09764 0.10114 0.10747 0.108814 0.097359 \n 0.0701286 0.0394937 0.0192524 0.00952344 0.00538008 \n 0.00357488 0.0027837 0.00202854 0.0010566 9.93586e-05 \n 0 1.45214 3.46822 4.73416 4.63266 \n 3.27018 1.42217 0.00246105 -0.578463 -0.528943 \n -0.314831 -0.217411 -0.216257 -0.18649 -0.098564 \n -0.021759 -0.000310685 0 0 0 \n 0 2016.46 1530.29 608.866 120.656 \n 8.56573 1.68568 0.0591469 -0.564815 -0.587964 \n -0.416922 -0.286477 -0.251829 -0.249993 -0.216214 \n -0.137026 -0.0706754 -0.0262716 -1.62953e-08 0 \n 0 10.7294 10.5529 7.42998 5.15814 \n 4.13394 3.26306 1.83395 0.548762 0.044061 \n -0.0987007 -0.134826 -0.151869 -0.205764 -0.215437 \n -0.169569 -0.0703696 0.0113375 0.0283944 0.00186361 \n')
+    comm.barrier_all()
+    return potf
+
 class eam_tests(unittest.TestCase):
     # setUp is called before the start of every test method
     def setUp(self):
@@ -23,19 +37,12 @@ class eam_tests(unittest.TestCase):
         poslst = [pos1, pos2, pos3, pos4]
         # - generate system -
         snapshot = data.make_snapshot(N=4, box=data.boxdim(L=ltconst), particle_types=[type1, type2])
-        system = init.read_snapshot(snapshot)
-        for p in system.particles:
+        self.system = init.read_snapshot(snapshot)
+        for p in self.system.particles:
             p.position = poslst[p.tag]
             p.type = typelst[p.tag]
             p.mass = masslst[p.tag]
-        cwd = os.getcwd()
-        # the unit test uses a potential, which is sparsed from G.Purja Pun & Y. Mishin, 2009
-        tmpd = cwd + '/eamtemp/'
-        os.system('rm -rf ' + tmpd)
-        os.system('mkdir -p ' + tmpd)
-        potf = tmpd + 'testpot'
-        with open(potf, 'w') as outf:
-            outf.write('test potential sparse from:\n Mishin-Ni-Al-2009.eam.alloy\n Alloy\n 2 Ni Al\n 20 0.250661 20 0.31436 6.28721\n 28 58.71 3.52 fcc\n -0.0225464 -1.76636 -2.37638 -2.58753 -2.56335 \n -2.44363 -2.1936 -1.69669 -0.881535 0.259267 \n 1.71214 3.47279 5.52768 7.84679 10.3946 \n 13.1387 16.0533 19.12 22.3271 25.6681 \n 0.166428 0.170459 0.167088 0.158941 0.148264 \n 0.134559 0.116655 0.0950843 0.0717676 0.0494264 \n 0.0305923 0.0166948 0.00778478 0.00291687 0.00076581 \n 9.6658e-05 8.84137e-07 0 0 0 \n 13 26.982 4.05 fcc\n -4.3767e-11 -1.6886 -2.24356 -2.61981 -2.8881 \n -3.03673 -3.07531 -3.14579 -3.15517 -3.04228 \n -2.80696 -2.44921 -1.96903 -1.36641 -0.641356 \n 0.206131 1.17605 2.2684 3.48319 4.82042 \n 0.396504 0.268377 0.182302 0.130397 0.104787 \n 0.09764 0.10114 0.10747 0.108814 0.097359 \n 0.0701286 0.0394937 0.0192524 0.00952344 0.00538008 \n 0.00357488 0.0027837 0.00202854 0.0010566 9.93586e-05 \n 0 1.45214 3.46822 4.73416 4.63266 \n 3.27018 1.42217 0.00246105 -0.578463 -0.528943 \n -0.314831 -0.217411 -0.216257 -0.18649 -0.098564 \n -0.021759 -0.000310685 0 0 0 \n 0 2016.46 1530.29 608.866 120.656 \n 8.56573 1.68568 0.0591469 -0.564815 -0.587964 \n -0.416922 -0.286477 -0.251829 -0.249993 -0.216214 \n -0.137026 -0.0706754 -0.0262716 -1.62953e-08 0 \n 0 10.7294 10.5529 7.42998 5.15814 \n 4.13394 3.26306 1.83395 0.548762 0.044061 \n -0.0987007 -0.134826 -0.151869 -0.205764 -0.215437 \n -0.169569 -0.0703696 0.0113375 0.0283944 0.00186361 \n')
+        write_potential()
 
     # API test: class initialization
     def test_API(self):
@@ -71,6 +78,95 @@ class eam_tests(unittest.TestCase):
 
         os.system('rm -rf ' + tmpd)
 
+    # Unit test: the forces, energies, virials and pressure are the same when the particles are split over several
+    # domains
+    def test_force_domains(self):
+        potf = write_potential()
+
+        nl = md.nlist.cell()
+        eam = metal.pair.eam(file=potf, type="Alloy", nlist=nl)
+        md.integrate.mode_standard(dt=0.0)
+        md.integrate.nve(group=group.all())
+        quantities = ['pressure', 'pressure_xx', 'pressure_xy', 'pressure_xz', 'pressure_yy', 'pressure_yz', 'pressure_zz']
+        log = analyze.log(filename=None, quantities=quantities, period=1)
+
+        # in the corner of the box, all particles are in the same domain, like in a single rank run
+        run(1)
+        W_ref = numpy.array([x.virial for x in eam.forces])
+        P_ref = numpy.array([log.query(q) for q in quantities])
+
+        # translate the particles so that they straddle the domain boundaries at the center of the box
+        for p in self.system.particles:
+            p.position = tuple(x + 9.0 for x in p.position)
+        run(1)
+
+        F = numpy.array([x.force for x in eam.forces])
+        U = numpy.array([x.energy for x in eam.forces])
+        W = numpy.array([x.virial for x in eam.forces])
+        P = numpy.array([log.query(q) for q in quantities])
+
+        # the single rank result of test_force
+        F_ref = numpy.array([[0.49554526, 1.10342697, -2.7692858],
+                             [0.70281927, -1.43558566, 3.87260803],
+                             [-2.00473055, 1.53052375, -0.60778632],
+                             [0.80636601, -1.19836506, -0.49553591]])
+        U_ref = numpy.array([-0.93424631, -1.23440579, -1.71025268, -1.4023109])
+
+        numpy.testing.assert_allclose(F, F_ref, rtol=1e-5)
+        numpy.testing.assert_allclose(U, U_ref, rtol=1e-6)
+        numpy.testing.assert_allclose(W, W_ref, rtol=1e-6, atol=1e-8)
+        numpy.testing.assert_allclose(P, P_ref, rtol=1e-6, atol=1e-8)
+
+        # the pair virials add up to the total virial
+        numpy.testing.assert_allclose(numpy.sum(W[:,0]+W[:,3]+W[:,5])/(3*self.system.box.get_volume()), P[0],
+                                      rtol=1e-6, atol=1e-8)
+
+    # tearDown is called at the end of every test method
+    def tearDown(self):
+        context.initialize()
+
+class eam_lattice_tests(unittest.TestCase):
+    # setUp is called before the start of every test method
+    def setUp(self):
+        # a perturbed fcc lattice of Ni with some Al
+        self.system = init.create_lattice(lattice.fcc(a=3.52, type_name='Ni'), n=4)
+        self.system.particles.types.add('Al')
+
+        snap = self.system.take_snapshot()
+        if comm.get_rank() == 0:
+            numpy.random.seed(12345)
+            L = snap.box.Lx
+            pos = snap.particles.position + numpy.random.uniform(-0.1, 0.1, size=(snap.particles.N, 3))
+            snap.particles.position[:] = numpy.mod(pos + 0.5*L, L) - 0.5*L
+            snap.particles.typeid[::5] = 1
+        self.system.restore_snapshot(snap)
+
+        self.potf = write_potential()
+
+    # compute the forces and energies with the given number of threads
+    def compute(self, eam, nthreads):
+        option.set_num_threads(nthreads)
+        run(1)
+        F = numpy.array([x.force for x in eam.forces])
+        U = numpy.array([x.energy for x in eam.forces])
+        return F, U
+
+    # Unit test: threaded forces and energies match the serial evaluation, with full and half neighbor lists
+    @unittest.skipIf(not _hoomd.is_TBB_available(), "requires TBB")
+    def test_force_threads(self):
+        nl = md.nlist.cell()
+        eam = metal.pair.eam(file=self.potf, type="Alloy", nlist=nl)
+        md.integrate.mode_standard(dt=0.0)
+        md.integrate.nve(group=group.all())
+
+        for storage_mode in [_md.NeighborList.storageMode.half, _md.NeighborList.storageMode.full]:
+            nl.cpp_nlist.setStorageMode(storage_mode)
+            F_serial, U_serial = self.compute(eam, 1)
+            F, U = self.compute(eam, 4)
+
+            numpy.testing.assert_allclose(F, F_serial, rtol=1e-6, atol=1e-8)
+            numpy.testing.assert_allclose(U, U_serial, rtol=1e-6, atol=1e-8)
+
     # tearDown is called at the end of every test method
     def tearDown(self):
         context.initialize()
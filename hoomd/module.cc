@@ -28,6 +28,7 @@
 #include "GSDDumpWriter.h"
 #include "Logger.h"
 #include "LogPlainTXT.h"
+#include "LogBinary.h"
 #include "LogMatrix.h"
 #include "LogHDF5.h"
 #include "CallbackAnalyzer.h"
@@ -367,6 +368,7 @@ PYBIND11_MODULE(_hoomd, m)
     export_GSDDumpWriter(m);
     export_Logger(m);
     export_LogPlainTXT(m);
+    export_LogBinary(m);
     export_LogMatrix(m);
     export_LogHDF5(m);
     export_CallbackAnalyzer(m);
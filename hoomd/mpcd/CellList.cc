@@ -10,6 +10,10 @@
 #include "hoomd/Communicator.h"
 #endif // ENABLE_MPI
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif // ENABLE_TBB
+
 /*!
  * \file mpcd/CellList.cc
  * \brief Definition of mpcd::CellList
@@ -19,6 +23,7 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
         : Compute(sysdef), m_mpcd_pdata(mpcd_pdata),
           m_cell_size(1.0), m_cell_np_max(4), m_cell_np(m_exec_conf), m_cell_list(m_exec_conf),
+          m_cell_offsets(m_exec_conf), m_cell_members(m_exec_conf), m_cell_list_stale(false),
           m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_needs_compute_dim(true),
           m_particles_sorted(false), m_virtual_change(false)
     {
@@ -124,12 +129,23 @@ void mpcd::CellList::compute(unsigned int timestep)
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * The compressed cell list never overflows, so the per-cell memory only depends on the
+ * number of cells. The padded cell list is not allocated until it is requested.
+ */
 void mpcd::CellList::reallocate()
     {
-    m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << m_cell_np_max
-                                << " particles in " << m_cell_indexer.getNumElements() << " cells." << std::endl;
-    m_cell_list_indexer = Index2D(m_cell_np_max, m_cell_indexer.getNumElements());
-    m_cell_list.resize(m_cell_list_indexer.getNumElements());
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << n_cells << " cells." << std::endl;
+    m_cell_list_indexer = Index2D(m_cell_np_max, n_cells);
+    m_cell_offsets.resize(n_cells+1);
+
+    // no particles are binned into the new cells yet
+    ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cell_offsets, access_location::host, access_mode::overwrite);
+    memset(h_cell_np.data, 0, sizeof(unsigned int) * n_cells);
+    memset(h_cell_offsets.data, 0, sizeof(unsigned int) * (n_cells+1));
+    m_cell_list_stale = true;
     }
 
 void mpcd::CellList::updateGlobalBox()
@@ -492,24 +508,30 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
 #endif // ENABLE_MPI
 
 /*!
- * \param timestep Current simulation timestep
+ * The particles are binned with a counting sort. The first pass finds the cell of every particle
+ * and counts the particles per cell, an exclusive scan over the counts gives the offset of every
+ * cell, and the second pass stores the particles into their cells in order of their index.
  */
 void mpcd::CellList::buildCellList()
     {
     const BoxDim& box = m_pdata->getBox();
     const uchar3 periodic = box.getPeriodic();
 
-    ArrayHandle<unsigned int> h_cell_list(m_cell_list, access_location::host, access_mode::overwrite);
+    unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    unsigned int N_tot = N_mpcd;
+    if (m_embed_group)
+        N_tot += m_embed_group->getNumMembers();
+    m_cell_members.resize(N_tot);
+
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    ArrayHandle<unsigned int> h_cell_offsets(m_cell_offsets, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_members(m_cell_members, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
-    // zero the cell counter
-    memset(h_cell_np.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
 
     uint3 conditions = make_uint3(0,0,0);
 
     ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-    unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
-    unsigned int N_tot = N_mpcd;
 
     // we can't modify the velocity of embedded particles, so we only read their position
     std::unique_ptr< ArrayHandle<unsigned int> > h_embed_cell_ids;
@@ -520,7 +542,6 @@ void mpcd::CellList::buildCellList()
         h_embed_cell_ids.reset(new ArrayHandle<unsigned int>(m_embed_cell_ids, access_location::host, access_mode::overwrite));
         h_pos_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getPositions(), access_location::host, access_mode::read));
         h_embed_member_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(), access_location::host, access_mode::read));
-        N_tot += m_embed_group->getNumMembers();
         }
 
     // total effective number of cells in the global box, optionally padded by
@@ -534,7 +555,9 @@ void mpcd::CellList::buildCellList()
 
     const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
 
-    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+    // finds the cell of particle cur_p, returns NOT_BINNED and sets the error conditions if it cannot be binned
+    const unsigned int NOT_BINNED = 0xffffffff;
+    auto compute_bin = [&](unsigned int cur_p, uint3& cond) -> unsigned int
         {
         Scalar4 postype_i;
         if (cur_p < N_mpcd)
@@ -549,8 +572,8 @@ void mpcd::CellList::buildCellList()
 
         if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
             {
-            conditions.y = cur_p + 1;
-            continue;
+            cond.y = cur_p + 1;
+            return NOT_BINNED;
             }
 
         // bin particle assuming orthorhombic box (already validated)
@@ -594,40 +617,194 @@ void mpcd::CellList::buildCellList()
             (bin.y < 0 || bin.y >= (int)m_cell_dim.y) ||
             (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
             {
-            conditions.z = cur_p + 1;
-            continue;
+            cond.z = cur_p + 1;
+            return NOT_BINNED;
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
-        unsigned int offset = h_cell_np.data[bin_idx];
-        if (offset < m_cell_np_max)
+        return m_cell_indexer(bin.x, bin.y, bin.z);
+        };
+
+    // the current particle bin is stashed into the velocity array, so it is not stored twice
+    auto set_bin = [&](unsigned int cur_p, unsigned int bin_idx)
+        {
+        if (cur_p < N_mpcd)
             {
-            h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
+            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
             }
         else
             {
-            // overflow
-            conditions.x = std::max(conditions.x, offset+1);
+            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
             }
-
-        // stash the current particle bin into the velocity array
+        };
+    auto get_bin = [&](unsigned int cur_p) -> unsigned int
+        {
         if (cur_p < N_mpcd)
             {
-            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+            return __scalar_as_int(h_vel.data[cur_p].w);
             }
         else
             {
-            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
+            return h_embed_cell_ids->data[cur_p - N_mpcd];
+            }
+        };
+
+    // exclusive scan of the cell sizes into the cell offsets
+    auto scan_cells = [&]()
+        {
+        unsigned int sum = 0;
+        unsigned int max_np = 0;
+        for (unsigned int cur_cell = 0; cur_cell < n_cells; ++cur_cell)
+            {
+            const unsigned int np = h_cell_np.data[cur_cell];
+            h_cell_offsets.data[cur_cell] = sum;
+            sum += np;
+            if (np > max_np) max_np = np;
             }
+        h_cell_offsets.data[n_cells] = sum;
+        return max_np;
+        };
+
+    unsigned int max_np;
+    #ifdef ENABLE_TBB
+    // every chunk holds a histogram over all cells, so limit the chunks to keep n_chunks*n_cells below the
+    // number of particles. Sparse systems with many cells are built serially.
+    const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), N_tot / std::max(n_cells, 1u));
+    if (n_chunks > 1)
+        {
+        // one contiguous chunk of particles per thread: the chunks count their members per cell,
+        // a scan over the chunks gives every chunk its first slot in each cell, and the chunks then
+        // store their particles in order. This reproduces the order of the serial build exactly.
+        m_chunk_offset.assign(n_chunks*n_cells, 0);
+        std::vector<uint3> chunk_conditions(n_chunks, make_uint3(0,0,0));
+
+        auto chunk_begin = [&](unsigned int chunk)
+            {
+            return (unsigned int)((unsigned long long)N_tot*chunk/n_chunks);
+            };
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                {
+                unsigned int *count = &m_chunk_offset[chunk*n_cells];
+                for (unsigned int cur_p = chunk_begin(chunk); cur_p < chunk_begin(chunk+1); ++cur_p)
+                    {
+                    const unsigned int bin_idx = compute_bin(cur_p, chunk_conditions[chunk]);
+                    set_bin(cur_p, bin_idx);
+                    if (bin_idx != NOT_BINNED)
+                        ++count[bin_idx];
+                    }
+                }
+            });
 
-        // increment the counter always
-        ++h_cell_np.data[bin_idx];
+        // exclusive scan over the chunks, per cell
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int cur_cell = r.begin(); cur_cell != r.end(); ++cur_cell)
+                {
+                unsigned int sum = 0;
+                for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+                    {
+                    const unsigned int count = m_chunk_offset[chunk*n_cells + cur_cell];
+                    m_chunk_offset[chunk*n_cells + cur_cell] = sum;
+                    sum += count;
+                    }
+                h_cell_np.data[cur_cell] = sum;
+                }
+            });
+
+        max_np = scan_cells();
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                {
+                unsigned int *offset = &m_chunk_offset[chunk*n_cells];
+                for (unsigned int cur_p = chunk_begin(chunk); cur_p < chunk_begin(chunk+1); ++cur_p)
+                    {
+                    const unsigned int bin_idx = get_bin(cur_p);
+                    if (bin_idx == NOT_BINNED)
+                        continue;
+
+                    h_cell_members.data[h_cell_offsets.data[bin_idx] + offset[bin_idx]++] = cur_p;
+                    }
+                }
+            });
+
+        // the serial build reports the last offending particle, which is the one with the largest index
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+            {
+            conditions.y = std::max(conditions.y, chunk_conditions[chunk].y);
+            conditions.z = std::max(conditions.z, chunk_conditions[chunk].z);
+            }
+        }
+    else
+    #endif // ENABLE_TBB
+        {
+        memset(h_cell_np.data, 0, sizeof(unsigned int) * n_cells);
+        for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+            {
+            const unsigned int bin_idx = compute_bin(cur_p, conditions);
+            set_bin(cur_p, bin_idx);
+            if (bin_idx != NOT_BINNED)
+                ++h_cell_np.data[bin_idx];
+            }
+
+        max_np = scan_cells();
+
+        // use the offsets as insertion points, which leaves each of them at the start of the next cell
+        for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+            {
+            const unsigned int bin_idx = get_bin(cur_p);
+            if (bin_idx == NOT_BINNED)
+                continue;
+
+            h_cell_members.data[h_cell_offsets.data[bin_idx]++] = cur_p;
+            }
+        for (unsigned int cur_cell = n_cells; cur_cell > 0; --cur_cell)
+            {
+            h_cell_offsets.data[cur_cell] = h_cell_offsets.data[cur_cell-1];
+            }
+        h_cell_offsets.data[0] = 0;
+        }
+
+    // the padded cell list is sized for the largest cell, but only filled on request
+    if (max_np > m_cell_np_max)
+        {
+        m_cell_np_max = max_np;
+        m_cell_list_indexer = Index2D(m_cell_np_max, n_cells);
         }
+    m_cell_list_stale = true;
 
     // write out the conditions
     m_conditions.resetFlags(conditions);
     }
 
+void mpcd::CellList::fillCellList() const
+    {
+    m_cell_list.resize(m_cell_list_indexer.getNumElements());
+
+    ArrayHandle<unsigned int> h_cell_list(m_cell_list, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cell_offsets, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_members(m_cell_members, access_location::host, access_mode::read);
+
+    for (unsigned int cur_cell = 0; cur_cell < m_cell_indexer.getNumElements(); ++cur_cell)
+        {
+        const unsigned int np = h_cell_np.data[cur_cell];
+        const unsigned int first = h_cell_offsets.data[cur_cell];
+        for (unsigned int offset = 0; offset < np; ++offset)
+            {
+            h_cell_list.data[m_cell_list_indexer(offset, cur_cell)] = h_cell_members.data[first + offset];
+            }
+        }
+
+    m_cell_list_stale = false;
+    }
+
 /*!
  * \param timestep Timestep that the sorting occurred
  * \param order Mapping of sorted particle indexes onto old particle indexes
@@ -651,24 +828,22 @@ void mpcd::CellList::sort(unsigned int timestep,
 
     // iterate through particles in cell list, and update their indexes using reverse mapping
     ArrayHandle<unsigned int> h_rorder(rorder, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_cell_list(m_cell_list, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cell_offsets, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_members(m_cell_members, access_location::host, access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN();
 
-    for (unsigned int idx=0; idx < getNCells(); ++idx)
+    const unsigned int n_members = h_cell_offsets.data[getNCells()];
+    for (unsigned int i=0; i < n_members; ++i)
         {
-        const unsigned int np = h_cell_np.data[idx];
-        for (unsigned int offset = 0; offset < np; ++offset)
+        const unsigned int pid = h_cell_members.data[i];
+        // only update indexes of MPCD particles, not virtual or embedded particles
+        if (pid < N_mpcd)
             {
-            const unsigned int cl_idx = m_cell_list_indexer(offset,idx);
-            const unsigned int pid = h_cell_list.data[cl_idx];
-            // only update indexes of MPCD particles, not virtual or embedded particles
-            if (pid < N_mpcd)
-                {
-                h_cell_list.data[cl_idx] = h_rorder.data[pid];
-                }
+            h_cell_members.data[i] = h_rorder.data[pid];
             }
         }
+
+    m_cell_list_stale = true;
     }
 
 #ifdef ENABLE_MPI
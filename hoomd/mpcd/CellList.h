@@ -26,6 +26,7 @@
 #include "hoomd/extern/pybind/include/pybind11/pybind11.h"
 
 #include <array>
+#include <vector>
 
 namespace mpcd
 {
@@ -48,11 +49,34 @@ class PYBIND11_EXPORT CellList : public Compute
         void computeDimensions();
 
         //! Get the cell list data
+        /*!
+         * The cell list is stored on the CPU only in the compressed layout of getCellOffsets()
+         * and getCellMembers(). The padded layout is filled from it when it is first requested
+         * after a build.
+         */
         const GPUArray<unsigned int>& getCellList() const
             {
+            if (m_cell_list_stale)
+                fillCellList();
             return m_cell_list;
             }
 
+        //! Get the offset of each cell in the compressed cell list
+        /*!
+         * The members of cell \a i are stored in getCellMembers() from index offset[i]
+         * up to (but not including) offset[i+1]. The compressed layout is only built on the CPU.
+         */
+        const GPUArray<unsigned int>& getCellOffsets() const
+            {
+            return m_cell_offsets;
+            }
+
+        //! Get the compressed cell list, with the particles of all cells packed in cell order
+        const GPUArray<unsigned int>& getCellMembers() const
+            {
+            return m_cell_members;
+            }
+
         //! Get the number of particles per cell
         const GPUArray<unsigned int>& getCellSizeArray() const
             {
@@ -255,7 +279,10 @@ class PYBIND11_EXPORT CellList : public Compute
         Index2D m_cell_list_indexer;                //!< Indexer into cell list members
         unsigned int m_cell_np_max;                 //!< Maximum number of particles per cell
         GPUVector<unsigned int> m_cell_np;          //!< Number of particles per cell
-        GPUVector<unsigned int> m_cell_list;        //!< Cell list of particles
+        mutable GPUVector<unsigned int> m_cell_list;    //!< Cell list of particles (padded layout)
+        GPUVector<unsigned int> m_cell_offsets;     //!< Offset of each cell in the compressed cell list
+        GPUVector<unsigned int> m_cell_members;     //!< Compressed cell list of particles
+        mutable bool m_cell_list_stale;             //!< True if the padded cell list must be filled before use
         GPUVector<unsigned int> m_embed_cell_ids;   //!< Cell ids of the embedded particles
         GPUFlags<uint3> m_conditions;               //!< Detect conditions that might fail building cell list
 
@@ -279,6 +306,9 @@ class PYBIND11_EXPORT CellList : public Compute
         //! Builds the cell list and handles cell list memory
         virtual void buildCellList();
 
+        //! Fills the padded cell list from the compressed cell list
+        void fillCellList() const;
+
         //! Callback to sort cell list when particle data is sorted
         virtual void sort(unsigned int timestep,
                           const GPUArray<unsigned int>& order,
@@ -286,6 +316,7 @@ class PYBIND11_EXPORT CellList : public Compute
 
     private:
         bool m_needs_compute_dim;   //!< True if the dimensions need to be (re-)computed
+        std::vector<unsigned int> m_chunk_offset;   //!< Per-thread cell counters for the threaded build
         //! Slot for box resizing
         void slotBoxChanged()
             {
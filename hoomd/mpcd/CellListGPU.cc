@@ -30,6 +30,14 @@ mpcd::CellListGPU::~CellListGPU()
     {
     }
 
+void mpcd::CellListGPU::reallocate()
+    {
+    m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << m_cell_np_max
+                                << " particles in " << m_cell_indexer.getNumElements() << " cells." << std::endl;
+    m_cell_list_indexer = Index2D(m_cell_np_max, m_cell_indexer.getNumElements());
+    m_cell_list.resize(m_cell_list_indexer.getNumElements());
+    }
+
 void mpcd::CellListGPU::buildCellList()
     {
     ArrayHandle<unsigned int> d_cell_list(m_cell_list, access_location::device, access_mode::overwrite);
@@ -11,6 +11,10 @@
 #include "CellThermoCompute.h"
 #include "ReductionOperators.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif // ENABLE_TBB
+
 /*!
  * \param sysdata MPCD system data
  * \param suffix Suffix for logged quantities
@@ -137,24 +141,22 @@ struct CellPropertySum
     {
     //! Constructor
     /*!
-     * \param cell_list_ Cell list
-     * \param cell_np_ Number of particles per cell
-     * \param cli_ Cell list indexer
+     * \param cell_members_ Compressed cell list
+     * \param cell_offsets_ Offset of each cell in the compressed cell list
      * \param vel_ MPCD particle velocities
      * \param mass_ MPCD mass
      * \param embed_vel_ Embedded particle velocities
      * \param embed_idx_ Embedded particle indexes
      * \param N_mpcd_ Number of MPCD particles
      */
-    CellPropertySum(const unsigned int *cell_list_,
-                    const unsigned int *cell_np_,
-                    const Index2D& cli_,
+    CellPropertySum(const unsigned int *cell_members_,
+                    const unsigned int *cell_offsets_,
                     const Scalar4 *vel_,
                     const Scalar mass_,
                     const Scalar4 *embed_vel_,
                     const unsigned int *embed_idx_,
                     const unsigned int N_mpcd_)
-        : cell_list(cell_list_), cell_np(cell_np_), cli(cli_), vel(vel_), mass(mass_),
+        : cell_members(cell_members_), cell_offsets(cell_offsets_), vel(vel_), mass(mass_),
           embed_vel(embed_vel_), embed_idx(embed_idx_), N_mpcd(N_mpcd_)
         {}
 
@@ -170,12 +172,13 @@ struct CellPropertySum
         {
         momentum = make_double4(0.0, 0.0, 0.0, 0.0);
         ke = 0.0;
-        np = cell_np[cell];
+        const unsigned int first = cell_offsets[cell];
+        np = cell_offsets[cell+1] - first;
 
         for (unsigned int offset = 0; offset < np; ++offset)
             {
             // Load particle data
-            const unsigned int cur_p = cell_list[cli(offset, cell)];
+            const unsigned int cur_p = cell_members[first + offset];
             double3 vel_i;
             double mass_i;
             if (cur_p < N_mpcd)
@@ -203,9 +206,8 @@ struct CellPropertySum
             }
     }
 
-    const unsigned int *cell_list;  //!< Cell list
-    const unsigned int *cell_np;    //!< Number of particles per cell
-    const Index2D cli;              //!< Cell list indexer
+    const unsigned int *cell_members;   //!< Compressed cell list
+    const unsigned int *cell_offsets;   //!< Offset of each cell in the compressed cell list
 
     const Scalar4 *vel;             //!< MPCD particle velocities
     const Scalar mass;              //!< MPCD particle mass
@@ -213,6 +215,46 @@ struct CellPropertySum
     const unsigned int *embed_idx;  //!< Embedded particle indexes
     const unsigned int N_mpcd;      //!< Number of MPCD particles
     };
+
+//! Converts the sums over a cell into the cell properties
+/*!
+ * \param cell_vel Average velocity and mass of the cell (output)
+ * \param cell_energy Kinetic energy, temperature, and number of particles of the cell (output)
+ * \param momentum Total momentum and mass of the cell
+ * \param ke Total kinetic energy of the cell
+ * \param np Number of particles in the cell
+ * \param ndim Number of dimensions
+ * \param energy If true, then \a cell_energy is evaluated
+ */
+inline void finalize_cell_properties(double4& cell_vel,
+                                     double3& cell_energy,
+                                     const double4& momentum,
+                                     const double ke,
+                                     const unsigned int np,
+                                     const unsigned int ndim,
+                                     const bool energy)
+    {
+    const double mass = momentum.w;
+    double3 vel_cm = make_double3(0.0,0.0,0.0);
+    if (mass > 0.)
+        {
+        vel_cm.x = momentum.x / mass;
+        vel_cm.y = momentum.y / mass;
+        vel_cm.z = momentum.z / mass;
+        }
+
+    cell_vel = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+    if (energy)
+        {
+        double temp(0.0);
+        if (np > 1)
+            {
+            const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
+            temp = 2. * (ke - ke_cm) / (ndim * (np-1));
+            }
+        cell_energy = make_double3(ke, temp, __int_as_double(np));
+        }
+    }
 } // end namespace detail
 } // end namespace mpcd
 
@@ -220,9 +262,8 @@ struct CellPropertySum
 void mpcd::CellThermoCompute::beginOuterCellProperties()
     {
     // Cell list
-    ArrayHandle<unsigned int> h_cell_list(m_cl->getCellList(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
-    const Index2D& cli = m_cl->getCellListIndexer();
+    ArrayHandle<unsigned int> h_cell_members(m_cl->getCellMembers(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(), access_location::host, access_mode::read);
 
     // MPCD particle data
     ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
@@ -242,9 +283,8 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
     ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::overwrite);
     ArrayHandle<double3> h_cell_energy(m_cell_energy, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cells(m_vel_comm->getCells(), access_location::host, access_mode::read);
-    mpcd::detail::CellPropertySum summer(h_cell_list.data,
-                                         h_cell_np.data,
-                                         cli,
+    mpcd::detail::CellPropertySum summer(h_cell_members.data,
+                                         h_cell_offsets.data,
                                          h_vel.data,
                                          mpcd_mass,
                                          (m_cl->getEmbeddedGroup()) ? h_embed_vel->data : NULL,
@@ -312,9 +352,8 @@ void mpcd::CellThermoCompute::finishOuterCellProperties()
 void mpcd::CellThermoCompute::calcInnerCellProperties()
     {
     // Cell list
-    const Index2D& cli = m_cl->getCellListIndexer();
-    ArrayHandle<unsigned int> h_cell_list(m_cl->getCellList(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_members(m_cl->getCellMembers(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(), access_location::host, access_mode::read);
 
     // MPCD particle data
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
@@ -333,9 +372,8 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     // Cell properties
     ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::readwrite);
     ArrayHandle<double3> h_cell_energy(m_cell_energy, access_location::host, access_mode::readwrite);
-    mpcd::detail::CellPropertySum summer(h_cell_list.data,
-                                         h_cell_np.data,
-                                         cli,
+    mpcd::detail::CellPropertySum summer(h_cell_members.data,
+                                         h_cell_offsets.data,
                                          h_vel.data,
                                          mpcd_mass,
                                          (m_cl->getEmbeddedGroup()) ? h_embed_vel->data : NULL,
@@ -377,31 +415,142 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
                 double4 momentum; double ke(0.0); unsigned int np(0);
                 summer.compute(momentum, ke, np, cur_cell, need_energy);
 
-                const double mass = momentum.w;
-                double3 vel_cm = make_double3(0.0,0.0,0.0);
-                if (mass > 0.)
-                    {
-                    vel_cm.x = momentum.x / mass;
-                    vel_cm.y = momentum.y / mass;
-                    vel_cm.z = momentum.z / mass;
-                    }
-
-                h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+                double4 cell_vel; double3 cell_energy;
+                mpcd::detail::finalize_cell_properties(cell_vel, cell_energy, momentum, ke, np, m_sysdef->getNDimensions(), need_energy);
+                h_cell_vel.data[cur_cell] = cell_vel;
                 if (need_energy)
-                    {
-                    double temp(0.0);
-                    if (np > 1)
-                        {
-                        const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
-                        temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np-1));
-                        }
-                    h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
-                    }
+                    h_cell_energy.data[cur_cell] = cell_energy;
                 } // i
             } //j
         } // k
     }
 
+/*!
+ * \param timestep Current timestep
+ * \returns True if computeFused() can be used at \a timestep
+ *
+ * The fused sweep needs the final properties of a cell as soon as its members have been summed.
+ * This is not possible in MPI simulations, where the outer cells are completed by communication,
+ * or when callbacks are attached. It is also not needed if the properties have already been computed
+ * at \a timestep.
+ */
+bool mpcd::CellThermoCompute::canComputeFused(unsigned int timestep)
+    {
+    #ifdef ENABLE_MPI
+    if (m_use_mpi) return false;
+    #endif // ENABLE_MPI
+
+    return (peekCompute(timestep) && m_callbacks.empty());
+    }
+
+/*!
+ * \param timestep Current timestep
+ * \param op Operation applied to each cell
+ *
+ * The properties of each cell are summed from its members in the compressed cell list, and \a op
+ * is applied to the cell right afterwards, while the velocities of its members are still cached.
+ * Together with a cell-sorted particle order, the particle data is streamed only once. The cells are
+ * distributed over the TBB threads in contiguous blocks, so \a op may only modify data of its own cell,
+ * including the velocities of its members.
+ *
+ * The stored cell properties are those before \a op was applied, like with compute().
+ *
+ * \pre canComputeFused() is true at \a timestep.
+ */
+void mpcd::CellThermoCompute::computeFused(unsigned int timestep, const CellOp& op)
+    {
+    assert(canComputeFused(timestep));
+    shouldCompute(timestep);
+    m_last_computed = timestep;
+
+    // cell list needs to be up to date first
+    m_cl->compute(timestep);
+
+    // ensure optional flags are up to date
+    updateFlags();
+
+    const unsigned int ncells = m_cl->getNCells();
+    if (ncells != m_ncells_alloc)
+        {
+        reallocate(ncells);
+        }
+
+    // Cell list
+    ArrayHandle<unsigned int> h_cell_members(m_cl->getCellMembers(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(), access_location::host, access_mode::read);
+
+    // MPCD particle data, the velocities may be modified by the operation
+    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    const Scalar mpcd_mass = m_mpcd_pdata->getMass();
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+
+    // Embedded particle data
+    std::unique_ptr< ArrayHandle<Scalar4> > h_embed_vel;
+    std::unique_ptr< ArrayHandle<unsigned int> > h_embed_member_idx;
+    if (m_cl->getEmbeddedGroup())
+        {
+        h_embed_vel.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(), access_location::host, access_mode::readwrite));
+        h_embed_member_idx.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedGroup()->getIndexArray(), access_location::host, access_mode::read));
+        }
+
+    // Cell properties
+    ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle<double3> h_cell_energy(m_cell_energy, access_location::host, access_mode::overwrite);
+
+    mpcd::detail::CellMembers cell_members;
+    cell_members.vel = h_vel.data;
+    cell_members.embed_vel = (m_cl->getEmbeddedGroup()) ? h_embed_vel->data : NULL;
+    cell_members.embed_idx = (m_cl->getEmbeddedGroup()) ? h_embed_member_idx->data : NULL;
+    cell_members.N_mpcd = N_mpcd;
+
+    const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
+    const unsigned int ndim = m_sysdef->getNDimensions();
+    auto process_cells = [&](unsigned int first, unsigned int last)
+        {
+        mpcd::detail::CellPropertySum summer(h_cell_members.data,
+                                             h_cell_offsets.data,
+                                             h_vel.data,
+                                             mpcd_mass,
+                                             cell_members.embed_vel,
+                                             cell_members.embed_idx,
+                                             N_mpcd);
+        mpcd::detail::CellMembers cur_members = cell_members;
+
+        for (unsigned int cur_cell = first; cur_cell < last; ++cur_cell)
+            {
+            double4 momentum; double ke(0.0); unsigned int np(0);
+            summer.compute(momentum, ke, np, cur_cell, need_energy);
+
+            double4 cell_vel; double3 cell_energy = make_double3(0.0, 0.0, 0.0);
+            mpcd::detail::finalize_cell_properties(cell_vel, cell_energy, momentum, ke, np, ndim, need_energy);
+            h_cell_vel.data[cur_cell] = cell_vel;
+            if (need_energy)
+                h_cell_energy.data[cur_cell] = cell_energy;
+
+            cur_members.members = h_cell_members.data + h_cell_offsets.data[cur_cell];
+            cur_members.np = np;
+            op(cur_cell, cur_members, cell_vel, cell_energy);
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ncells),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            process_cells(r.begin(), r.end());
+            });
+        }
+    else
+    #endif // ENABLE_TBB
+        {
+        process_cells(0, ncells);
+        }
+
+    m_needs_net_reduce = true;
+    }
+
 void mpcd::CellThermoCompute::computeNetProperties()
     {
     if (m_prof) m_prof->push("MPCD thermo");
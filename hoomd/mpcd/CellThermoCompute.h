@@ -26,12 +26,38 @@
 #include "hoomd/extern/nano-signal-slot/nano_signal_slot.hpp"
 #include "hoomd/extern/pybind/include/pybind11/pybind11.h"
 
+#include <functional>
+
 namespace mpcd
 {
+namespace detail
+{
+//! Members of one cell, handed to the cell operation of CellThermoCompute::computeFused()
+struct CellMembers
+    {
+    const unsigned int *members;    //!< Particle indexes of the cell members
+    unsigned int np;                //!< Number of members
+    Scalar4 *vel;                   //!< MPCD particle velocities
+    Scalar4 *embed_vel;             //!< Embedded particle velocities
+    const unsigned int *embed_idx;  //!< Embedded particle indexes
+    unsigned int N_mpcd;            //!< Number of MPCD particles
+    };
+} // end namespace detail
+
 //! Computes the cell (thermodynamic) properties
 class PYBIND11_EXPORT CellThermoCompute : public Compute
     {
     public:
+        //! Operation applied to a cell once its properties are known
+        /*!
+         * The arguments are the cell index, the cell members, the cell velocity and mass,
+         * and the cell energy (only if requested by the flags).
+         */
+        typedef std::function<void (unsigned int,
+                                    const mpcd::detail::CellMembers&,
+                                    const double4&,
+                                    const double3&)> CellOp;
+
         //! Constructor
         CellThermoCompute(std::shared_ptr<mpcd::SystemData> sysdata,
                           const std::string& suffix = std::string(""));
@@ -42,6 +68,12 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
         //! Compute the cell thermodynamic properties
         void compute(unsigned int timestep);
 
+        //! Check if the cell properties can be computed with computeFused()
+        bool canComputeFused(unsigned int timestep);
+
+        //! Compute the cell properties and apply an operation to each cell in the same sweep
+        void computeFused(unsigned int timestep, const CellOp& op);
+
         //! Get the cell indexer for the attached cell list
         const Index3D& getCellIndexer() const
             {
@@ -12,6 +12,46 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
+namespace mpcd
+{
+namespace detail
+{
+//! Rotates a velocity relative to the cell average velocity
+/*!
+ * \param vel Velocity relative to the cell average velocity
+ * \param rot_vec Rotation vector of the cell
+ * \param cos_a Cosine of the rotation angle
+ * \param one_minus_cos_a One minus the cosine of the rotation angle
+ * \param sin_a Sine of the rotation angle
+ * \returns The rotated velocity
+ */
+inline double3 srd_rotate(const double3& vel,
+                          const double3& rot_vec,
+                          const double cos_a,
+                          const double one_minus_cos_a,
+                          const double sin_a)
+    {
+    // perform the rotation in double precision
+    // TODO: should we optimize out the matrix construction for the CPU?
+    //       Or, consider using vectorization and/or Eigen?
+    double3 new_vel;
+    new_vel.x = (cos_a + rot_vec.x*rot_vec.x*one_minus_cos_a) * vel.x;
+    new_vel.x += (rot_vec.x*rot_vec.y*one_minus_cos_a - sin_a*rot_vec.z) * vel.y;
+    new_vel.x += (rot_vec.x*rot_vec.z*one_minus_cos_a + sin_a*rot_vec.y) * vel.z;
+
+    new_vel.y = (cos_a + rot_vec.y*rot_vec.y*one_minus_cos_a) * vel.y;
+    new_vel.y += (rot_vec.x*rot_vec.y*one_minus_cos_a + sin_a*rot_vec.z) * vel.x;
+    new_vel.y += (rot_vec.y*rot_vec.z*one_minus_cos_a - sin_a*rot_vec.x) * vel.z;
+
+    new_vel.z = (cos_a + rot_vec.z*rot_vec.z*one_minus_cos_a) * vel.z;
+    new_vel.z += (rot_vec.x*rot_vec.z*one_minus_cos_a - sin_a*rot_vec.y) * vel.x;
+    new_vel.z += (rot_vec.y*rot_vec.z*one_minus_cos_a + sin_a*rot_vec.x) * vel.y;
+
+    return new_vel;
+    }
+} // end namespace detail
+} // end namespace mpcd
+
 mpcd::SRDCollisionMethod::SRDCollisionMethod(std::shared_ptr<mpcd::SystemData> sysdata,
                                              unsigned int cur_timestep,
                                              unsigned int period,
@@ -36,6 +76,12 @@ mpcd::SRDCollisionMethod::~SRDCollisionMethod()
 
 void mpcd::SRDCollisionMethod::rule(unsigned int timestep)
     {
+    if (useFusedRule(timestep))
+        {
+        ruleFused(timestep);
+        return;
+        }
+
     m_thermo->compute(timestep);
 
     if (m_prof) m_prof->push(m_exec_conf, "MPCD collide");
@@ -54,6 +100,148 @@ void mpcd::SRDCollisionMethod::rule(unsigned int timestep)
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * \param timestep Current timestep
+ * \returns True if the cell properties and the collision can be computed in one sweep over the cells
+ */
+bool mpcd::SRDCollisionMethod::useFusedRule(unsigned int timestep)
+    {
+    return m_thermo->canComputeFused(timestep);
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The cell properties are computed by the thermo, and the rotation vector is drawn and applied to the members
+ * of each cell right after its average velocity is known. The velocities are only streamed once, instead of
+ * once for the thermo and once for the rotation. The random numbers are the same as in drawRotationVectors(),
+ * so both paths give the same result.
+ */
+void mpcd::SRDCollisionMethod::ruleFused(unsigned int timestep)
+    {
+    // the cell list must be up to date before the rotation vectors are sized
+    m_cl->compute(timestep);
+
+    if (m_prof) m_prof->push(m_exec_conf, "MPCD collide");
+    // resize the rotation vectors and rescale factors
+    m_rotvec.resize(m_cl->getNCells());
+    if (m_T)
+        {
+        m_factors.resize(m_cl->getNCells());
+        }
+
+    const Index3D& ci = m_cl->getCellIndexer();
+    const Index3D& global_ci = m_cl->getGlobalCellIndexer();
+    ArrayHandle<double3> h_rotvec(m_rotvec, access_location::host, access_mode::overwrite);
+
+    std::unique_ptr< ArrayHandle<double> > h_factors;
+    double T_set(1.0);
+    const bool use_thermostat = (m_T) ? true : false;
+    if (use_thermostat)
+        {
+        h_factors.reset(new ArrayHandle<double>(m_factors, access_location::host, access_mode::overwrite));
+        T_set = m_T->getValue(timestep);
+        }
+
+    const double cos_a = slow::cos(m_angle);
+    const double one_minus_cos_a = 1.0 - cos_a;
+    const double sin_a = slow::sin(m_angle);
+
+    auto collide_cell = [&](unsigned int cell,
+                            const mpcd::detail::CellMembers& members,
+                            const double4& avg_vel,
+                            const double3& cell_energy)
+        {
+        const unsigned int i = cell % ci.getW();
+        const unsigned int j = (cell / ci.getW()) % ci.getH();
+        const unsigned int k = cell / (ci.getW()*ci.getH());
+        const int3 global_cell = m_cl->getGlobalCell(make_int3(i,j,k));
+        const unsigned int global_idx = global_ci(global_cell.x, global_cell.y, global_cell.z);
+
+        double3 rot_vec; double factor(1.0);
+        drawCellRotation(timestep, global_idx, cell_energy, use_thermostat, T_set, rot_vec, factor);
+        h_rotvec.data[cell] = rot_vec;
+        if (use_thermostat)
+            h_factors->data[cell] = factor;
+
+        for (unsigned int offset = 0; offset < members.np; ++offset)
+            {
+            const unsigned int cur_p = members.members[offset];
+            Scalar4 *vel_ptr = (cur_p < members.N_mpcd) ?
+                               &members.vel[cur_p] :
+                               &members.embed_vel[members.embed_idx[cur_p - members.N_mpcd]];
+            const Scalar4 orig_vel = *vel_ptr;
+
+            // subtract average velocity
+            double3 vel = make_double3(orig_vel.x - avg_vel.x, orig_vel.y - avg_vel.y, orig_vel.z - avg_vel.z);
+
+            double3 new_vel = mpcd::detail::srd_rotate(vel, rot_vec, cos_a, one_minus_cos_a, sin_a);
+
+            // rescale the temperature if thermostatting is enabled
+            if (use_thermostat)
+                {
+                new_vel.x *= factor; new_vel.y *= factor; new_vel.z *= factor;
+                }
+
+            new_vel.x += avg_vel.x;
+            new_vel.y += avg_vel.y;
+            new_vel.z += avg_vel.z;
+
+            // the fourth component (cell or mass) is unchanged
+            *vel_ptr = make_scalar4(new_vel.x, new_vel.y, new_vel.z, orig_vel.w);
+            }
+        };
+
+    m_thermo->computeFused(timestep, collide_cell);
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+/*!
+ * \param timestep Current timestep
+ * \param global_idx Global index of the cell
+ * \param cell_energy Energy, temperature, and number of particles of the cell
+ * \param use_thermostat If true, the rescale factor is drawn
+ * \param T_set Temperature of the thermostat
+ * \param rotvec Rotation vector (output)
+ * \param factor Rescale factor (output, only set if \a use_thermostat is true)
+ */
+void mpcd::SRDCollisionMethod::drawCellRotation(unsigned int timestep,
+                                                unsigned int global_idx,
+                                                const double3& cell_energy,
+                                                bool use_thermostat,
+                                                double T_set,
+                                                double3& rotvec,
+                                                double& factor) const
+    {
+    // Initialize the PRNG using the current cell index, timestep, and seed for the hash
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::SRDCollisionMethod, m_seed, global_idx, timestep);
+
+    // draw rotation vector off the surface of the sphere
+    hoomd::SpherePointGenerator<double> sphgen;
+    sphgen(rng, rotvec);
+
+    if (use_thermostat)
+        {
+        const unsigned int np = __double_as_int(cell_energy.z);
+        factor = 1.0;
+        if (np > 1)
+            {
+            // the total number of degrees of freedom in the cell divided by 2
+            const double alpha = m_sysdef->getNDimensions()*(np-1)/(double)2.;
+
+            // draw a random kinetic energy for the cell at the set temperature
+            hoomd::GammaDistribution<double> gamma_gen(alpha,T_set);
+            const double rand_ke = gamma_gen(rng);
+
+            // generate the scale factor from the current temperature
+            // (don't use the kinetic energy of this cell, since this
+            // is total not relative to COM)
+            const double cur_ke = alpha * cell_energy.y;
+            factor = (cur_ke > 0.) ? fast::sqrt(rand_ke/cur_ke) : 1.;
+            }
+        }
+    }
+
 void mpcd::SRDCollisionMethod::drawRotationVectors(unsigned int timestep)
     {
     // cell indexers and rotation vectors
@@ -83,37 +271,12 @@ void mpcd::SRDCollisionMethod::drawRotationVectors(unsigned int timestep)
                 const unsigned int global_idx = global_ci(global_cell.x, global_cell.y, global_cell.z);
                 const unsigned int idx = ci(i,j,k);
 
-                // Initialize the PRNG using the current cell index, timestep, and seed for the hash
-                hoomd::RandomGenerator rng(hoomd::RNGIdentifier::SRDCollisionMethod, m_seed, global_idx, timestep);
-
-                // draw rotation vector off the surface of the sphere
-                double3 rotvec;
-                hoomd::SpherePointGenerator<double> sphgen;
-                sphgen(rng, rotvec);
+                const double3 cell_energy = (use_thermostat) ? h_cell_energy->data[idx] : make_double3(0.0, 0.0, 0.0);
+                double3 rotvec; double factor(1.0);
+                drawCellRotation(timestep, global_idx, cell_energy, use_thermostat, T_set, rotvec, factor);
                 h_rotvec.data[idx] = rotvec;
-
                 if (use_thermostat)
-                    {
-                    const double3 cell_energy = h_cell_energy->data[idx];
-                    const unsigned int np = __double_as_int(cell_energy.z);
-                    double factor = 1.0;
-                    if (np > 1)
-                        {
-                        // the total number of degrees of freedom in the cell divided by 2
-                        const double alpha = m_sysdef->getNDimensions()*(np-1)/(double)2.;
-
-                        // draw a random kinetic energy for the cell at the set temperature
-                        hoomd::GammaDistribution<double> gamma_gen(alpha,T_set);
-                        const double rand_ke = gamma_gen(rng);
-
-                        // generate the scale factor from the current temperature
-                        // (don't use the kinetic energy of this cell, since this
-                        // is total not relative to COM)
-                        const double cur_ke = alpha * cell_energy.y;
-                        factor = (cur_ke > 0.) ? fast::sqrt(rand_ke/cur_ke) : 1.;
-                        }
                     h_factors->data[idx] = factor;
-                    }
                 }
             }
         }
@@ -185,21 +348,7 @@ void mpcd::SRDCollisionMethod::rotate(unsigned int timestep)
         // get rotation vector
         double3 rot_vec = h_rotvec.data[cell];
 
-        // perform the rotation in double precision
-        // TODO: should we optimize out the matrix construction for the CPU?
-        //       Or, consider using vectorization and/or Eigen?
-        double3 new_vel;
-        new_vel.x = (cos_a + rot_vec.x*rot_vec.x*one_minus_cos_a) * vel.x;
-        new_vel.x += (rot_vec.x*rot_vec.y*one_minus_cos_a - sin_a*rot_vec.z) * vel.y;
-        new_vel.x += (rot_vec.x*rot_vec.z*one_minus_cos_a + sin_a*rot_vec.y) * vel.z;
-
-        new_vel.y = (cos_a + rot_vec.y*rot_vec.y*one_minus_cos_a) * vel.y;
-        new_vel.y += (rot_vec.x*rot_vec.y*one_minus_cos_a + sin_a*rot_vec.z) * vel.x;
-        new_vel.y += (rot_vec.y*rot_vec.z*one_minus_cos_a - sin_a*rot_vec.x) * vel.z;
-
-        new_vel.z = (cos_a + rot_vec.z*rot_vec.z*one_minus_cos_a) * vel.z;
-        new_vel.z += (rot_vec.x*rot_vec.z*one_minus_cos_a - sin_a*rot_vec.y) * vel.x;
-        new_vel.z += (rot_vec.y*rot_vec.z*one_minus_cos_a + sin_a*rot_vec.x) * vel.y;
+        double3 new_vel = mpcd::detail::srd_rotate(vel, rot_vec, cos_a, one_minus_cos_a, sin_a);
 
         // rescale the temperature if thermostatting is enabled
         if (use_thermostat)
@@ -102,6 +102,21 @@ class PYBIND11_EXPORT SRDCollisionMethod : public mpcd::CollisionMethod
 
         //! Apply rotation matrix to velocities
         virtual void rotate(unsigned int timestep);
+
+        //! Compute the cell properties and apply the collision rule in one sweep
+        void ruleFused(unsigned int timestep);
+
+        //! Check if the cell properties and the rotation can be computed in one sweep
+        virtual bool useFusedRule(unsigned int timestep);
+
+        //! Draw the rotation vector and the rescale factor of a single cell
+        void drawCellRotation(unsigned int timestep,
+                              unsigned int global_idx,
+                              const double3& cell_energy,
+                              bool use_thermostat,
+                              double T_set,
+                              double3& rotvec,
+                              double& factor) const;
     };
 
 namespace detail
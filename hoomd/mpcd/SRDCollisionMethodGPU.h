@@ -52,6 +52,12 @@ class PYBIND11_EXPORT SRDCollisionMethodGPU : public mpcd::SRDCollisionMethod
         //! Apply rotation matrix to velocities
         virtual void rotate(unsigned int timestep);
 
+        //! The fused sweep is only implemented on the CPU
+        virtual bool useFusedRule(unsigned int timestep)
+            {
+            return false;
+            }
+
     private:
         std::unique_ptr<Autotuner> m_tuner_rotvec;  //!< Tuner for drawing rotation vectors
         std::unique_ptr<Autotuner> m_tuner_rotate;  //!< Tuner for rotating velocities
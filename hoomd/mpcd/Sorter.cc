@@ -76,28 +76,25 @@ void mpcd::Sorter::computeOrder(unsigned int timestep)
     m_cl->compute(timestep);
     if (m_prof) m_prof->push(m_exec_conf,"MPCD sort");
 
-    ArrayHandle<unsigned int> h_cell_list(m_cl->getCellList(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
-    const Index2D& cli = m_cl->getCellListIndexer();
+    ArrayHandle<unsigned int> h_cell_members(m_cl->getCellMembers(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(), access_location::host, access_mode::read);
 
-    // loop through the cell list to generate the sorting order for MPCD particles
+    // the compressed cell list already holds the particles in cell order, so the sorting order
+    // for MPCD particles is the cell list with all other particles removed
     ArrayHandle<unsigned int> h_order(m_order, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_rorder(m_rorder, access_location::host, access_mode::overwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN();
+    const unsigned int n_members = h_cell_offsets.data[m_cl->getNCells()];
     unsigned int cur_p = 0;
-    for (unsigned int idx=0; idx < m_cl->getNCells(); ++idx)
+    for (unsigned int i=0; i < n_members; ++i)
         {
-        const unsigned int np = h_cell_np.data[idx];
-        for (unsigned int offset = 0; offset < np; ++offset)
+        const unsigned int pid = h_cell_members.data[i];
+        // only count MPCD particles, and skip embedded particles
+        if (pid < N_mpcd)
             {
-            const unsigned int pid = h_cell_list.data[cli(offset, idx)];
-            // only count MPCD particles, and skip embedded particles
-            if (pid < N_mpcd)
-                {
-                h_order.data[cur_p] = pid;
-                h_rorder.data[pid] = cur_p;
-                ++cur_p;
-                }
+            h_order.data[cur_p] = pid;
+            h_rorder.data[pid] = cur_p;
+            ++cur_p;
             }
         }
     }
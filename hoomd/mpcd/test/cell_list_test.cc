@@ -592,6 +592,109 @@ void celllist_embed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
         }
     }
 
+//! Test the compressed layout of the CPU cell list
+void celllist_compressed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(2.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // place particles in four of the eight cells, with two particles in some of them
+    auto mpcd_snap = std::make_shared<mpcd::ParticleDataSnapshot>(6);
+    mpcd_snap->position[0] = vec3<Scalar>( 0.5,  0.5,  0.5);
+    mpcd_snap->position[1] = vec3<Scalar>(-0.5, -0.5, -0.5);
+    mpcd_snap->position[2] = vec3<Scalar>( 0.5, -0.5, -0.5);
+    mpcd_snap->position[3] = vec3<Scalar>(-0.5, -0.5, -0.5);
+    mpcd_snap->position[4] = vec3<Scalar>( 0.5,  0.5,  0.5);
+    mpcd_snap->position[5] = vec3<Scalar>(-0.5, -0.5,  0.5);
+    auto pdata = std::make_shared<mpcd::ParticleData>(mpcd_snap, snap->global_box, exec_conf);
+
+    std::shared_ptr<mpcd::CellList> cl(new mpcd::CellList(sysdef, pdata));
+    cl->compute(0);
+
+        {
+        ArrayHandle<unsigned int> h_cell_offsets(cl->getCellOffsets(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cell_members(cl->getCellMembers(), access_location::host, access_mode::read);
+        Index3D ci = cl->getCellIndexer();
+
+        // the offsets are the exclusive scan of the cell sizes
+        CHECK_EQUAL_UINT( h_cell_offsets.data[ci(0,0,0)], 0 );
+        CHECK_EQUAL_UINT( h_cell_offsets.data[ci(1,0,0)], 2 );
+        CHECK_EQUAL_UINT( h_cell_offsets.data[ci(0,1,0)], 3 );
+        CHECK_EQUAL_UINT( h_cell_offsets.data[ci(1,1,0)], 3 );
+        CHECK_EQUAL_UINT( h_cell_offsets.data[ci(0,0,1)], 3 );
+        CHECK_EQUAL_UINT( h_cell_offsets.data[ci(1,1,1)], 4 );
+        CHECK_EQUAL_UINT( h_cell_offsets.data[cl->getNCells()], 6 );
+
+        // the members of every cell are stored in order of their index
+        CHECK_EQUAL_UINT( h_cell_members.data[0], 1 );
+        CHECK_EQUAL_UINT( h_cell_members.data[1], 3 );
+        CHECK_EQUAL_UINT( h_cell_members.data[2], 2 );
+        CHECK_EQUAL_UINT( h_cell_members.data[3], 5 );
+        CHECK_EQUAL_UINT( h_cell_members.data[4], 0 );
+        CHECK_EQUAL_UINT( h_cell_members.data[5], 4 );
+        }
+
+    // the padded layout is filled from the compressed one on request
+    CHECK_EQUAL_UINT( cl->getNmax(), 4 );
+        {
+        ArrayHandle<unsigned int> h_cell_list(cl->getCellList(), access_location::host, access_mode::read);
+        Index3D ci = cl->getCellIndexer();
+        Index2D cli = cl->getCellListIndexer();
+        CHECK_EQUAL_UINT( h_cell_list.data[cli(0, ci(0,0,0))], 1 );
+        CHECK_EQUAL_UINT( h_cell_list.data[cli(1, ci(0,0,0))], 3 );
+        CHECK_EQUAL_UINT( h_cell_list.data[cli(0, ci(1,1,1))], 0 );
+        CHECK_EQUAL_UINT( h_cell_list.data[cli(1, ci(1,1,1))], 4 );
+        }
+
+    #ifdef ENABLE_TBB
+    // a large system built with several threads reproduces the serial build, including the order within each cell
+    const unsigned int N = 20000;
+    auto large_snap = std::make_shared<mpcd::ParticleDataSnapshot>(N);
+    for (unsigned int i=0; i < N; ++i)
+        {
+        large_snap->position[i] = vec3<Scalar>(std::fmod(Scalar(0.7319)*i, Scalar(2.0)) - Scalar(1.0),
+                                               std::fmod(Scalar(0.3571)*i, Scalar(2.0)) - Scalar(1.0),
+                                               std::fmod(Scalar(0.1129)*i, Scalar(2.0)) - Scalar(1.0));
+        }
+    auto large_pdata = std::make_shared<mpcd::ParticleData>(large_snap, snap->global_box, exec_conf);
+    std::shared_ptr<mpcd::CellList> cl_serial(new mpcd::CellList(sysdef, large_pdata));
+    cl_serial->setCellSize(0.25);
+    exec_conf->setNumThreads(1);
+    cl_serial->compute(0);
+
+    std::vector<unsigned int> serial_offsets, serial_members;
+        {
+        ArrayHandle<unsigned int> h_cell_offsets(cl_serial->getCellOffsets(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cell_members(cl_serial->getCellMembers(), access_location::host, access_mode::read);
+        serial_offsets.assign(h_cell_offsets.data, h_cell_offsets.data + cl_serial->getNCells() + 1);
+        serial_members.assign(h_cell_members.data, h_cell_members.data + N);
+        }
+    CHECK_EQUAL_UINT( serial_offsets.back(), N );
+
+    std::shared_ptr<mpcd::CellList> cl_threaded(new mpcd::CellList(sysdef, large_pdata));
+    cl_threaded->setCellSize(0.25);
+    exec_conf->setNumThreads(4);
+    cl_threaded->compute(0);
+
+    UP_ASSERT_EQUAL(cl_serial->getNmax(), cl_threaded->getNmax());
+        {
+        ArrayHandle<unsigned int> h_cell_offsets(cl_threaded->getCellOffsets(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cell_members(cl_threaded->getCellMembers(), access_location::host, access_mode::read);
+        for (unsigned int i=0; i <= cl_threaded->getNCells(); ++i)
+            {
+            CHECK_EQUAL_UINT( h_cell_offsets.data[i], serial_offsets[i] );
+            }
+        for (unsigned int i=0; i < N; ++i)
+            {
+            CHECK_EQUAL_UINT( h_cell_members.data[i], serial_members[i] );
+            }
+        }
+    exec_conf->setNumThreads(1);
+    #endif // ENABLE_TBB
+    }
+
 //! dimension test case for MPCD CellList class
 UP_TEST( mpcd_cell_list_dimensions )
     {
@@ -616,6 +719,12 @@ UP_TEST( mpcd_cell_list_embed_test )
     celllist_embed_test<mpcd::CellList>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! compressed layout test case for MPCD CellList class
+UP_TEST( mpcd_cell_list_compressed_test )
+    {
+    celllist_compressed_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! dimension test case for MPCD CellListGPU class
 UP_TEST( mpcd_cell_list_gpu_dimensions )
@@ -367,6 +367,81 @@ void srd_collision_method_thermostat_test(std::shared_ptr<ExecutionConfiguration
         }
     }
 
+//! SRD collision method that always computes the cell properties and the rotation in separate sweeps
+class SRDCollisionMethodUnfused : public mpcd::SRDCollisionMethod
+    {
+    public:
+        SRDCollisionMethodUnfused(std::shared_ptr<mpcd::SystemData> sysdata,
+                                  unsigned int cur_timestep,
+                                  unsigned int period,
+                                  int phase,
+                                  unsigned int seed,
+                                  std::shared_ptr<mpcd::CellThermoCompute> thermo)
+            : mpcd::SRDCollisionMethod(sysdata, cur_timestep, period, phase, seed, thermo)
+            { }
+
+    protected:
+        virtual bool useFusedRule(unsigned int timestep)
+            {
+            return false;
+            }
+    };
+
+//! Test that the fused sweep on the CPU gives the same velocities as the separate sweeps
+void srd_collision_method_fused_test(std::shared_ptr<ExecutionConfiguration> exec_conf, unsigned int num_threads)
+    {
+    const BoxDim box(10.0);
+    auto sysdef = std::make_shared<::SystemDefinition>(0, box, 1, 0, 0, 0, 0, exec_conf);
+
+    // two copies of the same random system
+    auto pdata_ref = std::make_shared<mpcd::ParticleData>(10000, box, 1.0, 42, 3, exec_conf);
+    auto mpcd_sys_ref = std::make_shared<mpcd::SystemData>(sysdef, pdata_ref);
+    auto thermo_ref = std::make_shared<mpcd::CellThermoCompute>(mpcd_sys_ref);
+    auto collide_ref = std::make_shared<SRDCollisionMethodUnfused>(mpcd_sys_ref, 0, 1, -1, 827, thermo_ref);
+
+    auto pdata = std::make_shared<mpcd::ParticleData>(10000, box, 1.0, 42, 3, exec_conf);
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(sysdef, pdata);
+    auto thermo = std::make_shared<mpcd::CellThermoCompute>(mpcd_sys);
+    auto collide = std::make_shared<mpcd::SRDCollisionMethod>(mpcd_sys, 0, 1, -1, 827, thermo);
+
+    std::shared_ptr<::Variant> T = std::make_shared<::VariantConst>(1.5);
+    collide_ref->setRotationAngle(2.2689280275926285);
+    collide_ref->setTemperature(T);
+    collide->setRotationAngle(2.2689280275926285);
+    collide->setTemperature(T);
+
+    exec_conf->setNumThreads(num_threads);
+    for (unsigned int timestep = 0; timestep < 5; ++timestep)
+        {
+        collide_ref->collide(timestep);
+        collide->collide(timestep);
+
+        ArrayHandle<Scalar4> h_vel_ref(pdata_ref->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i=0; i < pdata->getN(); ++i)
+            {
+            CHECK_CLOSE(h_vel.data[i].x, h_vel_ref.data[i].x, tol_small);
+            CHECK_CLOSE(h_vel.data[i].y, h_vel_ref.data[i].y, tol_small);
+            CHECK_CLOSE(h_vel.data[i].z, h_vel_ref.data[i].z, tol_small);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_vel.data[i].w), __scalar_as_int(h_vel_ref.data[i].w));
+            }
+
+        // the cell properties before the collision are stored in both cases
+        ArrayHandle<double4> h_cell_vel_ref(thermo_ref->getCellVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<double4> h_cell_vel(thermo->getCellVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<double> h_factors_ref(collide_ref->getScaleFactors(), access_location::host, access_mode::read);
+        ArrayHandle<double> h_factors(collide->getScaleFactors(), access_location::host, access_mode::read);
+        const unsigned int ncells = mpcd_sys->getCellList()->getNCells();
+        for (unsigned int i=0; i < ncells; ++i)
+            {
+            CHECK_CLOSE(h_cell_vel.data[i].x, h_cell_vel_ref.data[i].x, tol_small);
+            CHECK_CLOSE(h_cell_vel.data[i].w, h_cell_vel_ref.data[i].w, tol_small);
+            CHECK_CLOSE(h_factors.data[i], h_factors_ref.data[i], tol_small);
+            }
+        }
+    exec_conf->setNumThreads(1);
+    }
+
 //! basic test case for MPCD SRDCollisionMethod class
 UP_TEST( srd_collision_method_basic )
     {
@@ -386,6 +461,14 @@ UP_TEST( srd_collision_method_thermostat )
     {
     srd_collision_method_thermostat_test<mpcd::SRDCollisionMethod>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+//! test the fused cell property and rotation sweep of the MPCD SRDCollisionMethod class
+UP_TEST( srd_collision_method_fused )
+    {
+    srd_collision_method_fused_test(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU), 1);
+    #ifdef ENABLE_TBB
+    srd_collision_method_fused_test(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU), 4);
+    #endif // ENABLE_TBB
+    }
 #ifdef ENABLE_CUDA
 //! basic test case for MPCD SRDCollisionMethodGPU class
 UP_TEST( srd_collision_method_basic_gpu )
@@ -132,6 +132,47 @@ class gsd_write_tests (unittest.TestCase):
         if comm.get_rank() == 0:
             self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=1);
 
+    # tests writing frames on the background thread
+    def test_queue_depth(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, queue_depth=2);
+        run(5);
+        # all queued frames are written at the end of the run
+        data.gsd_snapshot(self.tmp_file, frame=4);
+        if comm.get_rank() == 0:
+            self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=5);
+
+        run(5);
+        data.gsd_snapshot(self.tmp_file, frame=9);
+        if comm.get_rank() == 0:
+            self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=10);
+
+    # tests truncate and write_restart with the background thread
+    def test_queue_depth_truncate(self):
+        g = dump.gsd(filename=self.tmp_file, group=group.all(), period=1, truncate=True, overwrite=True, queue_depth=1);
+        run(5);
+        g.write_restart();
+        data.gsd_snapshot(self.tmp_file, frame=0);
+        if comm.get_rank() == 0:
+            self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=1);
+
+    # tests writing particle data from several ranks
+    def test_mpi_writers(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, dynamic=['attribute', 'momentum'], mpi_writers=2);
+        run(2);
+        ref = self.s.take_snapshot();
+        snap = data.gsd_snapshot(self.tmp_file, frame=1);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, ref.particles.N);
+            numpy.testing.assert_array_almost_equal(snap.particles.position, ref.particles.position);
+            numpy.testing.assert_array_almost_equal(snap.particles.velocity, ref.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+            numpy.testing.assert_array_equal(snap.particles.typeid, ref.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, ref.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, ref.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, ref.particles.diameter);
+            self.assertEqual(snap.particles.types, ref.particles.types);
+            self.assertEqual(snap.bonds.N, ref.bonds.N);
+
     # test all static quantities
     def test_all_static(self):
         dump.gsd(filename=self.tmp_file, group=group.all(), period=1, static=['attribute', 'property', 'momentum', 'topology'], overwrite=True);
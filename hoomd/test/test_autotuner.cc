@@ -0,0 +1,147 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/ClockSource.h"
+
+using namespace std;
+
+/*! \file test_autotuner.cc
+    \brief Unit tests for the host clock timing in Autotuner
+    \ingroup unit_tests
+*/
+
+#include "upp11_config.h"
+HOOMD_UP_MAIN();
+
+//! Autotuner that records given kernel times instead of the measured host time
+/*! The selection logic is tested with known timings, so the tests do not depend on the scheduling of the host.
+*/
+class FixedTimingAutotuner : public Autotuner
+    {
+    public:
+        //! Constructor
+        FixedTimingAutotuner(const std::vector<unsigned int>& parameters,
+                             unsigned int nsamples,
+                             unsigned int period,
+                             const std::string& name,
+                             std::shared_ptr<const ExecutionConfiguration> exec_conf)
+            : Autotuner(parameters, nsamples, period, name, exec_conf)
+            { }
+
+        //! Constructor with implicit range
+        FixedTimingAutotuner(unsigned int start,
+                             unsigned int end,
+                             unsigned int step,
+                             unsigned int nsamples,
+                             unsigned int period,
+                             const std::string& name,
+                             std::shared_ptr<const ExecutionConfiguration> exec_conf)
+            : Autotuner(start, end, step, nsamples, period, name, exec_conf)
+            { }
+
+        //! Record a kernel launch that took \a t milliseconds
+        void run(float t)
+            {
+            begin();
+            // shift the start time so that end() measures t (plus the negligible time between the two calls)
+            m_start_time = m_clk.getTime() - int64_t(double(t)*1e6);
+            end();
+            }
+    };
+
+//! Run one tuned "kernel" that is fastest for the parameter 2
+static void run_fixed(FixedTimingAutotuner& tuner)
+    {
+    tuner.run(tuner.getParam() == 2 ? 1.0f : 100.0f);
+    }
+
+//! Check that an Autotuner on the CPU scans all parameters and chooses the fastest one
+UP_TEST( autotuner_host_timing )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    std::vector<unsigned int> params;
+    params.push_back(1);
+    params.push_back(2);
+    params.push_back(3);
+
+    FixedTimingAutotuner tuner(params, 3, 10, "test", exec_conf);
+    UP_ASSERT(tuner.isHostTiming());
+    UP_ASSERT_EQUAL(tuner.getName(), std::string("test"));
+
+    // the initial scan takes nsamples calls for every parameter
+    for (unsigned int i = 0; i < 3*3; i++)
+        {
+        UP_ASSERT(!tuner.isComplete());
+        run_fixed(tuner);
+        }
+
+    UP_ASSERT(tuner.isComplete());
+    UP_ASSERT_EQUAL(tuner.getParam(), (unsigned int)2);
+
+    // the optimal parameter is kept while idle and after a rescan
+    for (unsigned int i = 0; i < 20; i++)
+        run_fixed(tuner);
+
+    UP_ASSERT_EQUAL(tuner.getParam(), (unsigned int)2);
+    }
+
+//! Check that a disabled Autotuner keeps returning the chosen parameter
+UP_TEST( autotuner_host_disable )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    FixedTimingAutotuner tuner(1, 3, 1, 3, 100, "test_disable", exec_conf);
+
+    for (unsigned int i = 0; i < 3*3; i++)
+        run_fixed(tuner);
+
+    UP_ASSERT(tuner.isComplete());
+    tuner.setEnabled(false);
+    UP_ASSERT_EQUAL(tuner.getParam(), (unsigned int)2);
+
+    for (unsigned int i = 0; i < 200; i++)
+        run_fixed(tuner);
+
+    UP_ASSERT_EQUAL(tuner.getParam(), (unsigned int)2);
+    }
+
+//! Check the sampling modes with known outliers
+UP_TEST( autotuner_host_modes )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    std::vector<unsigned int> params;
+    params.push_back(1);
+    params.push_back(2);
+
+    // parameter 1 is usually fast with one slow outlier, parameter 2 is always moderately fast
+    float times[2][3] = {{1.0f, 1.0f, 300.0f}, {50.0f, 50.0f, 50.0f}};
+
+    // the median ignores the outlier, the average and the maximum do not
+    Autotuner::mode_Enum modes[3] = {Autotuner::mode_median, Autotuner::mode_avg, Autotuner::mode_max};
+    unsigned int expected[3] = {1, 2, 2};
+
+    for (unsigned int m = 0; m < 3; m++)
+        {
+        FixedTimingAutotuner tuner(params, 3, 10, "test_modes", exec_conf);
+        tuner.setMode(modes[m]);
+
+        for (unsigned int i = 0; i < 2; i++)
+            for (unsigned int j = 0; j < 3; j++)
+                {
+                UP_ASSERT_EQUAL(tuner.getParam(), params[i]);
+                tuner.run(times[i][j]);
+                }
+
+        UP_ASSERT(tuner.isComplete());
+        UP_ASSERT_EQUAL(tuner.getParam(), expected[m]);
+        }
+    }
@@ -582,3 +582,57 @@ UP_TEST( CellListGPU_large )
     celllist_large_test<CellListGPU>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+#ifdef ENABLE_TBB
+//! Validate that the threaded cell list build reproduces the serial one, including the order within each cell
+void celllist_threaded_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    unsigned int N = 10000;
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap;
+    snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // build the reference cell list serially
+    exec_conf->setNumThreads(1);
+    std::shared_ptr<CellList> cl_serial(new CellList(sysdef));
+    cl_serial->setNominalWidth(Scalar(3.0));
+    cl_serial->setRadius(1);
+    cl_serial->setFlagIndex();
+    cl_serial->compute(0);
+
+    // build a second cell list with several threads, its initial Nmax is the average occupancy so the first build
+    // also exercises the overflow handling
+    exec_conf->setNumThreads(4);
+    std::shared_ptr<CellList> cl_threaded(new CellList(sysdef));
+    cl_threaded->setNominalWidth(Scalar(3.0));
+    cl_threaded->setRadius(1);
+    cl_threaded->setFlagIndex();
+    cl_threaded->compute(0);
+
+    UP_ASSERT_EQUAL(cl_serial->getNmax(), cl_threaded->getNmax());
+
+    ArrayHandle<unsigned int> h_cell_size_serial(cl_serial->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf_serial(cl_serial->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(cl_threaded->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(cl_threaded->getXYZFArray(), access_location::host, access_mode::read);
+
+    Index2D cli = cl_serial->getCellListIndexer();
+    unsigned int ncell = cl_serial->getCellIndexer().getNumElements();
+    for (unsigned int cell = 0; cell < ncell; cell++)
+        {
+        CHECK_EQUAL_UINT(h_cell_size.data[cell], h_cell_size_serial.data[cell]);
+        for (unsigned int offset = 0; offset < h_cell_size.data[cell]; offset++)
+            {
+            CHECK_EQUAL_UINT(__scalar_as_int(h_xyzf.data[cli(offset, cell)].w),
+                             __scalar_as_int(h_xyzf_serial.data[cli(offset, cell)].w));
+            }
+        }
+    }
+
+//! test case for celllist_threaded_test
+UP_TEST( CellList_threaded )
+    {
+    celllist_threaded_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
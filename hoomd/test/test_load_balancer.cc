@@ -359,6 +359,100 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,0,1));
     }
 
+//! Reports a fixed compute time per step for the load balancer
+struct ComputeTimeSource
+    {
+    ComputeTimeSource(double time_per_step) : m_time_per_step(time_per_step), m_steps(0) {}
+
+    //! Return the accumulated compute time and advance by one step
+    double getComputeTime()
+        {
+        return m_time_per_step * double(m_steps++);
+        }
+
+    double m_time_per_step;
+    unsigned int m_steps;
+    };
+
+template<class LB>
+void test_load_balancer_time(std::shared_ptr<ExecutionConfiguration> exec_conf, const BoxDim& dest_box)
+{
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // create a system with eight particles
+    BoxDim ref_box = BoxDim(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,           // number of particles
+                                                             dest_box,        // box dimensions
+                                                             1,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // one particle in the center of every domain
+    pdata->setPosition(0, TO_TRICLINIC(make_scalar3(0.5,0.5,0.5)),false);
+    pdata->setPosition(1, TO_TRICLINIC(make_scalar3(0.5,0.5,-0.5)),false);
+    pdata->setPosition(2, TO_TRICLINIC(make_scalar3(0.5,-0.5,0.5)),false);
+    pdata->setPosition(3, TO_TRICLINIC(make_scalar3(0.5,-0.5,-0.5)),false);
+    pdata->setPosition(4, TO_TRICLINIC(make_scalar3(-0.5,0.5,0.5)),false);
+    pdata->setPosition(5, TO_TRICLINIC(make_scalar3(-0.5,0.5,-0.5)),false);
+    pdata->setPosition(6, TO_TRICLINIC(make_scalar3(-0.5,-0.5,0.5)),false);
+    pdata->setPosition(7, TO_TRICLINIC(make_scalar3(-0.5,-0.5,-0.5)),false);
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+    comm->migrateParticles();
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+
+    // rank 0 is three times as expensive as all other ranks
+    ComputeTimeSource source(exec_conf->getRank() == 0 ? 3e-3 : 1e-3);
+    comm->getComputeTimeSignal().connect<ComputeTimeSource, &ComputeTimeSource::getComputeTime>(&source);
+
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef,decomposition));
+    lb->setCommunicator(comm);
+    // only measure the imbalance
+    lb->setTolerance(Scalar(10.0));
+
+    // balancing by particles, every rank has the same load
+    lb->update(0);
+    MY_CHECK_CLOSE(lb->getMaxImbalance(), 1.0, tol);
+
+    // without a previous measurement, the load is the number of particles
+    lb->setWeightByTime(true);
+    lb->setSmoothing(Scalar(0.5));
+    lb->update(1);
+    MY_CHECK_CLOSE(lb->getMaxImbalance(), 1.0, tol);
+
+    // the load of rank 0 is 3 out of a total of 10
+    lb->update(2);
+    MY_CHECK_CLOSE(lb->getMaxImbalance(), 3.0/(10.0/8.0), tol);
+
+    // the smoothed costs are unchanged by a constant compute time
+    lb->update(3);
+    MY_CHECK_CLOSE(lb->getMaxImbalance(), 3.0/(10.0/8.0), tol);
+
+    // invalid smoothing factors are rejected
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ lb->setSmoothing(Scalar(1.0)); });
+
+    comm->getComputeTimeSignal().disconnect<ComputeTimeSource, &ComputeTimeSource::getComputeTime>(&source);
+    }
+
 //! Tests basic particle redistribution
 UP_TEST( LoadBalancer_test_basic)
     {
@@ -395,6 +489,16 @@ UP_TEST( LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0,-.6,.7,.5));
     }
 
+//! Tests the imbalance measured by compute time
+UP_TEST( LoadBalancer_test_time)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    // cubic box
+    test_load_balancer_time<LoadBalancer>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_time<LoadBalancer>(exec_conf, BoxDim(1.0,.1,.2,.3));
+    }
+
 #ifdef ENABLE_CUDA
 //! Tests basic particle redistribution on the GPU
 UP_TEST( LoadBalancerGPU_test_basic)
@@ -400,6 +400,8 @@ class balance(_updater):
         maxiter (int): Maximum number of iterations to attempt in a single step.
         period (int): Balancing will be attempted every \a period time steps
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        weight (str): Measure the load by the number of particles ('particles') or by the compute time ('time').
+        smoothing (float): Weight of the previous compute time measurements in the moving average (0 <= smoothing < 1).
 
     Every *period* steps, the boundaries of the processor domains are adjusted to distribute the particle load close
     to evenly between them. The load imbalance is defined as the number of particles owned by a rank divided by the
@@ -424,6 +426,14 @@ class balance(_updater):
     have significantly more pair force neighbors than others, this estimate of the load imbalance may not produce the
     optimal results.
 
+    With *weight* = 'time', each particle is instead weighted by the compute time per particle and step of the rank that
+    owns it, so that :math:`N(i)` and :math:`N` are replaced by the measured load of rank :math:`i` and the total load.
+    The compute time is measured between balancing steps in the force computations of the integrator (or the trial moves
+    of an HPMC integrator), excluding communication. To suppress noise in the timings, the cost per particle is smoothed
+    with an exponential moving average, where *smoothing* is the weight of the previous measurements. On the first
+    balancing step no measurement is available and the load is the number of particles. On the GPU, the measured time
+    only includes the kernel launches unless the kernels run synchronously (e.g. with profiling enabled).
+
     A load balancing adjustment is only performed when the maximum load imbalance exceeds a *tolerance*. The ideal load
     balance is 1.0, so setting *tolerance* less than 1.0 will force an adjustment every *period*. The load balancer
     can attempt multiple iterations of balancing every *period*, and up to *maxiter* attempts can be made. The optimal
@@ -442,7 +452,7 @@ class balance(_updater):
 
     Balancing is ignored if there is no domain decomposition available (MPI is not built or is running on a single rank).
     """
-    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0):
+    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0, weight='particles', smoothing=0.5):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -462,16 +472,16 @@ class balance(_updater):
         self.setupUpdater(period,phase)
 
         # stash arguments to metadata
-        self.metadata_fields = ['tolerance','maxiter','period','phase']
+        self.metadata_fields = ['tolerance','maxiter','period','phase','weight','smoothing']
         self.period = period
         self.phase = phase
 
         # configure the parameters
         hoomd.util.quiet_status()
-        self.set_params(x,y,z,tolerance, maxiter)
+        self.set_params(x,y,z,tolerance, maxiter, weight, smoothing)
         hoomd.util.unquiet_status()
 
-    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None):
+    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None, weight=None, smoothing=None):
         R""" Change load balancing parameters.
 
         Args:
@@ -480,12 +490,15 @@ class balance(_updater):
             z (bool): If True, balance in z dimension.
             tolerance (float): Load imbalance tolerance (if <= 1.0, balance every step).
             maxiter (int): Maximum number of iterations to attempt in a single step.
+            weight (str): Measure the load by the number of particles ('particles') or by the compute time ('time').
+            smoothing (float): Weight of the previous compute time measurements in the moving average.
 
 
         Examples::
 
             balance.set_params(x=True, y=False)
             balance.set_params(tolerance=0.02, maxiter=5)
+            balance.set_params(weight='time', smoothing=0.8)
         """
         hoomd.util.print_status_line()
         self.check_initialization()
@@ -502,6 +515,15 @@ class balance(_updater):
         if maxiter is not None:
             self.maxiter = maxiter
             self.cpp_updater.setMaxIterations(self.maxiter)
+        if weight is not None:
+            if weight not in ('particles', 'time'):
+                hoomd.context.msg.error("update.balance: weight must be 'particles' or 'time'\n")
+                raise ValueError("Invalid load balancing weight")
+            self.weight = weight
+            self.cpp_updater.setWeightByTime(self.weight == 'time')
+        if smoothing is not None:
+            self.smoothing = smoothing
+            self.cpp_updater.setSmoothing(self.smoothing)
 
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;